@@ -16,6 +16,32 @@
  */
 
 #include "ARIA.h"
+#include "ARIA_AESNI.h"
+#include "../../cpu/CPU.h"
+#include "../../threads/THREADPOOL.h"
+
+/*
+	The decryption keys are derived by the first decryption, which may
+	happen at the same time in several threads sharing the context.
+	dksState is only read and written with atomic operations, see
+	decryptionKeys.
+*/
+#ifdef _MSC_VER
+#include <intrin.h>
+// volatile accesses have acquire and release semantics with /volatile:ms, the default
+#define ATOMIC_LOAD(x) (*(volatile unsigned*)&(x))
+#define ATOMIC_STORE(x, v) _InterlockedExchange((volatile long*)&(x), (long)(v))
+#define ATOMIC_CLAIM(x, from, to) (_InterlockedCompareExchange((volatile long*)&(x), (long)(to), (long)(from)) == (long)(from))
+#else
+#define ATOMIC_LOAD(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#define ATOMIC_CLAIM(x, from, to) __sync_bool_compare_and_swap(&(x), (from), (to))
+#endif
+
+// values of dksState
+#define DKS_NONE 0
+#define DKS_BUSY 1
+#define DKS_READY 2
 
 // constants
 const uint32_t C1[4] = { 0x517cc1b7, 0x27220a94, 0xfe13abe8, 0xfa9a6ee0 };
@@ -99,6 +125,148 @@ const uint8_t SB4[256] = {
 								0x25, 0x8a, 0xb5, 0xe7, 0x42, 0xb3, 0xc7, 0xea, 0xf7, 0x4c, 0x11, 0x33, 0x03, 0xa2, 0xac, 0x60
 };
 
+// S-Boxes spread over a word by the first step of the diffusion layer,
+// STn[x] has SBn(x) in the three bytes of the word it reaches
+static const uint32_t ST1[256] = {
+	0x00636363, 0x007c7c7c, 0x00777777, 0x007b7b7b, 0x00f2f2f2, 0x006b6b6b, 0x006f6f6f, 0x00c5c5c5,
+	0x00303030, 0x00010101, 0x00676767, 0x002b2b2b, 0x00fefefe, 0x00d7d7d7, 0x00ababab, 0x00767676,
+	0x00cacaca, 0x00828282, 0x00c9c9c9, 0x007d7d7d, 0x00fafafa, 0x00595959, 0x00474747, 0x00f0f0f0,
+	0x00adadad, 0x00d4d4d4, 0x00a2a2a2, 0x00afafaf, 0x009c9c9c, 0x00a4a4a4, 0x00727272, 0x00c0c0c0,
+	0x00b7b7b7, 0x00fdfdfd, 0x00939393, 0x00262626, 0x00363636, 0x003f3f3f, 0x00f7f7f7, 0x00cccccc,
+	0x00343434, 0x00a5a5a5, 0x00e5e5e5, 0x00f1f1f1, 0x00717171, 0x00d8d8d8, 0x00313131, 0x00151515,
+	0x00040404, 0x00c7c7c7, 0x00232323, 0x00c3c3c3, 0x00181818, 0x00969696, 0x00050505, 0x009a9a9a,
+	0x00070707, 0x00121212, 0x00808080, 0x00e2e2e2, 0x00ebebeb, 0x00272727, 0x00b2b2b2, 0x00757575,
+	0x00090909, 0x00838383, 0x002c2c2c, 0x001a1a1a, 0x001b1b1b, 0x006e6e6e, 0x005a5a5a, 0x00a0a0a0,
+	0x00525252, 0x003b3b3b, 0x00d6d6d6, 0x00b3b3b3, 0x00292929, 0x00e3e3e3, 0x002f2f2f, 0x00848484,
+	0x00535353, 0x00d1d1d1, 0x00000000, 0x00ededed, 0x00202020, 0x00fcfcfc, 0x00b1b1b1, 0x005b5b5b,
+	0x006a6a6a, 0x00cbcbcb, 0x00bebebe, 0x00393939, 0x004a4a4a, 0x004c4c4c, 0x00585858, 0x00cfcfcf,
+	0x00d0d0d0, 0x00efefef, 0x00aaaaaa, 0x00fbfbfb, 0x00434343, 0x004d4d4d, 0x00333333, 0x00858585,
+	0x00454545, 0x00f9f9f9, 0x00020202, 0x007f7f7f, 0x00505050, 0x003c3c3c, 0x009f9f9f, 0x00a8a8a8,
+	0x00515151, 0x00a3a3a3, 0x00404040, 0x008f8f8f, 0x00929292, 0x009d9d9d, 0x00383838, 0x00f5f5f5,
+	0x00bcbcbc, 0x00b6b6b6, 0x00dadada, 0x00212121, 0x00101010, 0x00ffffff, 0x00f3f3f3, 0x00d2d2d2,
+	0x00cdcdcd, 0x000c0c0c, 0x00131313, 0x00ececec, 0x005f5f5f, 0x00979797, 0x00444444, 0x00171717,
+	0x00c4c4c4, 0x00a7a7a7, 0x007e7e7e, 0x003d3d3d, 0x00646464, 0x005d5d5d, 0x00191919, 0x00737373,
+	0x00606060, 0x00818181, 0x004f4f4f, 0x00dcdcdc, 0x00222222, 0x002a2a2a, 0x00909090, 0x00888888,
+	0x00464646, 0x00eeeeee, 0x00b8b8b8, 0x00141414, 0x00dedede, 0x005e5e5e, 0x000b0b0b, 0x00dbdbdb,
+	0x00e0e0e0, 0x00323232, 0x003a3a3a, 0x000a0a0a, 0x00494949, 0x00060606, 0x00242424, 0x005c5c5c,
+	0x00c2c2c2, 0x00d3d3d3, 0x00acacac, 0x00626262, 0x00919191, 0x00959595, 0x00e4e4e4, 0x00797979,
+	0x00e7e7e7, 0x00c8c8c8, 0x00373737, 0x006d6d6d, 0x008d8d8d, 0x00d5d5d5, 0x004e4e4e, 0x00a9a9a9,
+	0x006c6c6c, 0x00565656, 0x00f4f4f4, 0x00eaeaea, 0x00656565, 0x007a7a7a, 0x00aeaeae, 0x00080808,
+	0x00bababa, 0x00787878, 0x00252525, 0x002e2e2e, 0x001c1c1c, 0x00a6a6a6, 0x00b4b4b4, 0x00c6c6c6,
+	0x00e8e8e8, 0x00dddddd, 0x00747474, 0x001f1f1f, 0x004b4b4b, 0x00bdbdbd, 0x008b8b8b, 0x008a8a8a,
+	0x00707070, 0x003e3e3e, 0x00b5b5b5, 0x00666666, 0x00484848, 0x00030303, 0x00f6f6f6, 0x000e0e0e,
+	0x00616161, 0x00353535, 0x00575757, 0x00b9b9b9, 0x00868686, 0x00c1c1c1, 0x001d1d1d, 0x009e9e9e,
+	0x00e1e1e1, 0x00f8f8f8, 0x00989898, 0x00111111, 0x00696969, 0x00d9d9d9, 0x008e8e8e, 0x00949494,
+	0x009b9b9b, 0x001e1e1e, 0x00878787, 0x00e9e9e9, 0x00cecece, 0x00555555, 0x00282828, 0x00dfdfdf,
+	0x008c8c8c, 0x00a1a1a1, 0x00898989, 0x000d0d0d, 0x00bfbfbf, 0x00e6e6e6, 0x00424242, 0x00686868,
+	0x00414141, 0x00999999, 0x002d2d2d, 0x000f0f0f, 0x00b0b0b0, 0x00545454, 0x00bbbbbb, 0x00161616
+};
+
+static const uint32_t ST2[256] = {
+	0xe200e2e2, 0x4e004e4e, 0x54005454, 0xfc00fcfc, 0x94009494, 0xc200c2c2, 0x4a004a4a, 0xcc00cccc,
+	0x62006262, 0x0d000d0d, 0x6a006a6a, 0x46004646, 0x3c003c3c, 0x4d004d4d, 0x8b008b8b, 0xd100d1d1,
+	0x5e005e5e, 0xfa00fafa, 0x64006464, 0xcb00cbcb, 0xb400b4b4, 0x97009797, 0xbe00bebe, 0x2b002b2b,
+	0xbc00bcbc, 0x77007777, 0x2e002e2e, 0x03000303, 0xd300d3d3, 0x19001919, 0x59005959, 0xc100c1c1,
+	0x1d001d1d, 0x06000606, 0x41004141, 0x6b006b6b, 0x55005555, 0xf000f0f0, 0x99009999, 0x69006969,
+	0xea00eaea, 0x9c009c9c, 0x18001818, 0xae00aeae, 0x63006363, 0xdf00dfdf, 0xe700e7e7, 0xbb00bbbb,
+	0x00000000, 0x73007373, 0x66006666, 0xfb00fbfb, 0x96009696, 0x4c004c4c, 0x85008585, 0xe400e4e4,
+	0x3a003a3a, 0x09000909, 0x45004545, 0xaa00aaaa, 0x0f000f0f, 0xee00eeee, 0x10001010, 0xeb00ebeb,
+	0x2d002d2d, 0x7f007f7f, 0xf400f4f4, 0x29002929, 0xac00acac, 0xcf00cfcf, 0xad00adad, 0x91009191,
+	0x8d008d8d, 0x78007878, 0xc800c8c8, 0x95009595, 0xf900f9f9, 0x2f002f2f, 0xce00cece, 0xcd00cdcd,
+	0x08000808, 0x7a007a7a, 0x88008888, 0x38003838, 0x5c005c5c, 0x83008383, 0x2a002a2a, 0x28002828,
+	0x47004747, 0xdb00dbdb, 0xb800b8b8, 0xc700c7c7, 0x93009393, 0xa400a4a4, 0x12001212, 0x53005353,
+	0xff00ffff, 0x87008787, 0x0e000e0e, 0x31003131, 0x36003636, 0x21002121, 0x58005858, 0x48004848,
+	0x01000101, 0x8e008e8e, 0x37003737, 0x74007474, 0x32003232, 0xca00caca, 0xe900e9e9, 0xb100b1b1,
+	0xb700b7b7, 0xab00abab, 0x0c000c0c, 0xd700d7d7, 0xc400c4c4, 0x56005656, 0x42004242, 0x26002626,
+	0x07000707, 0x98009898, 0x60006060, 0xd900d9d9, 0xb600b6b6, 0xb900b9b9, 0x11001111, 0x40004040,
+	0xec00ecec, 0x20002020, 0x8c008c8c, 0xbd00bdbd, 0xa000a0a0, 0xc900c9c9, 0x84008484, 0x04000404,
+	0x49004949, 0x23002323, 0xf100f1f1, 0x4f004f4f, 0x50005050, 0x1f001f1f, 0x13001313, 0xdc00dcdc,
+	0xd800d8d8, 0xc000c0c0, 0x9e009e9e, 0x57005757, 0xe300e3e3, 0xc300c3c3, 0x7b007b7b, 0x65006565,
+	0x3b003b3b, 0x02000202, 0x8f008f8f, 0x3e003e3e, 0xe800e8e8, 0x25002525, 0x92009292, 0xe500e5e5,
+	0x15001515, 0xdd00dddd, 0xfd00fdfd, 0x17001717, 0xa900a9a9, 0xbf00bfbf, 0xd400d4d4, 0x9a009a9a,
+	0x7e007e7e, 0xc500c5c5, 0x39003939, 0x67006767, 0xfe00fefe, 0x76007676, 0x9d009d9d, 0x43004343,
+	0xa700a7a7, 0xe100e1e1, 0xd000d0d0, 0xf500f5f5, 0x68006868, 0xf200f2f2, 0x1b001b1b, 0x34003434,
+	0x70007070, 0x05000505, 0xa300a3a3, 0x8a008a8a, 0xd500d5d5, 0x79007979, 0x86008686, 0xa800a8a8,
+	0x30003030, 0xc600c6c6, 0x51005151, 0x4b004b4b, 0x1e001e1e, 0xa600a6a6, 0x27002727, 0xf600f6f6,
+	0x35003535, 0xd200d2d2, 0x6e006e6e, 0x24002424, 0x16001616, 0x82008282, 0x5f005f5f, 0xda00dada,
+	0xe600e6e6, 0x75007575, 0xa200a2a2, 0xef00efef, 0x2c002c2c, 0xb200b2b2, 0x1c001c1c, 0x9f009f9f,
+	0x5d005d5d, 0x6f006f6f, 0x80008080, 0x0a000a0a, 0x72007272, 0x44004444, 0x9b009b9b, 0x6c006c6c,
+	0x90009090, 0x0b000b0b, 0x5b005b5b, 0x33003333, 0x7d007d7d, 0x5a005a5a, 0x52005252, 0xf300f3f3,
+	0x61006161, 0xa100a1a1, 0xf700f7f7, 0xb000b0b0, 0xd600d6d6, 0x3f003f3f, 0x7c007c7c, 0x6d006d6d,
+	0xed00eded, 0x14001414, 0xe000e0e0, 0xa500a5a5, 0x3d003d3d, 0x22002222, 0xb300b3b3, 0xf800f8f8,
+	0x89008989, 0xde00dede, 0x71007171, 0x1a001a1a, 0xaf00afaf, 0xba00baba, 0xb500b5b5, 0x81008181
+};
+
+static const uint32_t ST3[256] = {
+	0x52520052, 0x09090009, 0x6a6a006a, 0xd5d500d5, 0x30300030, 0x36360036, 0xa5a500a5, 0x38380038,
+	0xbfbf00bf, 0x40400040, 0xa3a300a3, 0x9e9e009e, 0x81810081, 0xf3f300f3, 0xd7d700d7, 0xfbfb00fb,
+	0x7c7c007c, 0xe3e300e3, 0x39390039, 0x82820082, 0x9b9b009b, 0x2f2f002f, 0xffff00ff, 0x87870087,
+	0x34340034, 0x8e8e008e, 0x43430043, 0x44440044, 0xc4c400c4, 0xdede00de, 0xe9e900e9, 0xcbcb00cb,
+	0x54540054, 0x7b7b007b, 0x94940094, 0x32320032, 0xa6a600a6, 0xc2c200c2, 0x23230023, 0x3d3d003d,
+	0xeeee00ee, 0x4c4c004c, 0x95950095, 0x0b0b000b, 0x42420042, 0xfafa00fa, 0xc3c300c3, 0x4e4e004e,
+	0x08080008, 0x2e2e002e, 0xa1a100a1, 0x66660066, 0x28280028, 0xd9d900d9, 0x24240024, 0xb2b200b2,
+	0x76760076, 0x5b5b005b, 0xa2a200a2, 0x49490049, 0x6d6d006d, 0x8b8b008b, 0xd1d100d1, 0x25250025,
+	0x72720072, 0xf8f800f8, 0xf6f600f6, 0x64640064, 0x86860086, 0x68680068, 0x98980098, 0x16160016,
+	0xd4d400d4, 0xa4a400a4, 0x5c5c005c, 0xcccc00cc, 0x5d5d005d, 0x65650065, 0xb6b600b6, 0x92920092,
+	0x6c6c006c, 0x70700070, 0x48480048, 0x50500050, 0xfdfd00fd, 0xeded00ed, 0xb9b900b9, 0xdada00da,
+	0x5e5e005e, 0x15150015, 0x46460046, 0x57570057, 0xa7a700a7, 0x8d8d008d, 0x9d9d009d, 0x84840084,
+	0x90900090, 0xd8d800d8, 0xabab00ab, 0x00000000, 0x8c8c008c, 0xbcbc00bc, 0xd3d300d3, 0x0a0a000a,
+	0xf7f700f7, 0xe4e400e4, 0x58580058, 0x05050005, 0xb8b800b8, 0xb3b300b3, 0x45450045, 0x06060006,
+	0xd0d000d0, 0x2c2c002c, 0x1e1e001e, 0x8f8f008f, 0xcaca00ca, 0x3f3f003f, 0x0f0f000f, 0x02020002,
+	0xc1c100c1, 0xafaf00af, 0xbdbd00bd, 0x03030003, 0x01010001, 0x13130013, 0x8a8a008a, 0x6b6b006b,
+	0x3a3a003a, 0x91910091, 0x11110011, 0x41410041, 0x4f4f004f, 0x67670067, 0xdcdc00dc, 0xeaea00ea,
+	0x97970097, 0xf2f200f2, 0xcfcf00cf, 0xcece00ce, 0xf0f000f0, 0xb4b400b4, 0xe6e600e6, 0x73730073,
+	0x96960096, 0xacac00ac, 0x74740074, 0x22220022, 0xe7e700e7, 0xadad00ad, 0x35350035, 0x85850085,
+	0xe2e200e2, 0xf9f900f9, 0x37370037, 0xe8e800e8, 0x1c1c001c, 0x75750075, 0xdfdf00df, 0x6e6e006e,
+	0x47470047, 0xf1f100f1, 0x1a1a001a, 0x71710071, 0x1d1d001d, 0x29290029, 0xc5c500c5, 0x89890089,
+	0x6f6f006f, 0xb7b700b7, 0x62620062, 0x0e0e000e, 0xaaaa00aa, 0x18180018, 0xbebe00be, 0x1b1b001b,
+	0xfcfc00fc, 0x56560056, 0x3e3e003e, 0x4b4b004b, 0xc6c600c6, 0xd2d200d2, 0x79790079, 0x20200020,
+	0x9a9a009a, 0xdbdb00db, 0xc0c000c0, 0xfefe00fe, 0x78780078, 0xcdcd00cd, 0x5a5a005a, 0xf4f400f4,
+	0x1f1f001f, 0xdddd00dd, 0xa8a800a8, 0x33330033, 0x88880088, 0x07070007, 0xc7c700c7, 0x31310031,
+	0xb1b100b1, 0x12120012, 0x10100010, 0x59590059, 0x27270027, 0x80800080, 0xecec00ec, 0x5f5f005f,
+	0x60600060, 0x51510051, 0x7f7f007f, 0xa9a900a9, 0x19190019, 0xb5b500b5, 0x4a4a004a, 0x0d0d000d,
+	0x2d2d002d, 0xe5e500e5, 0x7a7a007a, 0x9f9f009f, 0x93930093, 0xc9c900c9, 0x9c9c009c, 0xefef00ef,
+	0xa0a000a0, 0xe0e000e0, 0x3b3b003b, 0x4d4d004d, 0xaeae00ae, 0x2a2a002a, 0xf5f500f5, 0xb0b000b0,
+	0xc8c800c8, 0xebeb00eb, 0xbbbb00bb, 0x3c3c003c, 0x83830083, 0x53530053, 0x99990099, 0x61610061,
+	0x17170017, 0x2b2b002b, 0x04040004, 0x7e7e007e, 0xbaba00ba, 0x77770077, 0xd6d600d6, 0x26260026,
+	0xe1e100e1, 0x69690069, 0x14140014, 0x63630063, 0x55550055, 0x21210021, 0x0c0c000c, 0x7d7d007d
+};
+
+static const uint32_t ST4[256] = {
+	0x30303000, 0x68686800, 0x99999900, 0x1b1b1b00, 0x87878700, 0xb9b9b900, 0x21212100, 0x78787800,
+	0x50505000, 0x39393900, 0xdbdbdb00, 0xe1e1e100, 0x72727200, 0x09090900, 0x62626200, 0x3c3c3c00,
+	0x3e3e3e00, 0x7e7e7e00, 0x5e5e5e00, 0x8e8e8e00, 0xf1f1f100, 0xa0a0a000, 0xcccccc00, 0xa3a3a300,
+	0x2a2a2a00, 0x1d1d1d00, 0xfbfbfb00, 0xb6b6b600, 0xd6d6d600, 0x20202000, 0xc4c4c400, 0x8d8d8d00,
+	0x81818100, 0x65656500, 0xf5f5f500, 0x89898900, 0xcbcbcb00, 0x9d9d9d00, 0x77777700, 0xc6c6c600,
+	0x57575700, 0x43434300, 0x56565600, 0x17171700, 0xd4d4d400, 0x40404000, 0x1a1a1a00, 0x4d4d4d00,
+	0xc0c0c000, 0x63636300, 0x6c6c6c00, 0xe3e3e300, 0xb7b7b700, 0xc8c8c800, 0x64646400, 0x6a6a6a00,
+	0x53535300, 0xaaaaaa00, 0x38383800, 0x98989800, 0x0c0c0c00, 0xf4f4f400, 0x9b9b9b00, 0xededed00,
+	0x7f7f7f00, 0x22222200, 0x76767600, 0xafafaf00, 0xdddddd00, 0x3a3a3a00, 0x0b0b0b00, 0x58585800,
+	0x67676700, 0x88888800, 0x06060600, 0xc3c3c300, 0x35353500, 0x0d0d0d00, 0x01010100, 0x8b8b8b00,
+	0x8c8c8c00, 0xc2c2c200, 0xe6e6e600, 0x5f5f5f00, 0x02020200, 0x24242400, 0x75757500, 0x93939300,
+	0x66666600, 0x1e1e1e00, 0xe5e5e500, 0xe2e2e200, 0x54545400, 0xd8d8d800, 0x10101000, 0xcecece00,
+	0x7a7a7a00, 0xe8e8e800, 0x08080800, 0x2c2c2c00, 0x12121200, 0x97979700, 0x32323200, 0xababab00,
+	0xb4b4b400, 0x27272700, 0x0a0a0a00, 0x23232300, 0xdfdfdf00, 0xefefef00, 0xcacaca00, 0xd9d9d900,
+	0xb8b8b800, 0xfafafa00, 0xdcdcdc00, 0x31313100, 0x6b6b6b00, 0xd1d1d100, 0xadadad00, 0x19191900,
+	0x49494900, 0xbdbdbd00, 0x51515100, 0x96969600, 0xeeeeee00, 0xe4e4e400, 0xa8a8a800, 0x41414100,
+	0xdadada00, 0xffffff00, 0xcdcdcd00, 0x55555500, 0x86868600, 0x36363600, 0xbebebe00, 0x61616100,
+	0x52525200, 0xf8f8f800, 0xbbbbbb00, 0x0e0e0e00, 0x82828200, 0x48484800, 0x69696900, 0x9a9a9a00,
+	0xe0e0e000, 0x47474700, 0x9e9e9e00, 0x5c5c5c00, 0x04040400, 0x4b4b4b00, 0x34343400, 0x15151500,
+	0x79797900, 0x26262600, 0xa7a7a700, 0xdedede00, 0x29292900, 0xaeaeae00, 0x92929200, 0xd7d7d700,
+	0x84848400, 0xe9e9e900, 0xd2d2d200, 0xbababa00, 0x5d5d5d00, 0xf3f3f300, 0xc5c5c500, 0xb0b0b000,
+	0xbfbfbf00, 0xa4a4a400, 0x3b3b3b00, 0x71717100, 0x44444400, 0x46464600, 0x2b2b2b00, 0xfcfcfc00,
+	0xebebeb00, 0x6f6f6f00, 0xd5d5d500, 0xf6f6f600, 0x14141400, 0xfefefe00, 0x7c7c7c00, 0x70707000,
+	0x5a5a5a00, 0x7d7d7d00, 0xfdfdfd00, 0x2f2f2f00, 0x18181800, 0x83838300, 0x16161600, 0xa5a5a500,
+	0x91919100, 0x1f1f1f00, 0x05050500, 0x95959500, 0x74747400, 0xa9a9a900, 0xc1c1c100, 0x5b5b5b00,
+	0x4a4a4a00, 0x85858500, 0x6d6d6d00, 0x13131300, 0x07070700, 0x4f4f4f00, 0x4e4e4e00, 0x45454500,
+	0xb2b2b200, 0x0f0f0f00, 0xc9c9c900, 0x1c1c1c00, 0xa6a6a600, 0xbcbcbc00, 0xececec00, 0x73737300,
+	0x90909000, 0x7b7b7b00, 0xcfcfcf00, 0x59595900, 0x8f8f8f00, 0xa1a1a100, 0xf9f9f900, 0x2d2d2d00,
+	0xf2f2f200, 0xb1b1b100, 0x00000000, 0x94949400, 0x37373700, 0x9f9f9f00, 0xd0d0d000, 0x2e2e2e00,
+	0x9c9c9c00, 0x6e6e6e00, 0x28282800, 0x3f3f3f00, 0x80808000, 0xf0f0f000, 0x3d3d3d00, 0xd3d3d300,
+	0x25252500, 0x8a8a8a00, 0xb5b5b500, 0xe7e7e700, 0x42424200, 0xb3b3b300, 0xc7c7c700, 0xeaeaea00,
+	0xf7f7f700, 0x4c4c4c00, 0x11111100, 0x33333300, 0x03030300, 0xa2a2a200, 0xacacac00, 0x60606000
+};
+
 static void XOR_128(uint32_t* y, uint32_t* x)
 {
 	y[0] ^= x[0];
@@ -115,13 +283,34 @@ static void MOV_128(uint32_t* y, const uint32_t* x)
 	y[3] = x[3];
 }
 
-// Rotate Left circular shift 128 bits
-static void ROL_128(uint32_t* y, uint32_t* x, uint32_t n)
+// Rotate Left circular shift 128 bits by any amount, y and x must differ
+static void ROL_128(uint32_t* y, const uint32_t* x, uint32_t n)
 {
-	y[0] = (x[0] << n) | (x[1] >> (32 - n));
-	y[1] = (x[1] << n) | (x[2] >> (32 - n));
-	y[2] = (x[2] << n) | (x[3] >> (32 - n));
-	y[3] = (x[3] << n) | (x[0] >> (32 - n));
+	uint32_t x0 = x[(n >> 5) & 3];
+	uint32_t x1 = x[((n >> 5) + 1) & 3];
+	uint32_t x2 = x[((n >> 5) + 2) & 3];
+	uint32_t x3 = x[((n >> 5) + 3) & 3];
+
+	n &= 31;
+	if (n == 0)
+	{
+		y[0] = x0;
+		y[1] = x1;
+		y[2] = x2;
+		y[3] = x3;
+		return;
+	}
+
+	y[0] = (x0 << n) | (x1 >> (32 - n));
+	y[1] = (x1 << n) | (x2 >> (32 - n));
+	y[2] = (x2 << n) | (x3 >> (32 - n));
+	y[3] = (x3 << n) | (x0 >> (32 - n));
+}
+
+// Rotate Right circular shift 32 bits
+static uint32_t ROR_32(uint32_t x, uint32_t n)
+{
+	return x >> n | x << (32 - n);
 }
 
 // Rotate Right circular shift 128 bits
@@ -133,36 +322,6 @@ static void ROR_128(uint32_t* y, uint32_t* x, uint32_t n)
 	y[0] = (x[0] >> n) | (x[3] << (32 - n));
 }
 
-static void SL1(uint32_t* input, uint32_t* output)
-{
-	/*
-		y0 = SB1(x0),  y1 = SB2(x1),  y2 = SB3(x2),  y3 = SB4(x3),
-		y4 = SB1(x4),  y5 = SB2(x5),  y6 = SB3(x6),  y7 = SB4(x7),
-		y8 = SB1(x8),  y9 = SB2(x9),  y10= SB3(x10), y11= SB4(x11),
-		y12= SB1(x12), y13= SB2(x13), y14= SB3(x14), y15= SB4(x15).
-	*/
-
-	output[0] = SB1[(uint8_t)(input[0] >> 24)] << 24
-		| SB2[(uint8_t)(input[0] >> 16)] << 16
-		| SB3[(uint8_t)(input[0] >> 8)] << 8
-		| SB4[(uint8_t)(input[0] >> 0)];
-
-	output[1] = SB1[(uint8_t)(input[1] >> 24)] << 24
-		| SB2[(uint8_t)(input[1] >> 16)] << 16
-		| SB3[(uint8_t)(input[1] >> 8)] << 8
-		| SB4[(uint8_t)(input[1] >> 0)];
-
-	output[2] = SB1[(uint8_t)(input[2] >> 24)] << 24
-		| SB2[(uint8_t)(input[2] >> 16)] << 16
-		| SB3[(uint8_t)(input[2] >> 8)] << 8
-		| SB4[(uint8_t)(input[2] >> 0)];
-
-	output[3] = SB1[(uint8_t)(input[3] >> 24)] << 24
-		| SB2[(uint8_t)(input[3] >> 16)] << 16
-		| SB3[(uint8_t)(input[3] >> 8)] << 8
-		| SB4[(uint8_t)(input[3] >> 0)];
-}
-
 static void SL2(uint32_t* input, uint32_t* output)
 {
 	/*
@@ -193,7 +352,78 @@ static void SL2(uint32_t* input, uint32_t* output)
 		| SB2[(uint8_t)(input[3] >> 0)];
 }
 
-static void A(uint32_t* input, uint32_t* output)
+/*
+	Table driven rounds: each byte of a word goes through its S-Box
+	and is spread to the three bytes of the word it reaches in A(),
+	the rest of A() is done on whole words. DIFF_WORD mixes the
+	four words and DIFF_BYTE reorders bytes inside them, with
+	the byte permutation of the even rounds applied to other words.
+*/
+static void DIFF_WORD(uint32_t* t)
+{
+	t[1] ^= t[2];
+	t[2] ^= t[3];
+	t[0] ^= t[1];
+	t[3] ^= t[1];
+	t[2] ^= t[0];
+	t[1] ^= t[2];
+}
+
+static void DIFF_BYTE(uint32_t* a, uint32_t* b, uint32_t* c)
+{
+	// swap the bytes of each 16 bits half
+	*a = ((*a << 8) & 0xff00ff00) ^ ((*a >> 8) & 0x00ff00ff);
+
+	// swap the 16 bits halves
+	*b = *b << 16 | *b >> 16;
+
+	// reverse the bytes
+	*c = *c << 24 | (*c << 8 & 0x00ff0000) | (*c >> 8 & 0x0000ff00) | *c >> 24;
+}
+
+// P = A(SL1(P ^ RK))
+static void FO_T(uint32_t* P, const uint32_t* RK)
+{
+	uint32_t t0 = P[0] ^ RK[0];
+	uint32_t t1 = P[1] ^ RK[1];
+	uint32_t t2 = P[2] ^ RK[2];
+	uint32_t t3 = P[3] ^ RK[3];
+
+	P[0] = ST1[t0 >> 24] ^ ST2[(uint8_t)(t0 >> 16)] ^ ST3[(uint8_t)(t0 >> 8)] ^ ST4[(uint8_t)t0];
+	P[1] = ST1[t1 >> 24] ^ ST2[(uint8_t)(t1 >> 16)] ^ ST3[(uint8_t)(t1 >> 8)] ^ ST4[(uint8_t)t1];
+	P[2] = ST1[t2 >> 24] ^ ST2[(uint8_t)(t2 >> 16)] ^ ST3[(uint8_t)(t2 >> 8)] ^ ST4[(uint8_t)t2];
+	P[3] = ST1[t3 >> 24] ^ ST2[(uint8_t)(t3 >> 16)] ^ ST3[(uint8_t)(t3 >> 8)] ^ ST4[(uint8_t)t3];
+
+	DIFF_WORD(P);
+	DIFF_BYTE(&P[1], &P[2], &P[3]);
+	DIFF_WORD(P);
+}
+
+// P = A(SL2(P ^ RK))
+static void FE_T(uint32_t* P, const uint32_t* RK)
+{
+	uint32_t t0 = P[0] ^ RK[0];
+	uint32_t t1 = P[1] ^ RK[1];
+	uint32_t t2 = P[2] ^ RK[2];
+	uint32_t t3 = P[3] ^ RK[3];
+
+	P[0] = ST3[t0 >> 24] ^ ST4[(uint8_t)(t0 >> 16)] ^ ST1[(uint8_t)(t0 >> 8)] ^ ST2[(uint8_t)t0];
+	P[1] = ST3[t1 >> 24] ^ ST4[(uint8_t)(t1 >> 16)] ^ ST1[(uint8_t)(t1 >> 8)] ^ ST2[(uint8_t)t1];
+	P[2] = ST3[t2 >> 24] ^ ST4[(uint8_t)(t2 >> 16)] ^ ST1[(uint8_t)(t2 >> 8)] ^ ST2[(uint8_t)t2];
+	P[3] = ST3[t3 >> 24] ^ ST4[(uint8_t)(t3 >> 16)] ^ ST1[(uint8_t)(t3 >> 8)] ^ ST2[(uint8_t)t3];
+
+	DIFF_WORD(P);
+	DIFF_BYTE(&P[3], &P[0], &P[1]);
+	DIFF_WORD(P);
+}
+
+/*
+	output = A(input) on whole words: the spread of each byte to the
+	other three bytes of its word, which the ST tables include, then
+	the same steps as FO_T. Kept in locals, the A() of consecutive
+	round keys do not depend on each other and overlap.
+*/
+static void A_T(const uint32_t* input, uint32_t* output)
 {
 	/*
 		y0  = x3 ^ x4 ^ x6 ^ x8  ^ x9  ^ x13 ^ x14,
@@ -214,76 +444,59 @@ static void A(uint32_t* input, uint32_t* output)
 		y15 = x1 ^ x2 ^ x4 ^ x5  ^ x8  ^ x10 ^ x15.
 	*/
 
-	uint8_t x0 = input[0] >> 24;
-	uint8_t x1 = input[0] >> 16;
-	uint8_t x2 = input[0] >> 8;
-	uint8_t x3 = input[0];
-	uint8_t x4 = input[1] >> 24;
-	uint8_t x5 = input[1] >> 16;
-	uint8_t x6 = input[1] >> 8;
-	uint8_t x7 = input[1];
-	uint8_t x8 = input[2] >> 24;
-	uint8_t x9 = input[2] >> 16;
-	uint8_t x10 = input[2] >> 8;
-	uint8_t x11 = input[2];
-	uint8_t x12 = input[3] >> 24;
-	uint8_t x13 = input[3] >> 16;
-	uint8_t x14 = input[3] >> 8;
-	uint8_t x15 = input[3];
-
-	uint8_t y0 = x3 ^ x4 ^ x6 ^ x8 ^ x9 ^ x13 ^ x14;
-	uint8_t y1 = x2 ^ x5 ^ x7 ^ x8 ^ x9 ^ x12 ^ x15;
-	uint8_t y2 = x1 ^ x4 ^ x6 ^ x10 ^ x11 ^ x12 ^ x15;
-	uint8_t y3 = x0 ^ x5 ^ x7 ^ x10 ^ x11 ^ x13 ^ x14;
-	uint8_t y4 = x0 ^ x2 ^ x5 ^ x8 ^ x11 ^ x14 ^ x15;
-	uint8_t y5 = x1 ^ x3 ^ x4 ^ x9 ^ x10 ^ x14 ^ x15;
-	uint8_t y6 = x0 ^ x2 ^ x7 ^ x9 ^ x10 ^ x12 ^ x13;
-	uint8_t y7 = x1 ^ x3 ^ x6 ^ x8 ^ x11 ^ x12 ^ x13;
-	uint8_t y8 = x0 ^ x1 ^ x4 ^ x7 ^ x10 ^ x13 ^ x15;
-	uint8_t y9 = x0 ^ x1 ^ x5 ^ x6 ^ x11 ^ x12 ^ x14;
-	uint8_t y10 = x2 ^ x3 ^ x5 ^ x6 ^ x8 ^ x13 ^ x15;
-	uint8_t y11 = x2 ^ x3 ^ x4 ^ x7 ^ x9 ^ x12 ^ x14;
-	uint8_t y12 = x1 ^ x2 ^ x6 ^ x7 ^ x9 ^ x11 ^ x12;
-	uint8_t y13 = x0 ^ x3 ^ x6 ^ x7 ^ x8 ^ x10 ^ x13;
-	uint8_t y14 = x0 ^ x3 ^ x4 ^ x5 ^ x9 ^ x11 ^ x14;
-	uint8_t y15 = x1 ^ x2 ^ x4 ^ x5 ^ x8 ^ x10 ^ x15;
-
-	output[0] = y0 << 24 | y1 << 16 | y2 << 8 | y3;
-	output[1] = y4 << 24 | y5 << 16 | y6 << 8 | y7;
-	output[2] = y8 << 24 | y9 << 16 | y10 << 8 | y11;
-	output[3] = y12 << 24 | y13 << 16 | y14 << 8 | y15;
-}
-
-static void FO(uint32_t* D, uint32_t* RK, uint32_t* output)
-{
-	// A(SL1(D ^ RK))
-	uint32_t y[4];
-	MOV_128(y, D);
-
-	// D xor RK
-	XOR_128(y, RK);
+	uint32_t t[4];
+	uint32_t i;
 
-	// substitution layer 1 (odd)
-	SL1(y, y);
+	for (i = 0; i < 4; i++)
+	{
+		t[i] = ROR_32(input[i], 8) ^ ROR_32(input[i], 16) ^ ROR_32(input[i], 24);
+	}
 
-	// diffusion layer
-	A(y, output);
+	DIFF_WORD(t);
+	DIFF_BYTE(&t[1], &t[2], &t[3]);
+	DIFF_WORD(t);
+	MOV_128(output, t);
 }
 
-static void FE(uint32_t* D, uint32_t* RK, uint32_t* output)
+/*
+	All rounds on P with the round keys ks (eks or dks). The FO/FE
+	alternation is written out: 10 rounds are common to every key
+	length, 192 and 256 bits keys add one pair each, and the odd
+	round plus the final SL2 step close every variant.
+*/
+static void ARIA_crypt(uint32_t rounds, uint32_t ks[][4], uint32_t* P)
 {
-	// A(SL2(D ^ RK))
-	uint32_t y[4];
-	MOV_128(y, D);
+	uint32_t last = rounds - 2;
+
+	FO_T(P, ks[0]);
+	FE_T(P, ks[1]);
+	FO_T(P, ks[2]);
+	FE_T(P, ks[3]);
+	FO_T(P, ks[4]);
+	FE_T(P, ks[5]);
+	FO_T(P, ks[6]);
+	FE_T(P, ks[7]);
+	FO_T(P, ks[8]);
+	FE_T(P, ks[9]);
+
+	if (rounds > 13)
+	{
+		FO_T(P, ks[10]);
+		FE_T(P, ks[11]);
+	}
 
-	// D xor RK
-	XOR_128(y, RK);
+	if (rounds > 15)
+	{
+		FO_T(P, ks[12]);
+		FE_T(P, ks[13]);
+	}
 
-	// substitution layer 2 (even)
-	SL2(y, y);
+	FO_T(P, ks[last - 1]);
 
-	// diffusion layer
-	A(y, output);
+	// C = SL2(P11 ^ k12) ^ k13;
+	XOR_128(P, ks[last]);
+	SL2(P, P);
+	XOR_128(P, ks[last + 1]);
 }
 
 static void generateEncryptionKeys(uint32_t* W0,
@@ -311,7 +524,6 @@ static void generateEncryptionKeys(uint32_t* W0,
 		ek16 = (W0 <<< 31) ^ W3,
 		ek17 = W0 ^ (W1 <<< 19).
 	*/
-	uint32_t temp[4];
 
 	ROR_128(eks[0], W1, 19);
 	XOR_128(eks[0], W0);
@@ -330,21 +542,13 @@ static void generateEncryptionKeys(uint32_t* W0,
 	ROR_128(eks[7], W0, 31);
 	XOR_128(eks[7], W3);
 
-	ROL_128(eks[8], W1, 31);
-	ROL_128(temp, eks[8], 30);
-	MOV_128(eks[8], temp);
+	ROL_128(eks[8], W1, 61);
 	XOR_128(eks[8], W0);
-	ROL_128(eks[9], W2, 31);
-	ROL_128(temp, eks[9], 30);
-	MOV_128(eks[9], temp);
+	ROL_128(eks[9], W2, 61);
 	XOR_128(eks[9], W1);
-	ROL_128(eks[10], W3, 31);
-	ROL_128(temp, eks[10], 30);
-	MOV_128(eks[10], temp);
+	ROL_128(eks[10], W3, 61);
 	XOR_128(eks[10], W2);
-	ROL_128(eks[11], W0, 31);
-	ROL_128(temp, eks[11], 30);
-	MOV_128(eks[11], temp);
+	ROL_128(eks[11], W0, 61);
 	XOR_128(eks[11], W3);
 	ROL_128(eks[12], W1, 31);
 	XOR_128(eks[12], W0);
@@ -379,13 +583,17 @@ static void generateDecryptionKeys(uint32_t eks[][4], uint32_t dks[][4], uint32_
 	// -2 to discard first and last round
 	for (i = 0; i < rounds - 2; i++)
 	{
-		A(eks[ekPos--], dks[dkPos++]);
+		A_T(eks[ekPos--], dks[dkPos++]);
 	}
 	MOV_128(dks[dkPos], eks[ekPos]);
 }
 
-void ARIA_init(AriaContext* context, const uint32_t* key, uint32_t keyLength)
+/*
+	Encryption round keys of the key, returns the number of rounds.
+*/
+static uint32_t expandKey(const uint32_t* key, uint32_t keyLength, uint32_t eks[][4])
 {
+	uint32_t rounds;
 	uint32_t W0[4];
 	uint32_t W1[4];
 	uint32_t W2[4];
@@ -399,7 +607,7 @@ void ARIA_init(AriaContext* context, const uint32_t* key, uint32_t keyLength)
 
 	if (keyLength == 128)
 	{
-		context->rounds = 13;
+		rounds = 13;
 
 		KR[0] = 0;
 		KR[1] = 0;
@@ -412,7 +620,7 @@ void ARIA_init(AriaContext* context, const uint32_t* key, uint32_t keyLength)
 	}
 	else if (keyLength == 192)
 	{
-		context->rounds = 15;
+		rounds = 15;
 
 		KR[0] = key[4];
 		KR[1] = key[5];
@@ -425,7 +633,7 @@ void ARIA_init(AriaContext* context, const uint32_t* key, uint32_t keyLength)
 	}
 	else // 256
 	{
-		context->rounds = 17;
+		rounds = 17;
 
 		KR[0] = key[4];
 		KR[1] = key[5];
@@ -440,83 +648,316 @@ void ARIA_init(AriaContext* context, const uint32_t* key, uint32_t keyLength)
 	// Init registers
 	MOV_128(W0, key);
 
-	FO(W0, CK1, W1);
+	// W1 = FO(W0, CK1) ^ KR
+	MOV_128(W1, W0);
+	FO_T(W1, CK1);
 	XOR_128(W1, KR);
 
-	FE(W1, CK2, W2);
+	// W2 = FE(W1, CK2) ^ W0
+	MOV_128(W2, W1);
+	FE_T(W2, CK2);
 	XOR_128(W2, W0);
 
-	FO(W2, CK3, W3);
+	// W3 = FO(W2, CK3) ^ W1
+	MOV_128(W3, W2);
+	FO_T(W3, CK3);
 	XOR_128(W3, W1);
 
-	// generate encryption and decryption keys
-	generateEncryptionKeys(W0, W1, W2, W3, context->eks);
-	generateDecryptionKeys(context->eks, context->dks, context->rounds);
+	generateEncryptionKeys(W0, W1, W2, W3, eks);
+
+	return rounds;
+}
+
+// one round key, 4 parts of 32 bits
+typedef uint32_t RoundKey[4];
+
+/*
+	Decryption keys of the context, derived on first use. The thread
+	that moves dksState from DKS_NONE to DKS_BUSY fills dks and
+	publishes it with a release store of DKS_READY, the threads that
+	read DKS_READY with an acquire load use dks from then on. A thread
+	that comes while dks is being filled does not wait, it derives its
+	own copy in scratch, so the context is written only once.
+*/
+static RoundKey* decryptionKeys(AriaContext* context, RoundKey* scratch)
+{
+	if (ATOMIC_LOAD(context->dksState) == DKS_READY)
+	{
+		return context->dks;
+	}
+
+	if (ATOMIC_CLAIM(context->dksState, DKS_NONE, DKS_BUSY))
+	{
+		generateDecryptionKeys(context->eks, context->dks, context->rounds);
+		ATOMIC_STORE(context->dksState, DKS_READY);
+
+		return context->dks;
+	}
+
+	generateDecryptionKeys(context->eks, scratch, context->rounds);
+
+	return scratch;
+}
+
+/*
+	Only the encryption keys, the decryption keys come with the first
+	decryption. The context must be initialized before it is shared.
+*/
+void ARIA_init(AriaContext* context, const uint32_t* key, uint32_t keyLength)
+{
+	context->rounds = expandKey(key, keyLength, context->eks);
+	context->dksState = DKS_NONE;
 }
 
 void ARIA_encrypt(AriaContext* context, uint32_t* block, uint32_t* P)
 {
-	uint32_t round = 0;
-	uint32_t subkey = 0;
-	void (*roundFunctions[2]) (uint32_t* D, uint32_t* RK, uint32_t* output) = { FE, FO };
+	MOV_128(P, block);
+	ARIA_crypt(context->rounds, context->eks, P);
+}
+
+void ARIA_decrypt(AriaContext* context, uint32_t* block, uint32_t* P)
+{
+	RoundKey scratch[17];
 
 	MOV_128(P, block);
+	ARIA_crypt(context->rounds, decryptionKeys(context, scratch), P);
+}
 
-	// encryption rounds
-	for (round = 1; round <= context->rounds - 2; round++)
+/*
+	Bulk ECB processing of nrBlocks consecutive blocks with the given
+	round keys (eks for encryption, dks for decryption).
+
+	With AES-NI, 16 blocks at a time go through the SIMD kernel. The
+	table driven rounds already offer 16 independent lookups per
+	round, so the other blocks are processed one after the other.
+*/
+static void ARIA_blocks(uint32_t rounds, uint32_t ks[][4], const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	size_t done;
+
+#ifdef ARIA_AESNI
+	if (CPU_has(CPU_AESNI | CPU_AVX))
 	{
-		// optimize if condifion using array of function pointer to point to even/odd function
-		(*roundFunctions[round % 2])(P, context->eks[subkey++], P);
+		done = ARIA_blocks_aesni(ks[0], rounds, blocks, out, nrBlocks);
+		nrBlocks -= done;
+		blocks += 4 * done;
+		out += 4 * done;
+	}
+#endif
 
-		/*if (round % 2 != 0)
-		{
-			FO(P, context->eks[subkey++], P);
-		}
-		else
-		{
-			FE(P, context->eks[subkey++], P);
-		}*/
+	for (; nrBlocks > 0; nrBlocks--, blocks += 4, out += 4)
+	{
+		MOV_128(out, blocks);
+		ARIA_crypt(rounds, ks, out);
 	}
+}
 
-	// last step is different with last two keys
-	// C = SL2(P11 ^ ek12) ^ ek13;
-	XOR_128(P, context->eks[subkey++]);
+void ARIA_encrypt_blocks(AriaContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	ARIA_blocks(context->rounds, context->eks, blocks, out, nrBlocks);
+}
 
-	SL2(P, P);
+void ARIA_decrypt_blocks(AriaContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	RoundKey scratch[17];
 
-	XOR_128(P, context->eks[subkey++]);
+	ARIA_blocks(context->rounds, decryptionKeys(context, scratch), blocks, out, nrBlocks);
 }
 
-void ARIA_decrypt(AriaContext* context, uint32_t* block, uint32_t* P)
+/*
+	Encrypt-only contexts, half the size of AriaContext, for the modes
+	that never decrypt. Decryption stays possible but derives the
+	decryption keys on the stack at every call, which costs about one
+	block, and never writes the context. AriaContext derives them once.
+*/
+void ARIA_enc_init(AriaEncContext* context, const uint32_t* key, uint32_t keyLength)
+{
+	context->rounds = expandKey(key, keyLength, context->eks);
+}
+
+void ARIA_enc_encrypt(AriaEncContext* context, uint32_t* block, uint32_t* P)
+{
+	MOV_128(P, block);
+	ARIA_crypt(context->rounds, context->eks, P);
+}
+
+void ARIA_enc_decrypt(AriaEncContext* context, uint32_t* block, uint32_t* P)
 {
-	uint32_t round = 0;
-	uint32_t subkey = 0;
-	void (*roundFunctions[2]) (uint32_t* D, uint32_t* RK, uint32_t* output) = { FE, FO };
+	uint32_t dks[17][4];
 
+	generateDecryptionKeys(context->eks, dks, context->rounds);
 	MOV_128(P, block);
+	ARIA_crypt(context->rounds, dks, P);
+}
+
+void ARIA_enc_encrypt_blocks(AriaEncContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	ARIA_blocks(context->rounds, context->eks, blocks, out, nrBlocks);
+}
+
+void ARIA_enc_decrypt_blocks(AriaEncContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	uint32_t dks[17][4];
+
+	generateDecryptionKeys(context->eks, dks, context->rounds);
+	ARIA_blocks(context->rounds, dks, blocks, out, nrBlocks);
+}
+
+/*
+	Self check of the encrypt-only context on a test vector, through
+	the single block and the bulk functions.
+*/
+static int encCheck(const uint32_t* key, uint32_t keyLength, uint32_t* text, const uint32_t* expectedCipherText)
+{
+	AriaEncContext context;
+	uint32_t cipherText[4];
+	uint32_t blocksCipherText[4];
+	uint32_t decryptedText[4];
+	int ok = 1;
+	int i;
+
+	ARIA_enc_init(&context, key, keyLength);
+	ARIA_enc_encrypt(&context, text, cipherText);
+	ARIA_enc_encrypt_blocks(&context, text, blocksCipherText, 1);
+	ARIA_enc_decrypt(&context, cipherText, decryptedText);
 
-	for (round = 1; round <= context->rounds - 2; round++)
+	for (i = 0; i < 4; i++)
 	{
-		// optimize if condifion using array of function pointer to point to even/odd function
-		(*roundFunctions[round % 2])(P, context->dks[subkey++], P);
+		ok &= cipherText[i] == expectedCipherText[i] && blocksCipherText[i] == expectedCipherText[i]
+			&& decryptedText[i] == text[i];
+	}
+
+	return ok;
+}
+
+/*
+	Self check of the decryption keys derived on first use against the
+	eager schedule, computed right after the key expansion as ARIA_init
+	used to, for 16 keys derived from the key of a test vector.
+*/
+static int lazyCheck(const uint32_t* key, uint32_t keyLength)
+{
+	AriaContext context;
+	uint32_t lazyKey[8];
+	uint32_t eks[17][4];
+	uint32_t dks[17][4];
+	uint32_t block[4] = { 0 };
+	uint32_t rounds;
+	uint32_t i;
+	uint32_t j;
+	int ok = 1;
+	int k;
 
-		/*if (round % 2 != 0)
+	for (k = 0; k < 16; k++)
+	{
+		for (i = 0; i < keyLength / 32; i++)
 		{
-			FO(P, context->dks[subkey++], P);
+			lazyKey[i] = key[i] ^ (uint32_t)k * 0x9e3779b9;
 		}
-		else
+
+		rounds = expandKey(lazyKey, keyLength, eks);
+		generateDecryptionKeys(eks, dks, rounds);
+
+		ARIA_init(&context, lazyKey, keyLength);
+		ok &= context.dksState == DKS_NONE;
+
+		ARIA_decrypt(&context, block, block);
+		ok &= context.dksState == DKS_READY && context.rounds == rounds;
+
+		for (i = 0; i < rounds; i++)
 		{
-			FE(P, context->dks[subkey++], P);
-		}*/
+			for (j = 0; j < 4; j++)
+			{
+				ok &= context.dks[i][j] == dks[i][j];
+			}
+		}
+	}
+
+	return ok;
+}
+
+// workers of the shared context check, and how many fresh contexts they share
+#define SHARED_WORKERS 8
+#define SHARED_CONTEXTS 64
+
+typedef struct
+{
+	AriaContext* context;
+	const uint32_t* text;
+	const uint32_t* cipherText;
+	int* failures;
+} AriaSharedTest;
+
+// one decryption through the shared context, half of the workers use the bulk function
+static void sharedDecryptTask(void* argument, size_t index)
+{
+	AriaSharedTest* test = (AriaSharedTest*)argument;
+	uint32_t cipherText[4];
+	uint32_t decryptedText[4];
+	int i;
+
+	MOV_128(cipherText, test->cipherText);
+
+	if (index % 2 == 0)
+	{
+		ARIA_decrypt(test->context, cipherText, decryptedText);
+	}
+	else
+	{
+		ARIA_decrypt_blocks(test->context, cipherText, decryptedText, 1);
 	}
 
-	// last step is different with last two keys
-	// C = SL2(P11 ^ dk12) ^ dk13;
-	XOR_128(P, context->dks[subkey++]);
+	for (i = 0; i < 4; i++)
+	{
+		test->failures[index] += decryptedText[i] != test->text[i];
+	}
+}
 
-	SL2(P, P);
+/*
+	Self check of the decryption keys derived on first use: every
+	fresh context is shared by the workers of a pool before any
+	decryption, so they race to derive dks. All of them must decrypt
+	the test vector and dks must be published once they are done.
+*/
+static int sharedCheck(const uint32_t* key, uint32_t keyLength, const uint32_t* text, const uint32_t* cipherText)
+{
+	ThreadPool* pool = THREADPOOL_create(SHARED_WORKERS);
+	AriaContext context;
+	AriaSharedTest test;
+	int failures[SHARED_WORKERS];
+	int ok = 1;
+	int i;
+
+	if (pool == NULL)
+	{
+		return 0;
+	}
+
+	test.context = &context;
+	test.text = text;
+	test.cipherText = cipherText;
+	test.failures = failures;
+
+	for (i = 0; i < SHARED_WORKERS; i++)
+	{
+		failures[i] = 0;
+	}
+
+	for (i = 0; i < SHARED_CONTEXTS; i++)
+	{
+		ARIA_init(&context, key, keyLength);
+		THREADPOOL_run(pool, sharedDecryptTask, &test, SHARED_WORKERS);
+		ok &= context.dksState == DKS_READY;
+	}
+
+	for (i = 0; i < SHARED_WORKERS; i++)
+	{
+		ok &= failures[i] == 0;
+	}
 
-	XOR_128(P, context->dks[subkey++]);
+	THREADPOOL_destroy(pool);
+
+	return ok;
 }
 
 void ARIA_main(void)
@@ -590,6 +1031,13 @@ void ARIA_main(void)
 	}
 	printf("\n");
 
+	// same vector with the encryption keys only
+	printf("encrypt-only context: \t\t%s\n", encCheck(key, 128, text, expectedCipherText) ? "ok" : "FAILED");
+	printf("lazy decryption keys: \t\t%s\n", lazyCheck(key, 128) ? "ok" : "FAILED");
+
+	// same vector through contexts shared by threads before their first decryption
+	printf("shared on first use: \t\t%s\n", sharedCheck(key, 128, text, expectedCipherText) ? "ok" : "FAILED");
+
 	// *** test for 192-bits key ***
 
 	// key 000102030405060708090a0b0c0d0e0f 1011121314151617
@@ -647,6 +1095,10 @@ void ARIA_main(void)
 	}
 	printf("\n");
 
+	// same vector with the encryption keys only
+	printf("encrypt-only context: \t\t%s\n", encCheck(key, 192, text, expectedCipherText) ? "ok" : "FAILED");
+	printf("lazy decryption keys: \t\t%s\n", lazyCheck(key, 192) ? "ok" : "FAILED");
+
 	// *** test for 256-bits key ***
 
 	// key 000102030405060708090a0b0c0d0e0f 101112131415161718191a1b1c1d1e1f
@@ -705,4 +1157,8 @@ void ARIA_main(void)
 		printf("%08x ", decryptedText[i]);
 	}
 	printf("\n");
+
+	// same vector with the encryption keys only
+	printf("encrypt-only context: \t\t%s\n", encCheck(key, 256, text, expectedCipherText) ? "ok" : "FAILED");
+	printf("lazy decryption keys: \t\t%s\n", lazyCheck(key, 256) ? "ok" : "FAILED");
 }
\ No newline at end of file
@@ -15,11 +15,28 @@ typedef struct
 	uint32_t rounds;
 	// each subkey is 4 parts of 32 bits
 	uint32_t eks[17][4];
+	// dks is derived from eks by the first decryption, dksState tells when it is there
+	uint32_t dksState;
 	uint32_t dks[17][4];
 } AriaContext;
 
+// encryption keys only, for the modes that never decrypt
+typedef struct
+{
+	uint32_t rounds;
+	uint32_t eks[17][4];
+} AriaEncContext;
+
 void ARIA_init(AriaContext* context, const uint32_t* key, uint32_t keyLength);
 void ARIA_encrypt(AriaContext* context, uint32_t* block, uint32_t* P);
 void ARIA_decrypt(AriaContext* context, uint32_t* block, uint32_t* P);
+void ARIA_encrypt_blocks(AriaContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
+void ARIA_decrypt_blocks(AriaContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
+
+void ARIA_enc_init(AriaEncContext* context, const uint32_t* key, uint32_t keyLength);
+void ARIA_enc_encrypt(AriaEncContext* context, uint32_t* block, uint32_t* P);
+void ARIA_enc_decrypt(AriaEncContext* context, uint32_t* block, uint32_t* P);
+void ARIA_enc_encrypt_blocks(AriaEncContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
+void ARIA_enc_decrypt_blocks(AriaEncContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
 
 void ARIA_main(void);
\ No newline at end of file
@@ -0,0 +1,255 @@
+/* ARIA_AESNI.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * ARIA bulk encryption and decryption with AES-NI, 16 blocks at a
+ * time.
+ *
+ * After a 16x16 transposition of the bytes, register i holds the
+ * byte i of the sixteen blocks. SB1 is the AES s-box, aesenclast
+ * with a null round key, and SB3 its inverse, aesdeclast. SB2 is an
+ * affine map of SB1 and SB4 is SB3 of an affine map, evaluated by two
+ * 4 bits pshufb lookups. A() is then xors between registers, its
+ * byte permutations being only a renaming of the registers.
+ *
+ */
+
+#include "ARIA_AESNI.h"
+
+#ifdef ARIA_AESNI
+
+#include <immintrin.h>
+
+// affine map after SB1 giving SB2, low and high nibble
+static const uint8_t post2Low[16] = { 0x88, 0x0d, 0x37, 0xb2, 0x00, 0x85, 0xbf, 0x3a, 0xa8, 0x2d, 0x17, 0x92, 0x20, 0xa5, 0x9f, 0x1a };
+static const uint8_t post2High[16] = { 0x00, 0x3e, 0xd4, 0xea, 0x84, 0xba, 0x50, 0x6e, 0xcd, 0xf3, 0x19, 0x27, 0x49, 0x77, 0x9d, 0xa3 };
+
+// affine map before SB3 giving SB4
+static const uint8_t pre4Low[16] = { 0x04, 0x45, 0xee, 0xaf, 0x17, 0x56, 0xfd, 0xbc, 0x53, 0x12, 0xb9, 0xf8, 0x40, 0x01, 0xaa, 0xeb };
+static const uint8_t pre4High[16] = { 0x00, 0xb6, 0x08, 0xbe, 0xd6, 0x60, 0xde, 0x68, 0x53, 0xe5, 0x5b, 0xed, 0x85, 0x33, 0x8d, 0x3b };
+
+// the inverse of the row shifts done by aesenclast and aesdeclast
+static const uint8_t invShiftRows[16] = { 0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3 };
+static const uint8_t shiftRows[16] = { 0, 5, 10, 15, 4, 9, 14, 3, 8, 13, 2, 7, 12, 1, 6, 11 };
+
+#define LOAD(table) _mm_loadu_si128((const __m128i*)(table))
+
+// affine map given by its low and high nibble tables
+static __m128i FILTER(__m128i x, const uint8_t* low, const uint8_t* high)
+{
+	const __m128i nibbleMask = _mm_set1_epi8(0x0f);
+
+	return _mm_xor_si128(_mm_shuffle_epi8(LOAD(low), _mm_and_si128(x, nibbleMask)),
+		_mm_shuffle_epi8(LOAD(high), _mm_and_si128(_mm_srli_epi16(x, 4), nibbleMask)));
+}
+
+static __m128i SB1(__m128i x)
+{
+	return _mm_aesenclast_si128(_mm_shuffle_epi8(x, LOAD(invShiftRows)), _mm_setzero_si128());
+}
+
+static __m128i SB2(__m128i x)
+{
+	return FILTER(SB1(x), post2Low, post2High);
+}
+
+static __m128i SB3(__m128i x)
+{
+	return _mm_aesdeclast_si128(_mm_shuffle_epi8(x, LOAD(shiftRows)), _mm_setzero_si128());
+}
+
+static __m128i SB4(__m128i x)
+{
+	return SB3(FILTER(x, pre4Low, pre4High));
+}
+
+// substitution layer 1 (odd)
+static void SL1(__m128i* x)
+{
+	int i;
+
+	for (i = 0; i < 16; i += 4)
+	{
+		x[i] = SB1(x[i]);
+		x[i + 1] = SB2(x[i + 1]);
+		x[i + 2] = SB3(x[i + 2]);
+		x[i + 3] = SB4(x[i + 3]);
+	}
+}
+
+// substitution layer 2 (even)
+static void SL2(__m128i* x)
+{
+	int i;
+
+	for (i = 0; i < 16; i += 4)
+	{
+		x[i] = SB3(x[i]);
+		x[i + 1] = SB4(x[i + 1]);
+		x[i + 2] = SB1(x[i + 2]);
+		x[i + 3] = SB2(x[i + 3]);
+	}
+}
+
+// xor of the words a and b, 4 registers each
+static void XOR_WORD(__m128i* a, const __m128i* b)
+{
+	a[0] = _mm_xor_si128(a[0], b[0]);
+	a[1] = _mm_xor_si128(a[1], b[1]);
+	a[2] = _mm_xor_si128(a[2], b[2]);
+	a[3] = _mm_xor_si128(a[3], b[3]);
+}
+
+static void DIFF_WORD(__m128i* x)
+{
+	XOR_WORD(x + 4, x + 8);
+	XOR_WORD(x + 8, x + 12);
+	XOR_WORD(x, x + 4);
+	XOR_WORD(x + 12, x + 4);
+	XOR_WORD(x + 8, x);
+	XOR_WORD(x + 4, x + 8);
+}
+
+/*
+	Diffusion layer, the same steps as the table driven rounds of
+	ARIA.c: each byte goes to the three other bytes of its word, then
+	the words are mixed, reordered inside and mixed again.
+*/
+static void A(__m128i* x)
+{
+	__m128i t;
+	int i;
+
+	for (i = 0; i < 16; i += 4)
+	{
+		t = _mm_xor_si128(_mm_xor_si128(x[i], x[i + 1]), _mm_xor_si128(x[i + 2], x[i + 3]));
+		x[i] = _mm_xor_si128(x[i], t);
+		x[i + 1] = _mm_xor_si128(x[i + 1], t);
+		x[i + 2] = _mm_xor_si128(x[i + 2], t);
+		x[i + 3] = _mm_xor_si128(x[i + 3], t);
+	}
+
+	DIFF_WORD(x);
+
+	// swap the bytes of each 16 bits half of the word 1
+	t = x[4]; x[4] = x[5]; x[5] = t;
+	t = x[6]; x[6] = x[7]; x[7] = t;
+
+	// swap the 16 bits halves of the word 2
+	t = x[8]; x[8] = x[10]; x[10] = t;
+	t = x[9]; x[9] = x[11]; x[11] = t;
+
+	// reverse the bytes of the word 3
+	t = x[12]; x[12] = x[15]; x[15] = t;
+	t = x[13]; x[13] = x[14]; x[14] = t;
+
+	DIFF_WORD(x);
+}
+
+// byte i of the 16 blocks to register i, its own inverse
+static void TRANSPOSE(__m128i* x)
+{
+	__m128i t[16];
+	int pass;
+	int i;
+
+	for (pass = 0; pass < 4; pass++)
+	{
+		for (i = 0; i < 8; i++)
+		{
+			t[2 * i] = _mm_unpacklo_epi8(x[i], x[i + 8]);
+			t[2 * i + 1] = _mm_unpackhi_epi8(x[i], x[i + 8]);
+		}
+
+		for (i = 0; i < 16; i++)
+		{
+			x[i] = t[i];
+		}
+	}
+}
+
+size_t ARIA_blocks_aesni(const uint32_t* ks, uint32_t rounds, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	// bytes of the round keys broadcast over the 16 blocks
+	__m128i roundKeys[17][16];
+	__m128i x[16];
+	// most significant byte of each word first
+	__m128i p[16];
+	size_t done;
+	uint32_t round;
+	int i;
+
+	if (nrBlocks < 16)
+	{
+		return 0;
+	}
+
+	for (round = 0; round < rounds; round++)
+	{
+		for (i = 0; i < 16; i++)
+		{
+			roundKeys[round][i] = _mm_set1_epi8((char)(ks[4 * round + i / 4] >> (24 - 8 * (i % 4))));
+		}
+	}
+
+	for (done = 0; nrBlocks - done >= 16; done += 16, blocks += 64, out += 64)
+	{
+		for (i = 0; i < 16; i++)
+		{
+			x[i] = _mm_loadu_si128((const __m128i*)(blocks + 4 * i));
+		}
+
+		TRANSPOSE(x);
+
+		// the words are little endian in memory
+		for (i = 0; i < 16; i++)
+		{
+			p[i] = x[i ^ 3];
+		}
+
+		// FO in the odd rounds and FE in the even ones
+		for (round = 0; round < rounds - 2; round++)
+		{
+			for (i = 0; i < 16; i++)
+			{
+				p[i] = _mm_xor_si128(p[i], roundKeys[round][i]);
+			}
+
+			if (round % 2 == 0)
+			{
+				SL1(p);
+			}
+			else
+			{
+				SL2(p);
+			}
+
+			A(p);
+		}
+
+		// C = SL2(P ^ k{n}) ^ k{n+1}
+		for (i = 0; i < 16; i++)
+		{
+			p[i] = _mm_xor_si128(p[i], roundKeys[round][i]);
+		}
+
+		SL2(p);
+
+		for (i = 0; i < 16; i++)
+		{
+			x[i ^ 3] = _mm_xor_si128(p[i], roundKeys[round + 1][i]);
+		}
+
+		TRANSPOSE(x);
+
+		for (i = 0; i < 16; i++)
+		{
+			_mm_storeu_si128((__m128i*)(out + 4 * i), x[i]);
+		}
+	}
+
+	return done;
+}
+
+#endif
@@ -0,0 +1,27 @@
+/* ARIA_AESNI.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * ARIA bulk kernel with AES-NI, used by the bulk functions of ARIA.c
+ * when the CPU supports AES-NI and AVX. Must be compiled with both
+ * enabled.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define ARIA_AESNI
+#endif
+
+/*
+	Process the largest multiple of 16 blocks of nrBlocks and return
+	how many blocks were processed, the caller handles the rest.
+
+	ks holds the rounds round keys of 4 words (eks or dks).
+*/
+size_t ARIA_blocks_aesni(const uint32_t* ks, uint32_t rounds, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
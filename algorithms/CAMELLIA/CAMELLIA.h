@@ -20,5 +20,7 @@ typedef struct
 void CAMELLIA_init(CamelliaContext* context, const uint64_t* key, uint16_t keyLen);
 void CAMELLIA_encrypt(const CamelliaContext* context, const uint64_t* block, uint64_t* out);
 void CAMELLIA_decrypt(const CamelliaContext* context, const uint64_t* block, uint64_t* out);
+void CAMELLIA_encrypt_blocks(const CamelliaContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
+void CAMELLIA_decrypt_blocks(const CamelliaContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
 
 void CAMELLIA_main(void);
\ No newline at end of file
@@ -0,0 +1,269 @@
+/* CAMELLIA_AESNI.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * CAMELLIA bulk encryption and decryption with AES-NI, 16 blocks at
+ * a time.
+ *
+ * After a 16x16 transposition of the bytes, register i holds the
+ * byte i of the sixteen blocks, so every register goes through a
+ * single s-box and the P-function is only xors between registers.
+ *
+ * The s-boxes of CAMELLIA are affine equivalent to the one of AES,
+ * sbox1(x) = post(aes_sbox(pre(x))) with pre and post affine, which
+ * are evaluated by two 4 bits pshufb lookups each. aesenclast with
+ * a null round key is the aes_sbox of all bytes, preceded by the
+ * inverse of its ShiftRows so the bytes stay in their lanes.
+ *
+ * sbox2 and sbox3 rotate the output of sbox1 and sbox4 rotates its
+ * input, the rotations are part of the pre and post tables.
+ *
+ */
+
+#include "CAMELLIA_AESNI.h"
+
+#ifdef CAMELLIA_AESNI
+
+#include <immintrin.h>
+
+// pre(x), low and high nibble
+static const uint8_t pre1Low[16] = { 0xb3, 0xb2, 0xe5, 0xe4, 0xe2, 0xe3, 0xb4, 0xb5, 0xae, 0xaf, 0xf8, 0xf9, 0xff, 0xfe, 0xa9, 0xa8 };
+static const uint8_t pre1High[16] = { 0x00, 0xf0, 0xde, 0x2e, 0x7d, 0x8d, 0xa3, 0x53, 0x9e, 0x6e, 0x40, 0xb0, 0xe3, 0x13, 0x3d, 0xcd };
+
+// pre(x <<< 1), for sbox4
+static const uint8_t pre4Low[16] = { 0xb3, 0xe5, 0xe2, 0xb4, 0xae, 0xf8, 0xff, 0xa9, 0x43, 0x15, 0x12, 0x44, 0x5e, 0x08, 0x0f, 0x59 };
+static const uint8_t pre4High[16] = { 0x00, 0xde, 0x7d, 0xa3, 0x9e, 0x40, 0xe3, 0x3d, 0x01, 0xdf, 0x7c, 0xa2, 0x9f, 0x41, 0xe2, 0x3c };
+
+// post(x), for sbox1 and sbox4
+static const uint8_t post1Low[16] = { 0xc8, 0x4e, 0x1f, 0x99, 0x54, 0xd2, 0x83, 0x05, 0x9d, 0x1b, 0x4a, 0xcc, 0x01, 0x87, 0xd6, 0x50 };
+static const uint8_t post1High[16] = { 0x00, 0x69, 0xee, 0x87, 0x19, 0x70, 0xf7, 0x9e, 0x47, 0x2e, 0xa9, 0xc0, 0x5e, 0x37, 0xb0, 0xd9 };
+
+// post(x) <<< 1, for sbox2
+static const uint8_t post2Low[16] = { 0x91, 0x9c, 0x3e, 0x33, 0xa8, 0xa5, 0x07, 0x0a, 0x3b, 0x36, 0x94, 0x99, 0x02, 0x0f, 0xad, 0xa0 };
+static const uint8_t post2High[16] = { 0x00, 0xd2, 0xdd, 0x0f, 0x32, 0xe0, 0xef, 0x3d, 0x8e, 0x5c, 0x53, 0x81, 0xbc, 0x6e, 0x61, 0xb3 };
+
+// post(x) >>> 1, for sbox3
+static const uint8_t post3Low[16] = { 0x64, 0x27, 0x8f, 0xcc, 0x2a, 0x69, 0xc1, 0x82, 0xce, 0x8d, 0x25, 0x66, 0x80, 0xc3, 0x6b, 0x28 };
+static const uint8_t post3High[16] = { 0x00, 0xb4, 0x77, 0xc3, 0x8c, 0x38, 0xfb, 0x4f, 0xa3, 0x17, 0xd4, 0x60, 0x2f, 0x9b, 0x58, 0xec };
+
+// inverse of the ShiftRows done by aesenclast
+static const uint8_t invShiftRows[16] = { 0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3 };
+
+#define LOAD(table) _mm_loadu_si128((const __m128i*)(table))
+
+// affine map given by its low and high nibble tables
+static __m128i FILTER(__m128i x, const uint8_t* low, const uint8_t* high)
+{
+	const __m128i nibbleMask = _mm_set1_epi8(0x0f);
+
+	return _mm_xor_si128(_mm_shuffle_epi8(LOAD(low), _mm_and_si128(x, nibbleMask)),
+		_mm_shuffle_epi8(LOAD(high), _mm_and_si128(_mm_srli_epi16(x, 4), nibbleMask)));
+}
+
+static __m128i SBOX(__m128i x, const uint8_t* preLow, const uint8_t* preHigh, const uint8_t* postLow, const uint8_t* postHigh)
+{
+	x = FILTER(x, preLow, preHigh);
+	x = _mm_shuffle_epi8(x, LOAD(invShiftRows));
+	x = _mm_aesenclast_si128(x, _mm_setzero_si128());
+
+	return FILTER(x, postLow, postHigh);
+}
+
+/*
+	out ^= F(in, key), in and out are the 8 bytes of one half of the
+	blocks and key the 8 bytes of the subkey, most significant first.
+*/
+static void F(const __m128i* in, const __m128i* key, __m128i* out)
+{
+	__m128i z1 = SBOX(_mm_xor_si128(in[0], key[0]), pre1Low, pre1High, post1Low, post1High);
+	__m128i z2 = SBOX(_mm_xor_si128(in[1], key[1]), pre1Low, pre1High, post2Low, post2High);
+	__m128i z3 = SBOX(_mm_xor_si128(in[2], key[2]), pre1Low, pre1High, post3Low, post3High);
+	__m128i z4 = SBOX(_mm_xor_si128(in[3], key[3]), pre4Low, pre4High, post1Low, post1High);
+	__m128i z5 = SBOX(_mm_xor_si128(in[4], key[4]), pre1Low, pre1High, post2Low, post2High);
+	__m128i z6 = SBOX(_mm_xor_si128(in[5], key[5]), pre1Low, pre1High, post3Low, post3High);
+	__m128i z7 = SBOX(_mm_xor_si128(in[6], key[6]), pre4Low, pre4High, post1Low, post1High);
+	__m128i z8 = SBOX(_mm_xor_si128(in[7], key[7]), pre1Low, pre1High, post1Low, post1High);
+
+	// P-function
+	z1 = _mm_xor_si128(z1, z6);
+	z2 = _mm_xor_si128(z2, z7);
+	z3 = _mm_xor_si128(z3, z8);
+	z4 = _mm_xor_si128(z4, z5);
+	z5 = _mm_xor_si128(z5, z3);
+	z6 = _mm_xor_si128(z6, z4);
+	z7 = _mm_xor_si128(z7, z1);
+	z8 = _mm_xor_si128(z8, z2);
+	z1 = _mm_xor_si128(z1, z8);
+	z2 = _mm_xor_si128(z2, z5);
+	z3 = _mm_xor_si128(z3, z6);
+	z4 = _mm_xor_si128(z4, z7);
+	z5 = _mm_xor_si128(z5, z4);
+	z6 = _mm_xor_si128(z6, z1);
+	z7 = _mm_xor_si128(z7, z2);
+	z8 = _mm_xor_si128(z8, z3);
+
+	out[0] = _mm_xor_si128(out[0], z5);
+	out[1] = _mm_xor_si128(out[1], z6);
+	out[2] = _mm_xor_si128(out[2], z7);
+	out[3] = _mm_xor_si128(out[3], z8);
+	out[4] = _mm_xor_si128(out[4], z1);
+	out[5] = _mm_xor_si128(out[5], z2);
+	out[6] = _mm_xor_si128(out[6], z3);
+	out[7] = _mm_xor_si128(out[7], z4);
+}
+
+/*
+	x ^= ROL_32(y & k, 1) on the 4 bytes of a 32 bits word. The bit
+	shifted out of each byte comes from the msb of the next one.
+*/
+static void XOR_ROL_AND(__m128i* x, const __m128i* y, const __m128i* k)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i t[4];
+	__m128i carry;
+	int i;
+
+	for (i = 0; i < 4; i++)
+	{
+		t[i] = _mm_and_si128(y[i], k[i]);
+	}
+
+	for (i = 0; i < 4; i++)
+	{
+		// 1 where the msb of the next byte is set
+		carry = _mm_sub_epi8(zero, _mm_cmpgt_epi8(zero, t[(i + 1) & 3]));
+		x[i] = _mm_xor_si128(x[i], _mm_or_si128(_mm_add_epi8(t[i], t[i]), carry));
+	}
+}
+
+// x ^= y | k on the 4 bytes of a 32 bits word
+static void XOR_OR(__m128i* x, const __m128i* y, const __m128i* k)
+{
+	int i;
+
+	for (i = 0; i < 4; i++)
+	{
+		x[i] = _mm_xor_si128(x[i], _mm_or_si128(y[i], k[i]));
+	}
+}
+
+static void FL(__m128i* x, const __m128i* key)
+{
+	XOR_ROL_AND(x + 4, x, key);
+	XOR_OR(x, x + 4, key + 4);
+}
+
+static void FLINV(__m128i* y, const __m128i* key)
+{
+	XOR_OR(y, y + 4, key + 4);
+	XOR_ROL_AND(y + 4, y, key);
+}
+
+/*
+	Byte i of the 16 blocks to register i. Each of the 4 passes moves
+	the bits of the register index one position into the byte index,
+	so it is its own inverse.
+*/
+static void TRANSPOSE(__m128i* x)
+{
+	__m128i t[16];
+	int pass;
+	int i;
+
+	for (pass = 0; pass < 4; pass++)
+	{
+		for (i = 0; i < 8; i++)
+		{
+			t[2 * i] = _mm_unpacklo_epi8(x[i], x[i + 8]);
+			t[2 * i + 1] = _mm_unpackhi_epi8(x[i], x[i + 8]);
+		}
+
+		for (i = 0; i < 16; i++)
+		{
+			x[i] = t[i];
+		}
+	}
+}
+
+size_t CAMELLIA_blocks_aesni(const uint64_t* k, int feistelIterations, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	// bytes of the subkeys broadcast over the 16 blocks
+	__m128i subkeys[34][8];
+	__m128i x[16];
+	// D1 and D2, most significant byte first
+	__m128i d[16];
+	const __m128i* key;
+	int nrSubkeys = 8 * feistelIterations + 2;
+	int feistelIteration;
+	size_t done;
+	int i;
+	int j;
+
+	if (nrBlocks < 16)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < nrSubkeys; i++)
+	{
+		for (j = 0; j < 8; j++)
+		{
+			subkeys[i][j] = _mm_set1_epi8((char)(k[i] >> (56 - 8 * j)));
+		}
+	}
+
+	for (done = 0; nrBlocks - done >= 16; done += 16, blocks += 32, out += 32)
+	{
+		for (i = 0; i < 16; i++)
+		{
+			x[i] = _mm_loadu_si128((const __m128i*)(blocks + 2 * i));
+		}
+
+		TRANSPOSE(x);
+
+		// the words are little endian in memory, prewhitening
+		for (i = 0; i < 16; i++)
+		{
+			d[i] = _mm_xor_si128(x[i ^ 7], subkeys[i >> 3][i & 7]);
+		}
+
+		key = subkeys[2];
+
+		for (feistelIteration = 0; feistelIteration < feistelIterations; feistelIteration++)
+		{
+			F(d, key, d + 8);
+			F(d + 8, key + 8, d);
+			F(d, key + 16, d + 8);
+			F(d + 8, key + 24, d);
+			F(d, key + 32, d + 8);
+			F(d + 8, key + 40, d);
+			key += 48;
+
+			// do not insert FL and FLINV functions in last iteration
+			if (feistelIteration != feistelIterations - 1)
+			{
+				FL(d, key);
+				FLINV(d + 8, key + 8);
+				key += 16;
+			}
+		}
+
+		// postwhitening, D2 goes first
+		for (i = 0; i < 16; i++)
+		{
+			x[i ^ 7] = _mm_xor_si128(d[i ^ 8], key[i]);
+		}
+
+		TRANSPOSE(x);
+
+		for (i = 0; i < 16; i++)
+		{
+			_mm_storeu_si128((__m128i*)(out + 2 * i), x[i]);
+		}
+	}
+
+	return done;
+}
+
+#endif
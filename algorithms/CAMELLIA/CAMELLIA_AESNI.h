@@ -0,0 +1,28 @@
+/* CAMELLIA_AESNI.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * CAMELLIA bulk kernel with AES-NI, used by the bulk functions of
+ * CAMELLIA.c when the CPU supports AES-NI and AVX. Must be compiled
+ * with both enabled.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CAMELLIA_AESNI
+#endif
+
+/*
+	Process the largest multiple of 16 blocks of nrBlocks and return
+	how many blocks were processed, the caller handles the rest.
+
+	k holds the 8 * feistelIterations + 2 subkeys in the order they
+	are used by the encryption, decryption passes them reordered.
+*/
+size_t CAMELLIA_blocks_aesni(const uint64_t* k, int feistelIterations, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
@@ -16,14 +16,8 @@
 
 #include "GOST.h"
 
-uint32_t CM1;
-uint32_t CM2;
-uint32_t N1;
-uint32_t N2;
-uint32_t R;
-
 // S-box used by the Central Bank of Russian Federation
-const uint8_t s_box[8][16] = {
+static const uint8_t s_box[8][16] = {
 									{ 4, 10, 9, 2, 13, 8, 0, 14, 6, 11, 1, 12, 7, 15, 5, 3 },
 									{ 14, 11, 4, 12, 6, 13, 15, 10, 2, 3, 8, 1, 0, 7, 5, 9 },
 									{ 5, 8, 1, 13, 10, 3, 4, 2, 14, 15, 12, 7, 6, 0, 9, 11 },
@@ -34,97 +28,183 @@ const uint8_t s_box[8][16] = {
 									{ 1, 15, 13, 0, 5, 7, 10, 4, 9, 2, 3, 14, 6, 11, 8, 12 }
 };
 
-void GOST_round(uint32_t xi)
+/*
+	Merge the S-boxes of two adjacent 4 bits parts into one 8 bits
+	table and apply the cyclic 11 shift to its output, so a round
+	is four lookups instead of eight substitutions.
+
+	Byte i of the 32 bits input holds the parts 7 - 2i (low nibble)
+	and 6 - 2i (high nibble).
+*/
+void GOST_init(GostContext* context, uint32_t* key)
 {
-	CM1 = (N1 + xi) % 4294967296; // 2^32
+	int i;
+	int j;
+	uint32_t SN;
 
-	// read entire s-box column according to the CM1 bits
-	uint32_t SN = 0;
-	for (int j = 0; j <= 7; j++)
+	for (i = 0; i < 8; i++)
 	{
-		/*
-		* 32 bits input is divided into 8 parts, each of 4 bits
-		* to a correponding substitution point column point
-		* in the s-box
-		*
-		* The line below generate a random column that will be
-		* read from the s-box at each line and based on the
-		* size of the total 16 columns of s-box (and thus % 16)
-		*/
-		uint8_t Ni = (CM1 >> (4 * (7 - j))) % 16;
-		Ni = s_box[j][Ni]; // substitution through s-blocks.
-
-		// place the read bits to correct position in the 32 bit output
-		uint32_t mask = 0;
-		mask = mask | Ni;
-		mask = mask << (28 - (4 * j));
-		SN = SN | mask;
+		context->key[i] = key[i];
 	}
 
-	R = SN;
-
-	// cyclic 11 shift
-	uint32_t mask = R << 11;
-	R = (R >> 21) | mask;
+	for (i = 0; i < 4; i++)
+	{
+		for (j = 0; j < 256; j++)
+		{
+			SN = (uint32_t)(s_box[6 - 2 * i][j >> 4] << 4 | s_box[7 - 2 * i][j & 0xf]) << (8 * i);
+			context->sBoxes[i][j] = SN << 11 | SN >> 21;
+		}
+	}
+}
 
-	// modulo 2 addition
-	CM2 = R ^ N2;
-	N2 = N1;
-	N1 = CM2;
+// s-box substitution followed by the cyclic 11 shift
+static uint32_t GOST_f(const GostContext* context, uint32_t x)
+{
+	return context->sBoxes[0][x & 0xff]
+		^ context->sBoxes[1][(x >> 8) & 0xff]
+		^ context->sBoxes[2][(x >> 16) & 0xff]
+		^ context->sBoxes[3][x >> 24];
 }
 
-uint64_t GOST_encrypt(uint64_t block, uint32_t* key)
+uint64_t GOST_encrypt(GostContext* context, uint64_t block)
 {
-	N1 = (uint32_t)block;
-	N2 = block >> 32;
+	uint32_t N1 = (uint32_t)block;
+	uint32_t N2 = block >> 32;
+	uint32_t temp;
+	int i;
+	int k;
 
 	// first 24 rounds
-	for (int k = 0; k < 3; k++)
+	for (k = 0; k < 3; k++)
 	{
-		for (int i = 0; i <= 7; i++)
+		for (i = 0; i <= 7; i++)
 		{
-			GOST_round(key[i]);
+			temp = N2 ^ GOST_f(context, N1 + context->key[i]);
+			N2 = N1;
+			N1 = temp;
 		}
 	}
 
 	// last 8 rounds
-	for (int i = 7; i >= 0; i--)
+	for (i = 7; i >= 0; i--)
 	{
-		GOST_round(key[i]);
+		temp = N2 ^ GOST_f(context, N1 + context->key[i]);
+		N2 = N1;
+		N1 = temp;
 	}
 
-	uint64_t tc = N1;
-	tc = (tc << 32) | N2;
-	return tc;
+	return (uint64_t)N1 << 32 | N2;
 }
 
-uint64_t GOST_decrypt(uint64_t encryptedBlock, uint32_t* key)
+uint64_t GOST_decrypt(GostContext* context, uint64_t encryptedBlock)
 {
-	N1 = (uint32_t)encryptedBlock;
-	N2 = encryptedBlock >> 32;
+	uint32_t N1 = (uint32_t)encryptedBlock;
+	uint32_t N2 = encryptedBlock >> 32;
+	uint32_t temp;
+	int i;
+	int k;
 
 	// last 8 rounds
-	for (int i = 0; i <= 7; i++)
+	for (i = 0; i <= 7; i++)
 	{
-		GOST_round(key[i]);
+		temp = N2 ^ GOST_f(context, N1 + context->key[i]);
+		N2 = N1;
+		N1 = temp;
 	}
 
 	// first 24 rounds
-	for (int k = 0; k < 3; k++)
+	for (k = 0; k < 3; k++)
+	{
+		for (i = 7; i >= 0; i--)
+		{
+			temp = N2 ^ GOST_f(context, N1 + context->key[i]);
+			N2 = N1;
+			N1 = temp;
+		}
+	}
+
+	return (uint64_t)N1 << 32 | N2;
+}
+
+// key index used in each of the 32 rounds
+static const uint8_t encryptionOrder[32] =
+{
+	0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7,
+	0, 1, 2, 3, 4, 5, 6, 7, 7, 6, 5, 4, 3, 2, 1, 0
+};
+
+static const uint8_t decryptionOrder[32] =
+{
+	0, 1, 2, 3, 4, 5, 6, 7, 7, 6, 5, 4, 3, 2, 1, 0,
+	7, 6, 5, 4, 3, 2, 1, 0, 7, 6, 5, 4, 3, 2, 1, 0
+};
+
+/*
+	Bulk ECB processing of nrBlocks blocks following the given key order.
+
+	Two independent blocks share every round key, so the lookups
+	of one block overlap with the additions of the other.
+*/
+static void GOST_blocks(const GostContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks, const uint8_t* order)
+{
+	int round;
+	uint32_t k;
+	uint32_t temp;
+	uint32_t n1a, n2a, n1b, n2b;
+
+	for (; nrBlocks >= 2; nrBlocks -= 2, blocks += 2, out += 2)
 	{
-		for (int i = 7; i >= 0; i--)
+		n1a = (uint32_t)blocks[0];
+		n2a = blocks[0] >> 32;
+		n1b = (uint32_t)blocks[1];
+		n2b = blocks[1] >> 32;
+
+		for (round = 0; round < 32; round++)
 		{
-			GOST_round(key[i]);
+			k = context->key[order[round]];
+
+			temp = n2a ^ GOST_f(context, n1a + k);
+			n2a = n1a;
+			n1a = temp;
+
+			temp = n2b ^ GOST_f(context, n1b + k);
+			n2b = n1b;
+			n1b = temp;
 		}
+
+		out[0] = (uint64_t)n1a << 32 | n2a;
+		out[1] = (uint64_t)n1b << 32 | n2b;
 	}
 
-	uint64_t tc = N1;
-	tc = (tc << 32) | N2;
-	return tc;
+	if (nrBlocks > 0)
+	{
+		n1a = (uint32_t)blocks[0];
+		n2a = blocks[0] >> 32;
+
+		for (round = 0; round < 32; round++)
+		{
+			temp = n2a ^ GOST_f(context, n1a + context->key[order[round]]);
+			n2a = n1a;
+			n1a = temp;
+		}
+
+		out[0] = (uint64_t)n1a << 32 | n2a;
+	}
+}
+
+void GOST_encrypt_blocks(GostContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	GOST_blocks(context, blocks, out, nrBlocks, encryptionOrder);
+}
+
+void GOST_decrypt_blocks(GostContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	GOST_blocks(context, blocks, out, nrBlocks, decryptionOrder);
 }
 
 void GOST_main(void)
 {
+	GostContext context;
 	uint32_t key[8];
 	int i;
 	for (i = 0; i < 8; i++)
@@ -135,8 +215,10 @@ void GOST_main(void)
 	uint64_t text = 118105110105;
 	uint64_t expectedCipherText = 3078704057068866123;
 
-	uint64_t cipherText = GOST_encrypt(text, key);
-	uint64_t decrypted = GOST_decrypt(cipherText, key);
+	GOST_init(&context, key);
+
+	uint64_t cipherText = GOST_encrypt(&context, text);
+	uint64_t decrypted = GOST_decrypt(&context, cipherText);
 
 	printf("\nGOST \n\n");
 
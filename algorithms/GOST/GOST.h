@@ -10,7 +10,17 @@
 #include <stdio.h>
 #include <stdint.h>
 
-uint64_t GOST_encrypt(uint64_t block, uint32_t* key);
-uint64_t GOST_decrypt(uint64_t encryptedBlock, uint32_t* key);
+typedef struct
+{
+	uint32_t key[8];
+	// s-box of two adjacent 4 bits parts with the cyclic 11 shift applied
+	uint32_t sBoxes[4][256];
+} GostContext;
+
+void GOST_init(GostContext* context, uint32_t* key);
+uint64_t GOST_encrypt(GostContext* context, uint64_t block);
+uint64_t GOST_decrypt(GostContext* context, uint64_t encryptedBlock);
+void GOST_encrypt_blocks(GostContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
+void GOST_decrypt_blocks(GostContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
 
 void GOST_main(void);
\ No newline at end of file
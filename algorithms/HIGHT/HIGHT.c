@@ -17,6 +17,9 @@
  */
 
 #include "HIGHT.h"
+#include "HIGHT_SSE2.h"
+#include "HIGHT_AVX2.h"
+#include "../../cpu/CPU.h"
 
 #define NR_ROUNDS 32
 
@@ -198,9 +201,300 @@ void HIGHT_decrypt(HightContext* context, uint8_t* block, uint8_t* out)
 	out[7] = x[7];
 }
 
+/*
+	Run the byte-sliced kernels on 32 (AVX2) and then 16 (SSE2)
+	blocks at a time and return how many blocks they processed, the
+	remaining blocks go to the portable code.
+*/
+static size_t HIGHT_blocks_simd(const HightContext* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks, int decrypt)
+{
+	size_t done = 0;
+
+#ifdef HIGHT_AVX2
+	if (CPU_has(CPU_AVX2))
+	{
+		done = decrypt
+			? HIGHT_decrypt_blocks_avx2(context->whiteningKeys, context->subkeys, blocks, out, nrBlocks)
+			: HIGHT_encrypt_blocks_avx2(context->whiteningKeys, context->subkeys, blocks, out, nrBlocks);
+	}
+#endif
+
+#ifdef HIGHT_SSE2
+	if (CPU_has(CPU_SSE2))
+	{
+		done += decrypt
+			? HIGHT_decrypt_blocks_sse2(context->whiteningKeys, context->subkeys, blocks + 8 * done, out + 8 * done, nrBlocks - done)
+			: HIGHT_encrypt_blocks_sse2(context->whiteningKeys, context->subkeys, blocks + 8 * done, out + 8 * done, nrBlocks - done);
+	}
+#endif
+
+	return done;
+}
+
+/*
+	Bulk ECB encryption of nrBlocks consecutive 8 bytes blocks.
+
+	The SIMD kernels take the bulk of the blocks. In the portable
+	code two independent blocks are processed per iteration and
+	share the four subkeys of each round.
+*/
+void HIGHT_encrypt_blocks(HightContext* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	uint8_t r;
+	uint8_t subkey;
+	uint8_t sk0, sk1, sk2, sk3;
+	uint8_t a[8];
+	uint8_t b[8];
+	size_t done = HIGHT_blocks_simd(context, blocks, out, nrBlocks, 0);
+
+	nrBlocks -= done;
+	blocks += 8 * done;
+	out += 8 * done;
+
+	for (; nrBlocks >= 2; nrBlocks -= 2, blocks += 16, out += 16)
+	{
+		// Initial Transformation
+		a[0] = blocks[0] + context->whiteningKeys[0];
+		a[1] = blocks[1];
+		a[2] = blocks[2] ^ context->whiteningKeys[1];
+		a[3] = blocks[3];
+		a[4] = blocks[4] + context->whiteningKeys[2];
+		a[5] = blocks[5];
+		a[6] = blocks[6] ^ context->whiteningKeys[3];
+		a[7] = blocks[7];
+
+		b[0] = blocks[8] + context->whiteningKeys[0];
+		b[1] = blocks[9];
+		b[2] = blocks[10] ^ context->whiteningKeys[1];
+		b[3] = blocks[11];
+		b[4] = blocks[12] + context->whiteningKeys[2];
+		b[5] = blocks[13];
+		b[6] = blocks[14] ^ context->whiteningKeys[3];
+		b[7] = blocks[15];
+
+		// Rounds
+		for (r = 0, subkey = 0; r < NR_ROUNDS; r++, subkey += 4)
+		{
+			sk0 = context->subkeys[subkey];
+			sk1 = context->subkeys[subkey + 1];
+			sk2 = context->subkeys[subkey + 2];
+			sk3 = context->subkeys[subkey + 3];
+
+			HIGHT_round(a, sk0, sk1, sk2, sk3);
+			HIGHT_round(b, sk0, sk1, sk2, sk3);
+		}
+
+		// Final Transformation
+		out[0] = a[1] + context->whiteningKeys[4];
+		out[1] = a[2];
+		out[2] = a[3] ^ context->whiteningKeys[5];
+		out[3] = a[4];
+		out[4] = a[5] + context->whiteningKeys[6];
+		out[5] = a[6];
+		out[6] = a[7] ^ context->whiteningKeys[7];
+		out[7] = a[0];
+
+		out[8] = b[1] + context->whiteningKeys[4];
+		out[9] = b[2];
+		out[10] = b[3] ^ context->whiteningKeys[5];
+		out[11] = b[4];
+		out[12] = b[5] + context->whiteningKeys[6];
+		out[13] = b[6];
+		out[14] = b[7] ^ context->whiteningKeys[7];
+		out[15] = b[0];
+	}
+
+	if (nrBlocks > 0)
+	{
+		HIGHT_encrypt(context, (uint8_t*)blocks, out);
+	}
+}
+
+void HIGHT_decrypt_blocks(HightContext* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	uint8_t r;
+	uint8_t subkey;
+	uint8_t sk0, sk1, sk2, sk3;
+	uint8_t a[8];
+	uint8_t b[8];
+	size_t done = HIGHT_blocks_simd(context, blocks, out, nrBlocks, 1);
+
+	nrBlocks -= done;
+	blocks += 8 * done;
+	out += 8 * done;
+
+	for (; nrBlocks >= 2; nrBlocks -= 2, blocks += 16, out += 16)
+	{
+		// Final Inverse Transformation
+		a[7] = blocks[6] ^ context->whiteningKeys[7];
+		a[6] = blocks[5];
+		a[5] = blocks[4] - context->whiteningKeys[6];
+		a[4] = blocks[3];
+		a[3] = blocks[2] ^ context->whiteningKeys[5];
+		a[2] = blocks[1];
+		a[1] = blocks[0] - context->whiteningKeys[4];
+		a[0] = blocks[7];
+
+		b[7] = blocks[14] ^ context->whiteningKeys[7];
+		b[6] = blocks[13];
+		b[5] = blocks[12] - context->whiteningKeys[6];
+		b[4] = blocks[11];
+		b[3] = blocks[10] ^ context->whiteningKeys[5];
+		b[2] = blocks[9];
+		b[1] = blocks[8] - context->whiteningKeys[4];
+		b[0] = blocks[15];
+
+		// Rounds
+		for (r = 0, subkey = 127; r < NR_ROUNDS; r++, subkey -= 4)
+		{
+			sk0 = context->subkeys[subkey];
+			sk1 = context->subkeys[subkey - 1];
+			sk2 = context->subkeys[subkey - 2];
+			sk3 = context->subkeys[subkey - 3];
+
+			HIGHT_inverse_round(a, sk0, sk1, sk2, sk3);
+			HIGHT_inverse_round(b, sk0, sk1, sk2, sk3);
+		}
+
+		// Initial Inverse Transformation
+		out[0] = a[0] - context->whiteningKeys[0];
+		out[1] = a[1];
+		out[2] = a[2] ^ context->whiteningKeys[1];
+		out[3] = a[3];
+		out[4] = a[4] - context->whiteningKeys[2];
+		out[5] = a[5];
+		out[6] = a[6] ^ context->whiteningKeys[3];
+		out[7] = a[7];
+
+		out[8] = b[0] - context->whiteningKeys[0];
+		out[9] = b[1];
+		out[10] = b[2] ^ context->whiteningKeys[1];
+		out[11] = b[3];
+		out[12] = b[4] - context->whiteningKeys[2];
+		out[13] = b[5];
+		out[14] = b[6] ^ context->whiteningKeys[3];
+		out[15] = b[7];
+	}
+
+	if (nrBlocks > 0)
+	{
+		HIGHT_decrypt(context, (uint8_t*)blocks, out);
+	}
+}
+
+/*
+	Encrypt the blocks of HIGHT_BATCH_LANES contexts with the keys
+	sliced like the blocks, one key per lane. Returns 0 when the
+	kernel cannot be used.
+*/
+static int HIGHT_batch_simd(HightContext** contexts, const uint8_t* blocks, uint8_t* out)
+{
+#ifdef HIGHT_AVX2
+	const uint8_t* whiteningKeys[HIGHT_BATCH_LANES];
+	const uint8_t* subkeys[HIGHT_BATCH_LANES];
+	int b;
+
+	if (!CPU_has(CPU_AVX2))
+	{
+		return 0;
+	}
+
+	for (b = 0; b < HIGHT_BATCH_LANES; b++)
+	{
+		whiteningKeys[b] = contexts[b]->whiteningKeys;
+		subkeys[b] = contexts[b]->subkeys;
+	}
+
+	HIGHT_encrypt_batch_avx2(whiteningKeys, subkeys, blocks, out);
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+static int HIGHT_batch_keys_simd(const uint8_t* keys, const uint8_t* blocks, uint8_t* out)
+{
+#ifdef HIGHT_AVX2
+	if (CPU_has(CPU_AVX2))
+	{
+		HIGHT_encrypt_batch_keys_avx2(keys, blocks, out);
+		return 1;
+	}
+#endif
+
+	return 0;
+}
+
+/*
+	Batch encryption of one block under each of nrBlocks keys, the
+	block b (bytes 8b to 8b + 7) is encrypted under contexts[b].
+
+	The SIMD kernel runs one key per lane instead of one block per
+	lane, the remaining blocks go through HIGHT_encrypt.
+*/
+void HIGHT_encrypt_batch(HightContext** contexts, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	int b;
+
+	for (; nrBlocks >= HIGHT_BATCH_LANES; nrBlocks -= HIGHT_BATCH_LANES,
+		contexts += HIGHT_BATCH_LANES, blocks += 8 * HIGHT_BATCH_LANES, out += 8 * HIGHT_BATCH_LANES)
+	{
+		if (!HIGHT_batch_simd(contexts, blocks, out))
+		{
+			for (b = 0; b < HIGHT_BATCH_LANES; b++)
+			{
+				HIGHT_encrypt(contexts[b], (uint8_t*)blocks + 8 * b, out + 8 * b);
+			}
+		}
+	}
+
+	for (; nrBlocks > 0; nrBlocks--, contexts++, blocks += 8, out += 8)
+	{
+		HIGHT_encrypt(*contexts, (uint8_t*)blocks, out);
+	}
+}
+
+/*
+	Batch encryption under raw 16 bytes keys, the key b is keys[16 * b]
+	to keys[16 * b + 15]. The SIMD kernel derives the subkeys in the
+	lanes without building any context.
+*/
+void HIGHT_encrypt_batch_keys(const uint8_t* keys, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	HightContext context;
+	int b;
+
+	for (; nrBlocks >= HIGHT_BATCH_LANES; nrBlocks -= HIGHT_BATCH_LANES,
+		keys += 16 * HIGHT_BATCH_LANES, blocks += 8 * HIGHT_BATCH_LANES, out += 8 * HIGHT_BATCH_LANES)
+	{
+		if (!HIGHT_batch_keys_simd(keys, blocks, out))
+		{
+			for (b = 0; b < HIGHT_BATCH_LANES; b++)
+			{
+				HIGHT_init(&context, (uint8_t*)keys + 16 * b);
+				HIGHT_encrypt(&context, (uint8_t*)blocks + 8 * b, out + 8 * b);
+			}
+		}
+	}
+
+	for (; nrBlocks > 0; nrBlocks--, keys += 16, blocks += 8, out += 8)
+	{
+		HIGHT_init(&context, (uint8_t*)keys);
+		HIGHT_encrypt(&context, (uint8_t*)blocks, out);
+	}
+}
+
 void HIGHT_main(void)
 {
 	HightContext context;
+	HightContext batchContexts[HIGHT_BATCH_LANES + 3];
+	HightContext* batchPointers[HIGHT_BATCH_LANES + 3];
+	uint8_t batchKeys[16 * (HIGHT_BATCH_LANES + 3)];
+	uint8_t batchText[8 * (HIGHT_BATCH_LANES + 3)];
+	uint8_t batchCipherText[8 * (HIGHT_BATCH_LANES + 3)];
+	uint8_t batchKeysCipherText[8 * (HIGHT_BATCH_LANES + 3)];
+	int contextsOk;
+	int keysOk;
 	int i;
 	uint8_t key[16];
 	uint8_t text[8];
@@ -287,4 +581,45 @@ void HIGHT_main(void)
 		printf("%02x ", decryptedText[i]);
 	}
 	printf("\n");
+
+	// *** batch of keys test ***
+
+	// the vector text under HIGHT_BATCH_LANES + 3 keys, the key b is
+	// the vector key with b added to its first byte
+	for (i = 0; i < 16 * (HIGHT_BATCH_LANES + 3); i++)
+	{
+		batchKeys[i] = key[i % 16] + (i % 16 == 0 ? i / 16 : 0);
+	}
+
+	for (i = 0; i < 8 * (HIGHT_BATCH_LANES + 3); i++)
+	{
+		batchText[i] = text[i % 8];
+	}
+
+	for (i = 0; i < HIGHT_BATCH_LANES + 3; i++)
+	{
+		HIGHT_init(&batchContexts[i], batchKeys + 16 * i);
+		batchPointers[i] = &batchContexts[i];
+	}
+
+	HIGHT_encrypt_batch(batchPointers, batchText, batchCipherText, HIGHT_BATCH_LANES + 3);
+	HIGHT_encrypt_batch_keys(batchKeys, batchText, batchKeysCipherText, HIGHT_BATCH_LANES + 3);
+
+	// the block 0 is the vector, the others are checked against HIGHT_encrypt
+	contextsOk = 1;
+	keysOk = 1;
+	for (i = 0; i < 8 * (HIGHT_BATCH_LANES + 3); i++)
+	{
+		if (i % 8 == 0)
+		{
+			HIGHT_encrypt(&batchContexts[i / 8], text, cipherText);
+		}
+
+		contextsOk &= batchCipherText[i] == cipherText[i % 8] && (i >= 8 || cipherText[i] == expectedCipherText[i]);
+		keysOk &= batchKeysCipherText[i] == cipherText[i % 8];
+	}
+
+	printf("\nHIGHT batch of %d keys \n\n", HIGHT_BATCH_LANES + 3);
+	printf("contexts: \t\t\t%s\n", contextsOk ? "ok" : "FAILED");
+	printf("raw keys: \t\t\t%s\n", keysOk ? "ok" : "FAILED");
 }
@@ -19,5 +19,10 @@ typedef struct
 void HIGHT_init(HightContext* context, uint8_t* key);
 void HIGHT_encrypt(HightContext* context, uint8_t* block, uint8_t* out);
 void HIGHT_decrypt(HightContext* context, uint8_t* block, uint8_t* out);
+void HIGHT_encrypt_blocks(HightContext* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks);
+void HIGHT_decrypt_blocks(HightContext* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks);
+
+void HIGHT_encrypt_batch(HightContext** contexts, const uint8_t* blocks, uint8_t* out, size_t nrBlocks);
+void HIGHT_encrypt_batch_keys(const uint8_t* keys, const uint8_t* blocks, uint8_t* out, size_t nrBlocks);
 
 void HIGHT_main(void);
\ No newline at end of file
@@ -0,0 +1,425 @@
+/* HIGHT_AVX2.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Byte-sliced HIGHT bulk encryption and decryption with AVX2.
+ *
+ * Thirty-two blocks are transposed while loading, so register xj holds
+ * the byte j of every block and one instruction performs a round
+ * operation on all of them. The transposition back is part of the
+ * store.
+ *
+ * The batch kernels slice the keys the same way, so each lane has
+ * its own whitening keys and subkeys. From raw keys the subkeys are
+ * the bytes of the key plus the constants, computed in the lanes.
+ *
+ */
+
+#include "HIGHT_AVX2.h"
+
+#ifdef HIGHT_AVX2
+
+#include <string.h>
+#include <immintrin.h>
+
+#define NR_ROUNDS 32
+
+// Table generated by the ConstantGeneration function of HIGHT.c
+static const uint8_t DELTA[128] = {
+	0x5a, 0x6d, 0x36, 0x1b, 0x0d, 0x06, 0x03, 0x41, 0x60, 0x30, 0x18, 0x4c, 0x66, 0x33, 0x59, 0x2c,
+	0x56, 0x2b, 0x15, 0x4a, 0x65, 0x72, 0x39, 0x1c, 0x4e, 0x67, 0x73, 0x79, 0x3c, 0x5e, 0x6f, 0x37,
+	0x5b, 0x2d, 0x16, 0x0b, 0x05, 0x42, 0x21, 0x50, 0x28, 0x54, 0x2a, 0x55, 0x6a, 0x75, 0x7a, 0x7d,
+	0x3e, 0x5f, 0x2f, 0x17, 0x4b, 0x25, 0x52, 0x29, 0x14, 0x0a, 0x45, 0x62, 0x31, 0x58, 0x6c, 0x76,
+	0x3b, 0x1d, 0x0e, 0x47, 0x63, 0x71, 0x78, 0x7c, 0x7e, 0x7f, 0x3f, 0x1f, 0x0f, 0x07, 0x43, 0x61,
+	0x70, 0x38, 0x5c, 0x6e, 0x77, 0x7b, 0x3d, 0x1e, 0x4f, 0x27, 0x53, 0x69, 0x34, 0x1a, 0x4d, 0x26,
+	0x13, 0x49, 0x24, 0x12, 0x09, 0x04, 0x02, 0x01, 0x40, 0x20, 0x10, 0x08, 0x44, 0x22, 0x11, 0x48,
+	0x64, 0x32, 0x19, 0x0c, 0x46, 0x23, 0x51, 0x68, 0x74, 0x3a, 0x5d, 0x2e, 0x57, 0x6b, 0x35, 0x5a,
+};
+
+/*
+	f0 and f1 are linear, so they are the xor of the images of the
+	low and high nibbles, looked up with byte shuffles.
+*/
+#define NIBBLE_LOOKUP(low, high, v) _mm256_xor_si256( \
+	_mm256_shuffle_epi8(low, _mm256_and_si256(v, nibbleMask)), \
+	_mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibbleMask)))
+
+#define F0(v) NIBBLE_LOOKUP(f0Low, f0High, v)
+#define F1(v) NIBBLE_LOOKUP(f1Low, f1High, v)
+
+#define TABLE(...) _mm256_broadcastsi128_si256(_mm_setr_epi8(__VA_ARGS__))
+
+#define TABLES \
+	const __m256i nibbleMask = _mm256_set1_epi8(0x0f); \
+	const __m256i f0Low = TABLE(0x00, 0x86, 0x0d, 0x8b, 0x1a, 0x9c, 0x17, 0x91, 0x34, 0xb2, 0x39, 0xbf, 0x2e, 0xa8, 0x23, 0xa5); \
+	const __m256i f0High = TABLE(0x00, 0x68, 0xd0, 0xb8, 0xa1, 0xc9, 0x71, 0x19, 0x43, 0x2b, 0x93, 0xfb, 0xe2, 0x8a, 0x32, 0x5a); \
+	const __m256i f1Low = TABLE(0x00, 0x58, 0xb0, 0xe8, 0x61, 0x39, 0xd1, 0x89, 0xc2, 0x9a, 0x72, 0x2a, 0xa3, 0xfb, 0x13, 0x4b); \
+	const __m256i f1High = TABLE(0x00, 0x85, 0x0b, 0x8e, 0x16, 0x93, 0x1d, 0x98, 0x2c, 0xa9, 0x27, 0xa2, 0x3a, 0xbf, 0x31, 0xb4)
+
+/*
+	One round on the state a0, ..., a7 in place. The new state is
+	a7, a0, a1, ..., a6, so the following round takes the names
+	rotated by one and eight rounds bring them back.
+*/
+#define ROUND(a0, a1, a2, a3, a4, a5, a6, a7, i) \
+	a1 = _mm256_add_epi8(a1, _mm256_xor_si256(F1(a0), k[i])); \
+	a3 = _mm256_xor_si256(a3, _mm256_add_epi8(F0(a2), k[(i) + 1])); \
+	a5 = _mm256_add_epi8(a5, _mm256_xor_si256(F1(a4), k[(i) + 2])); \
+	a7 = _mm256_xor_si256(a7, _mm256_add_epi8(F0(a6), k[(i) + 3]))
+
+#define INVERSE_ROUND(a0, a1, a2, a3, a4, a5, a6, a7, i) \
+	a1 = _mm256_sub_epi8(a1, _mm256_xor_si256(F1(a0), k[i])); \
+	a3 = _mm256_xor_si256(a3, _mm256_add_epi8(F0(a2), k[(i) + 1])); \
+	a5 = _mm256_sub_epi8(a5, _mm256_xor_si256(F1(a4), k[(i) + 2])); \
+	a7 = _mm256_xor_si256(a7, _mm256_add_epi8(F0(a6), k[(i) + 3]))
+
+#define ENCRYPT_8(i) \
+	ROUND(x0, x1, x2, x3, x4, x5, x6, x7, i); \
+	ROUND(x7, x0, x1, x2, x3, x4, x5, x6, (i) + 4); \
+	ROUND(x6, x7, x0, x1, x2, x3, x4, x5, (i) + 8); \
+	ROUND(x5, x6, x7, x0, x1, x2, x3, x4, (i) + 12); \
+	ROUND(x4, x5, x6, x7, x0, x1, x2, x3, (i) + 16); \
+	ROUND(x3, x4, x5, x6, x7, x0, x1, x2, (i) + 20); \
+	ROUND(x2, x3, x4, x5, x6, x7, x0, x1, (i) + 24); \
+	ROUND(x1, x2, x3, x4, x5, x6, x7, x0, (i) + 28)
+
+#define DECRYPT_8(i) \
+	INVERSE_ROUND(x1, x2, x3, x4, x5, x6, x7, x0, (i) + 28); \
+	INVERSE_ROUND(x2, x3, x4, x5, x6, x7, x0, x1, (i) + 24); \
+	INVERSE_ROUND(x3, x4, x5, x6, x7, x0, x1, x2, (i) + 20); \
+	INVERSE_ROUND(x4, x5, x6, x7, x0, x1, x2, x3, (i) + 16); \
+	INVERSE_ROUND(x5, x6, x7, x0, x1, x2, x3, x4, (i) + 12); \
+	INVERSE_ROUND(x6, x7, x0, x1, x2, x3, x4, x5, (i) + 8); \
+	INVERSE_ROUND(x7, x0, x1, x2, x3, x4, x5, x6, (i) + 4); \
+	INVERSE_ROUND(x0, x1, x2, x3, x4, x5, x6, x7, i)
+
+/*
+	Each unpack layer moves one bit of the byte position within the
+	register into the register index. Four layers turn the register
+	index into the byte j of the block, the block order within the
+	register is shuffled, which store undoes. The unpacks work inside
+	the 128 bits halves, each half transposes 16 blocks.
+*/
+static void transpose(__m256i* r, __m256i* x)
+{
+	__m256i s[8];
+	int i;
+
+	for (i = 0; i < 8; i += 2)
+	{
+		s[i] = _mm256_unpacklo_epi8(r[i], r[i + 1]);
+		s[i + 1] = _mm256_unpackhi_epi8(r[i], r[i + 1]);
+	}
+
+	for (i = 0; i < 8; i++)
+	{
+		if (i & 2)
+		{
+			continue;
+		}
+
+		r[i] = _mm256_unpacklo_epi8(s[i], s[i + 2]);
+		r[i + 2] = _mm256_unpackhi_epi8(s[i], s[i + 2]);
+	}
+
+	for (i = 0; i < 4; i++)
+	{
+		s[i] = _mm256_unpacklo_epi8(r[i], r[i + 4]);
+		s[i + 4] = _mm256_unpackhi_epi8(r[i], r[i + 4]);
+	}
+
+	for (i = 0; i < 8; i += 2)
+	{
+		r[i] = _mm256_unpacklo_epi8(s[i], s[i + 1]);
+		r[i + 1] = _mm256_unpackhi_epi8(s[i], s[i + 1]);
+	}
+
+	x[0] = r[0];
+	x[1] = r[1];
+	x[2] = r[4];
+	x[3] = r[5];
+	x[4] = r[2];
+	x[5] = r[3];
+	x[6] = r[6];
+	x[7] = r[7];
+}
+
+static void load(const uint8_t* blocks, __m256i* x)
+{
+	__m256i r[8];
+	int i;
+
+	for (i = 0; i < 8; i++)
+	{
+		r[i] = _mm256_loadu_si256((const __m256i*)blocks + i);
+	}
+
+	transpose(r, x);
+}
+
+/*
+	As load, with the 8 bytes of the block b read at words[b] + offset,
+	so the bytes of 32 keys end up in the same lanes as the blocks.
+*/
+static void gather(const uint8_t* const* words, size_t offset, __m256i* x)
+{
+	__m256i r[8];
+	int64_t w[4];
+	int i;
+	int j;
+
+	for (i = 0; i < 8; i++)
+	{
+		for (j = 0; j < 4; j++)
+		{
+			memcpy(&w[j], words[4 * i + j] + offset, 8);
+		}
+
+		r[i] = _mm256_set_epi64x(w[3], w[2], w[1], w[0]);
+	}
+
+	transpose(r, x);
+}
+
+// inverse of load, three layers followed by a renaming of the registers
+static void store(uint8_t* out, const __m256i* x)
+{
+	__m256i r[8];
+	__m256i s[8];
+	int i;
+
+	r[0] = x[0];
+	r[1] = x[1];
+	r[4] = x[2];
+	r[5] = x[3];
+	r[2] = x[4];
+	r[3] = x[5];
+	r[6] = x[6];
+	r[7] = x[7];
+
+	for (i = 0; i < 8; i++)
+	{
+		if (i & 2)
+		{
+			continue;
+		}
+
+		s[i] = _mm256_unpacklo_epi8(r[i], r[i + 2]);
+		s[i + 2] = _mm256_unpackhi_epi8(r[i], r[i + 2]);
+	}
+
+	for (i = 0; i < 4; i++)
+	{
+		r[i] = _mm256_unpacklo_epi8(s[i], s[i + 4]);
+		r[i + 4] = _mm256_unpackhi_epi8(s[i], s[i + 4]);
+	}
+
+	for (i = 0; i < 8; i += 2)
+	{
+		s[i] = _mm256_unpacklo_epi8(r[i], r[i + 1]);
+		s[i + 1] = _mm256_unpackhi_epi8(r[i], r[i + 1]);
+	}
+
+	_mm256_storeu_si256((__m256i*)out, s[0]);
+	_mm256_storeu_si256((__m256i*)out + 1, s[2]);
+	_mm256_storeu_si256((__m256i*)out + 2, s[4]);
+	_mm256_storeu_si256((__m256i*)out + 3, s[6]);
+	_mm256_storeu_si256((__m256i*)out + 4, s[1]);
+	_mm256_storeu_si256((__m256i*)out + 5, s[3]);
+	_mm256_storeu_si256((__m256i*)out + 6, s[5]);
+	_mm256_storeu_si256((__m256i*)out + 7, s[7]);
+}
+
+/*
+	Whitening and rounds on the sliced blocks x, with the keys in k
+	and wk broadcast to every lane or given one per lane.
+*/
+static void encrypt(const __m256i* k, const __m256i* wk, __m256i* x)
+{
+	TABLES;
+	__m256i x0, x1, x2, x3, x4, x5, x6, x7;
+	int i;
+
+	// Initial Transformation
+	x0 = _mm256_add_epi8(x[0], wk[0]);
+	x1 = x[1];
+	x2 = _mm256_xor_si256(x[2], wk[1]);
+	x3 = x[3];
+	x4 = _mm256_add_epi8(x[4], wk[2]);
+	x5 = x[5];
+	x6 = _mm256_xor_si256(x[6], wk[3]);
+	x7 = x[7];
+
+	// Rounds
+	for (i = 0; i < 4 * NR_ROUNDS; i += 32)
+	{
+		ENCRYPT_8(i);
+	}
+
+	// Final Transformation
+	x[0] = _mm256_add_epi8(x1, wk[4]);
+	x[1] = x2;
+	x[2] = _mm256_xor_si256(x3, wk[5]);
+	x[3] = x4;
+	x[4] = _mm256_add_epi8(x5, wk[6]);
+	x[5] = x6;
+	x[6] = _mm256_xor_si256(x7, wk[7]);
+	x[7] = x0;
+}
+
+size_t HIGHT_encrypt_blocks_avx2(const uint8_t* whiteningKeys, const uint8_t* subkeys, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	__m256i k[4 * NR_ROUNDS];
+	__m256i wk[8];
+	__m256i x[8];
+	size_t done;
+	int i;
+
+	if (nrBlocks < 32)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < 4 * NR_ROUNDS; i++)
+	{
+		k[i] = _mm256_set1_epi8((char)subkeys[i]);
+	}
+
+	for (i = 0; i < 8; i++)
+	{
+		wk[i] = _mm256_set1_epi8((char)whiteningKeys[i]);
+	}
+
+	for (done = 0; nrBlocks - done >= 32; done += 32, blocks += 256, out += 256)
+	{
+		load(blocks, x);
+		encrypt(k, wk, x);
+		store(out, x);
+	}
+
+	return done;
+}
+
+size_t HIGHT_decrypt_blocks_avx2(const uint8_t* whiteningKeys, const uint8_t* subkeys, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	TABLES;
+	__m256i k[4 * NR_ROUNDS];
+	__m256i wk[8];
+	__m256i x[8];
+	__m256i x0, x1, x2, x3, x4, x5, x6, x7;
+	size_t done;
+	int i;
+
+	if (nrBlocks < 32)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < 4 * NR_ROUNDS; i++)
+	{
+		k[i] = _mm256_set1_epi8((char)subkeys[i]);
+	}
+
+	for (i = 0; i < 8; i++)
+	{
+		wk[i] = _mm256_set1_epi8((char)whiteningKeys[i]);
+	}
+
+	for (done = 0; nrBlocks - done >= 32; done += 32, blocks += 256, out += 256)
+	{
+		load(blocks, x);
+
+		// Final Inverse Transformation
+		x7 = _mm256_xor_si256(x[6], wk[7]);
+		x6 = x[5];
+		x5 = _mm256_sub_epi8(x[4], wk[6]);
+		x4 = x[3];
+		x3 = _mm256_xor_si256(x[2], wk[5]);
+		x2 = x[1];
+		x1 = _mm256_sub_epi8(x[0], wk[4]);
+		x0 = x[7];
+
+		// Rounds
+		for (i = 4 * NR_ROUNDS - 32; i >= 0; i -= 32)
+		{
+			DECRYPT_8(i);
+		}
+
+		// Initial Inverse Transformation
+		x[0] = _mm256_sub_epi8(x0, wk[0]);
+		x[1] = x1;
+		x[2] = _mm256_xor_si256(x2, wk[1]);
+		x[3] = x3;
+		x[4] = _mm256_sub_epi8(x4, wk[2]);
+		x[5] = x5;
+		x[6] = _mm256_xor_si256(x6, wk[3]);
+		x[7] = x7;
+
+		store(out, x);
+	}
+
+	return done;
+}
+
+void HIGHT_encrypt_batch_avx2(const uint8_t* const* whiteningKeys, const uint8_t* const* subkeys, const uint8_t* blocks, uint8_t* out)
+{
+	__m256i k[4 * NR_ROUNDS];
+	__m256i wk[8];
+	__m256i x[8];
+	int i;
+
+	gather(whiteningKeys, 0, wk);
+
+	for (i = 0; i < 4 * NR_ROUNDS; i += 8)
+	{
+		gather(subkeys, i, k + i);
+	}
+
+	load(blocks, x);
+	encrypt(k, wk, x);
+	store(out, x);
+}
+
+void HIGHT_encrypt_batch_keys_avx2(const uint8_t* keys, const uint8_t* blocks, uint8_t* out)
+{
+	const uint8_t* words[HIGHT_BATCH_LANES];
+	__m256i mk[16];
+	__m256i k[4 * NR_ROUNDS];
+	__m256i wk[8];
+	__m256i x[8];
+	int index;
+	int i;
+	int j;
+
+	for (i = 0; i < HIGHT_BATCH_LANES; i++)
+	{
+		words[i] = keys + 16 * i;
+	}
+
+	gather(words, 0, mk);
+	gather(words, 8, mk + 8);
+
+	// as HIGHT_init, on the byte j of the 32 keys at once
+	for (i = 0; i < 4; i++)
+	{
+		wk[i] = mk[i + 12];
+		wk[i + 4] = mk[i];
+	}
+
+	for (i = 0; i < 8; i++)
+	{
+		for (j = 0; j < 8; j++)
+		{
+			index = (j - i + 8) & 0x7;
+			k[16 * i + j] = _mm256_add_epi8(mk[index], _mm256_set1_epi8((char)DELTA[16 * i + j]));
+			k[16 * i + j + 8] = _mm256_add_epi8(mk[index + 8], _mm256_set1_epi8((char)DELTA[16 * i + j + 8]));
+		}
+	}
+
+	load(blocks, x);
+	encrypt(k, wk, x);
+	store(out, x);
+}
+
+#endif
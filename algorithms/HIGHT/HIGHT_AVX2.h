@@ -0,0 +1,38 @@
+/* HIGHT_AVX2.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Byte-sliced HIGHT bulk and batch kernels with AVX2, used by the
+ * bulk and batch functions of HIGHT.c when the CPU supports it.
+ * Must be compiled with AVX2 enabled.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// blocks of a batch kernel, each one under its own key
+#define HIGHT_BATCH_LANES 32
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define HIGHT_AVX2
+#endif
+
+/*
+	Process the largest multiple of 32 blocks of nrBlocks and return
+	how many blocks were processed, the caller handles the rest.
+*/
+size_t HIGHT_encrypt_blocks_avx2(const uint8_t* whiteningKeys, const uint8_t* subkeys, const uint8_t* blocks, uint8_t* out, size_t nrBlocks);
+size_t HIGHT_decrypt_blocks_avx2(const uint8_t* whiteningKeys, const uint8_t* subkeys, const uint8_t* blocks, uint8_t* out, size_t nrBlocks);
+
+/*
+	Encrypt HIGHT_BATCH_LANES blocks, the block b under the key b,
+	whose 8 whitening keys and 128 subkeys are whiteningKeys[b] and
+	subkeys[b]. The keys variant runs the key schedule in the lanes,
+	the key b is keys[16 * b] to keys[16 * b + 15].
+*/
+void HIGHT_encrypt_batch_avx2(const uint8_t* const* whiteningKeys, const uint8_t* const* subkeys, const uint8_t* blocks, uint8_t* out);
+void HIGHT_encrypt_batch_keys_avx2(const uint8_t* keys, const uint8_t* blocks, uint8_t* out);
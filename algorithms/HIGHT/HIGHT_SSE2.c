@@ -0,0 +1,293 @@
+/* HIGHT_SSE2.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Byte-sliced HIGHT bulk encryption and decryption with SSE2.
+ *
+ * Sixteen blocks are transposed while loading, so register xj holds
+ * the byte j of every block and one instruction performs a round
+ * operation on all of them. The transposition back is part of the
+ * store.
+ *
+ */
+
+#include "HIGHT_SSE2.h"
+
+#ifdef HIGHT_SSE2
+
+#include <emmintrin.h>
+
+#define NR_ROUNDS 32
+
+// SSE2 has no 8 bits shifts, the bits crossing bytes are masked out
+#define ROL(v, n) _mm_or_si128( \
+	_mm_and_si128(_mm_slli_epi16(v, n), _mm_set1_epi8((char)(0xff << (n)))), \
+	_mm_and_si128(_mm_srli_epi16(v, 8 - (n)), _mm_set1_epi8((char)(0xff >> (8 - (n))))))
+
+#define F0(v) _mm_xor_si128(_mm_xor_si128(ROL(v, 1), ROL(v, 2)), ROL(v, 7))
+#define F1(v) _mm_xor_si128(_mm_xor_si128(ROL(v, 3), ROL(v, 4)), ROL(v, 6))
+
+/*
+	One round on the state a0, ..., a7 in place. The new state is
+	a7, a0, a1, ..., a6, so the following round takes the names
+	rotated by one and eight rounds bring them back.
+*/
+#define ROUND(a0, a1, a2, a3, a4, a5, a6, a7, i) \
+	a1 = _mm_add_epi8(a1, _mm_xor_si128(F1(a0), k[i])); \
+	a3 = _mm_xor_si128(a3, _mm_add_epi8(F0(a2), k[(i) + 1])); \
+	a5 = _mm_add_epi8(a5, _mm_xor_si128(F1(a4), k[(i) + 2])); \
+	a7 = _mm_xor_si128(a7, _mm_add_epi8(F0(a6), k[(i) + 3]))
+
+#define INVERSE_ROUND(a0, a1, a2, a3, a4, a5, a6, a7, i) \
+	a1 = _mm_sub_epi8(a1, _mm_xor_si128(F1(a0), k[i])); \
+	a3 = _mm_xor_si128(a3, _mm_add_epi8(F0(a2), k[(i) + 1])); \
+	a5 = _mm_sub_epi8(a5, _mm_xor_si128(F1(a4), k[(i) + 2])); \
+	a7 = _mm_xor_si128(a7, _mm_add_epi8(F0(a6), k[(i) + 3]))
+
+#define ENCRYPT_8(i) \
+	ROUND(x0, x1, x2, x3, x4, x5, x6, x7, i); \
+	ROUND(x7, x0, x1, x2, x3, x4, x5, x6, (i) + 4); \
+	ROUND(x6, x7, x0, x1, x2, x3, x4, x5, (i) + 8); \
+	ROUND(x5, x6, x7, x0, x1, x2, x3, x4, (i) + 12); \
+	ROUND(x4, x5, x6, x7, x0, x1, x2, x3, (i) + 16); \
+	ROUND(x3, x4, x5, x6, x7, x0, x1, x2, (i) + 20); \
+	ROUND(x2, x3, x4, x5, x6, x7, x0, x1, (i) + 24); \
+	ROUND(x1, x2, x3, x4, x5, x6, x7, x0, (i) + 28)
+
+#define DECRYPT_8(i) \
+	INVERSE_ROUND(x1, x2, x3, x4, x5, x6, x7, x0, (i) + 28); \
+	INVERSE_ROUND(x2, x3, x4, x5, x6, x7, x0, x1, (i) + 24); \
+	INVERSE_ROUND(x3, x4, x5, x6, x7, x0, x1, x2, (i) + 20); \
+	INVERSE_ROUND(x4, x5, x6, x7, x0, x1, x2, x3, (i) + 16); \
+	INVERSE_ROUND(x5, x6, x7, x0, x1, x2, x3, x4, (i) + 12); \
+	INVERSE_ROUND(x6, x7, x0, x1, x2, x3, x4, x5, (i) + 8); \
+	INVERSE_ROUND(x7, x0, x1, x2, x3, x4, x5, x6, (i) + 4); \
+	INVERSE_ROUND(x0, x1, x2, x3, x4, x5, x6, x7, i)
+
+/*
+	Each unpack layer moves one bit of the byte position within the
+	register into the register index. Four layers turn the register
+	index into the byte j of the block, the block order within the
+	register is shuffled, which store undoes.
+*/
+static void load(const uint8_t* blocks, __m128i* x)
+{
+	__m128i r[8];
+	__m128i s[8];
+	int i;
+
+	for (i = 0; i < 8; i++)
+	{
+		r[i] = _mm_loadu_si128((const __m128i*)blocks + i);
+	}
+
+	for (i = 0; i < 8; i += 2)
+	{
+		s[i] = _mm_unpacklo_epi8(r[i], r[i + 1]);
+		s[i + 1] = _mm_unpackhi_epi8(r[i], r[i + 1]);
+	}
+
+	for (i = 0; i < 8; i++)
+	{
+		if (i & 2)
+		{
+			continue;
+		}
+
+		r[i] = _mm_unpacklo_epi8(s[i], s[i + 2]);
+		r[i + 2] = _mm_unpackhi_epi8(s[i], s[i + 2]);
+	}
+
+	for (i = 0; i < 4; i++)
+	{
+		s[i] = _mm_unpacklo_epi8(r[i], r[i + 4]);
+		s[i + 4] = _mm_unpackhi_epi8(r[i], r[i + 4]);
+	}
+
+	for (i = 0; i < 8; i += 2)
+	{
+		r[i] = _mm_unpacklo_epi8(s[i], s[i + 1]);
+		r[i + 1] = _mm_unpackhi_epi8(s[i], s[i + 1]);
+	}
+
+	x[0] = r[0];
+	x[1] = r[1];
+	x[2] = r[4];
+	x[3] = r[5];
+	x[4] = r[2];
+	x[5] = r[3];
+	x[6] = r[6];
+	x[7] = r[7];
+}
+
+// inverse of load, three layers followed by a renaming of the registers
+static void store(uint8_t* out, const __m128i* x)
+{
+	__m128i r[8];
+	__m128i s[8];
+	int i;
+
+	r[0] = x[0];
+	r[1] = x[1];
+	r[4] = x[2];
+	r[5] = x[3];
+	r[2] = x[4];
+	r[3] = x[5];
+	r[6] = x[6];
+	r[7] = x[7];
+
+	for (i = 0; i < 8; i++)
+	{
+		if (i & 2)
+		{
+			continue;
+		}
+
+		s[i] = _mm_unpacklo_epi8(r[i], r[i + 2]);
+		s[i + 2] = _mm_unpackhi_epi8(r[i], r[i + 2]);
+	}
+
+	for (i = 0; i < 4; i++)
+	{
+		r[i] = _mm_unpacklo_epi8(s[i], s[i + 4]);
+		r[i + 4] = _mm_unpackhi_epi8(s[i], s[i + 4]);
+	}
+
+	for (i = 0; i < 8; i += 2)
+	{
+		s[i] = _mm_unpacklo_epi8(r[i], r[i + 1]);
+		s[i + 1] = _mm_unpackhi_epi8(r[i], r[i + 1]);
+	}
+
+	_mm_storeu_si128((__m128i*)out, s[0]);
+	_mm_storeu_si128((__m128i*)out + 1, s[2]);
+	_mm_storeu_si128((__m128i*)out + 2, s[4]);
+	_mm_storeu_si128((__m128i*)out + 3, s[6]);
+	_mm_storeu_si128((__m128i*)out + 4, s[1]);
+	_mm_storeu_si128((__m128i*)out + 5, s[3]);
+	_mm_storeu_si128((__m128i*)out + 6, s[5]);
+	_mm_storeu_si128((__m128i*)out + 7, s[7]);
+}
+
+size_t HIGHT_encrypt_blocks_sse2(const uint8_t* whiteningKeys, const uint8_t* subkeys, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	__m128i k[4 * NR_ROUNDS];
+	__m128i wk[8];
+	__m128i x[8];
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7;
+	size_t done;
+	int i;
+
+	if (nrBlocks < 16)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < 4 * NR_ROUNDS; i++)
+	{
+		k[i] = _mm_set1_epi8((char)subkeys[i]);
+	}
+
+	for (i = 0; i < 8; i++)
+	{
+		wk[i] = _mm_set1_epi8((char)whiteningKeys[i]);
+	}
+
+	for (done = 0; nrBlocks - done >= 16; done += 16, blocks += 128, out += 128)
+	{
+		load(blocks, x);
+
+		// Initial Transformation
+		x0 = _mm_add_epi8(x[0], wk[0]);
+		x1 = x[1];
+		x2 = _mm_xor_si128(x[2], wk[1]);
+		x3 = x[3];
+		x4 = _mm_add_epi8(x[4], wk[2]);
+		x5 = x[5];
+		x6 = _mm_xor_si128(x[6], wk[3]);
+		x7 = x[7];
+
+		// Rounds
+		for (i = 0; i < 4 * NR_ROUNDS; i += 32)
+		{
+			ENCRYPT_8(i);
+		}
+
+		// Final Transformation
+		x[0] = _mm_add_epi8(x1, wk[4]);
+		x[1] = x2;
+		x[2] = _mm_xor_si128(x3, wk[5]);
+		x[3] = x4;
+		x[4] = _mm_add_epi8(x5, wk[6]);
+		x[5] = x6;
+		x[6] = _mm_xor_si128(x7, wk[7]);
+		x[7] = x0;
+
+		store(out, x);
+	}
+
+	return done;
+}
+
+size_t HIGHT_decrypt_blocks_sse2(const uint8_t* whiteningKeys, const uint8_t* subkeys, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	__m128i k[4 * NR_ROUNDS];
+	__m128i wk[8];
+	__m128i x[8];
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7;
+	size_t done;
+	int i;
+
+	if (nrBlocks < 16)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < 4 * NR_ROUNDS; i++)
+	{
+		k[i] = _mm_set1_epi8((char)subkeys[i]);
+	}
+
+	for (i = 0; i < 8; i++)
+	{
+		wk[i] = _mm_set1_epi8((char)whiteningKeys[i]);
+	}
+
+	for (done = 0; nrBlocks - done >= 16; done += 16, blocks += 128, out += 128)
+	{
+		load(blocks, x);
+
+		// Final Inverse Transformation
+		x7 = _mm_xor_si128(x[6], wk[7]);
+		x6 = x[5];
+		x5 = _mm_sub_epi8(x[4], wk[6]);
+		x4 = x[3];
+		x3 = _mm_xor_si128(x[2], wk[5]);
+		x2 = x[1];
+		x1 = _mm_sub_epi8(x[0], wk[4]);
+		x0 = x[7];
+
+		// Rounds
+		for (i = 4 * NR_ROUNDS - 32; i >= 0; i -= 32)
+		{
+			DECRYPT_8(i);
+		}
+
+		// Initial Inverse Transformation
+		x[0] = _mm_sub_epi8(x0, wk[0]);
+		x[1] = x1;
+		x[2] = _mm_xor_si128(x2, wk[1]);
+		x[3] = x3;
+		x[4] = _mm_sub_epi8(x4, wk[2]);
+		x[5] = x5;
+		x[6] = _mm_xor_si128(x6, wk[3]);
+		x[7] = x7;
+
+		store(out, x);
+	}
+
+	return done;
+}
+
+#endif
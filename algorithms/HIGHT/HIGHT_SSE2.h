@@ -0,0 +1,26 @@
+/* HIGHT_SSE2.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Byte-sliced HIGHT bulk kernels with SSE2, used by the bulk
+ * functions of HIGHT.c when the CPU supports it. Must be compiled
+ * with SSE2 enabled.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define HIGHT_SSE2
+#endif
+
+/*
+	Process the largest multiple of 16 blocks of nrBlocks and return
+	how many blocks were processed, the caller handles the rest.
+*/
+size_t HIGHT_encrypt_blocks_sse2(const uint8_t* whiteningKeys, const uint8_t* subkeys, const uint8_t* blocks, uint8_t* out, size_t nrBlocks);
+size_t HIGHT_decrypt_blocks_sse2(const uint8_t* whiteningKeys, const uint8_t* subkeys, const uint8_t* blocks, uint8_t* out, size_t nrBlocks);
@@ -16,10 +16,36 @@
  */
 
 #include "IDEA.h"
+#include "IDEA_SSE2.h"
+#include "IDEA_AVX2.h"
+#include "../../cpu/CPU.h"
+#include "../../threads/THREADPOOL.h"
 
 #define NR_ROUNDS 8
 #define ENCRYPTION_KEY_LEN 6 * NR_ROUNDS + 4 // 52 subkeys
 
+/*
+	The first decryption derives the decryption keys, possibly in
+	several threads at once, so decryptionKeysState is only accessed
+	with atomic operations.
+*/
+#ifdef _MSC_VER
+#include <intrin.h>
+// volatile accesses have acquire and release semantics with /volatile:ms, the default
+#define ATOMIC_LOAD(x) (*(volatile unsigned*)&(x))
+#define ATOMIC_STORE(x, v) _InterlockedExchange((volatile long*)&(x), (long)(v))
+#define ATOMIC_CLAIM(x, from, to) (_InterlockedCompareExchange((volatile long*)&(x), (long)(to), (long)(from)) == (long)(from))
+#else
+#define ATOMIC_LOAD(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#define ATOMIC_CLAIM(x, from, to) __sync_bool_compare_and_swap(&(x), (from), (to))
+#endif
+
+// values of decryptionKeysState
+#define KEYS_NONE 0
+#define KEYS_BUSY 1
+#define KEYS_READY 2
+
 static uint16_t mul(uint16_t a, uint16_t b)
 {
 	long p;
@@ -99,6 +125,34 @@ static void generateEncryptionKeys(uint16_t* key, uint16_t Z[52])
 	}
 }
 
+/*
+	Montgomery's trick: the inverses of the n values come from the
+	inverse of their product, one Euclidean inversion and 3 (n - 1)
+	multiplications instead of n inversions. mul works in the same
+	group as inv, 0 standing for 2^16, so no value is left out.
+*/
+static void invertAll(const uint16_t* x, uint16_t* y, int n)
+{
+	uint16_t products[2 * NR_ROUNDS + 2];
+	uint16_t inverse;
+	int i;
+
+	products[0] = x[0];
+	for (i = 1; i < n; i++)
+	{
+		products[i] = mul(products[i - 1], x[i]);
+	}
+
+	// inverse of x[0] * ... * x[i] for i going down
+	inverse = inv(products[n - 1]);
+	for (i = n - 1; i > 0; i--)
+	{
+		y[i] = mul(inverse, products[i - 1]);
+		inverse = mul(inverse, x[i]);
+	}
+	y[0] = inverse;
+}
+
 static void generateDecryptionKeys(uint16_t* key, uint16_t Z[52])
 {
 	int i;
@@ -106,13 +160,27 @@ static void generateDecryptionKeys(uint16_t* key, uint16_t Z[52])
 	uint16_t temp[ENCRYPTION_KEY_LEN];
 	uint16_t* p = temp + ENCRYPTION_KEY_LEN;
 
-	t1 = inv(*key++);
-	t2 = -*key++;
-	t3 = -*key++;
-	*--p = inv(*key++);
+	// the two multiplicative subkeys of every round, inverted together
+	uint16_t multipliers[2 * NR_ROUNDS + 2];
+	uint16_t inverses[2 * NR_ROUNDS + 2];
+	uint16_t* q = inverses;
+
+	for (i = 0; i <= NR_ROUNDS; i++)
+	{
+		multipliers[2 * i] = key[6 * i];
+		multipliers[2 * i + 1] = key[6 * i + 3];
+	}
+
+	invertAll(multipliers, inverses, 2 * NR_ROUNDS + 2);
+
+	t1 = *q++;
+	t2 = -key[1];
+	t3 = -key[2];
+	*--p = *q++;
 	*--p = t3;
 	*--p = t2;
 	*--p = t1;
+	key += 4;
 
 	for (i = 0; i < NR_ROUNDS - 1; i++)
 	{
@@ -120,22 +188,23 @@ static void generateDecryptionKeys(uint16_t* key, uint16_t Z[52])
 		*--p = *key++;
 		*--p = t1;
 
-		t1 = inv(*key++);
-		t2 = -*key++;
-		t3 = -*key++;
-		*--p = inv(*key++);
+		t1 = *q++;
+		t2 = -key[1];
+		t3 = -key[2];
+		*--p = *q++;
 		*--p = t2;
 		*--p = t3;
 		*--p = t1;
+		key += 4;
 	}
 	t1 = *key++;
 	*--p = *key++;
 	*--p = t1;
 
-	t1 = inv(*key++);
-	t2 = -*key++;
-	t3 = -*key++;
-	*--p = inv(*key++);
+	t1 = *q++;
+	t2 = -key[1];
+	t3 = -key[2];
+	*--p = *q++;
 	*--p = t3;
 	*--p = t2;
 	*--p = t1;
@@ -183,10 +252,131 @@ static void idea(uint16_t* block, uint16_t* Z, uint16_t* out)
 	out[3] = mul(*Z++, x3);
 }
 
+/*
+	The SIMD kernels take 16 (AVX2) and then 8 (SSE2) blocks at a
+	time. In the portable code two blocks are interleaved through the
+	same subkeys, the multiplications of one block can execute while
+	the other waits on its results.
+*/
+static void idea_blocks(const uint16_t* blocks, const uint16_t* Z, uint16_t* out, size_t nrBlocks)
+{
+	uint16_t i;
+	const uint16_t* k;
+	uint16_t a0, b0, x0, x1, x2, x3;
+	uint16_t a1, b1, y0, y1, y2, y3;
+	size_t done;
+
+#ifdef IDEA_AVX2
+	if (CPU_has(CPU_AVX2))
+	{
+		done = IDEA_blocks_avx2(Z, blocks, out, nrBlocks);
+		nrBlocks -= done;
+		blocks += 4 * done;
+		out += 4 * done;
+	}
+#endif
+
+#ifdef IDEA_SSE2
+	if (CPU_has(CPU_SSE2))
+	{
+		done = IDEA_blocks_sse2(Z, blocks, out, nrBlocks);
+		nrBlocks -= done;
+		blocks += 4 * done;
+		out += 4 * done;
+	}
+#endif
+
+	for (; nrBlocks >= 2; nrBlocks -= 2, blocks += 8, out += 8)
+	{
+		x0 = blocks[0]; x1 = blocks[1]; x2 = blocks[2]; x3 = blocks[3];
+		y0 = blocks[4]; y1 = blocks[5]; y2 = blocks[6]; y3 = blocks[7];
+		k = Z;
+
+		// round phase
+		for (i = 1; i <= NR_ROUNDS; i++, k += 6)
+		{
+			// confusion / group operations
+			x0 = mul(k[0], x0);
+			y0 = mul(k[0], y0);
+			x1 += k[1];
+			y1 += k[1];
+			x2 += k[2];
+			y2 += k[2];
+			x3 = mul(k[3], x3);
+			y3 = mul(k[3], y3);
+
+			// diffusion / MA (multiplication-addition) structure
+			b0 = mul(k[4], x0 ^ x2);
+			b1 = mul(k[4], y0 ^ y2);
+			a0 = mul(k[5], b0 + (x1 ^ x3));
+			a1 = mul(k[5], b1 + (y1 ^ y3));
+			b0 += a0;
+			b1 += a1;
+
+			// involuntary permutation
+			x0 = a0 ^ x0;
+			x3 = b0 ^ x3;
+			b0 ^= x1;
+			x1 = a0 ^ x2;
+			x2 = b0;
+
+			y0 = a1 ^ y0;
+			y3 = b1 ^ y3;
+			b1 ^= y1;
+			y1 = a1 ^ y2;
+			y2 = b1;
+		}
+
+		// output transformation
+		out[0] = mul(k[0], x0);
+		out[1] = k[1] + x2;
+		out[2] = k[2] + x1;
+		out[3] = mul(k[3], x3);
+		out[4] = mul(k[0], y0);
+		out[5] = k[1] + y2;
+		out[6] = k[2] + y1;
+		out[7] = mul(k[3], y3);
+	}
+
+	if (nrBlocks > 0)
+	{
+		idea((uint16_t*)blocks, (uint16_t*)Z, out);
+	}
+}
+
+/*
+	Decryption keys of the context. The first caller to claim them
+	(KEYS_NONE to KEYS_BUSY) derives them into the context and
+	publishes them with a release store of KEYS_READY, which the
+	later callers see with an acquire load. Callers that come while
+	they are being derived get their own copy in scratch instead of
+	waiting.
+*/
+static uint16_t* decryptionKeys(IdeaContext* context, uint16_t* scratch)
+{
+	if (ATOMIC_LOAD(context->decryptionKeysState) == KEYS_READY)
+	{
+		return context->decryptionKeys;
+	}
+
+	if (ATOMIC_CLAIM(context->decryptionKeysState, KEYS_NONE, KEYS_BUSY))
+	{
+		generateDecryptionKeys(context->encryptionKeys, context->decryptionKeys);
+		ATOMIC_STORE(context->decryptionKeysState, KEYS_READY);
+
+		return context->decryptionKeys;
+	}
+
+	generateDecryptionKeys(context->encryptionKeys, scratch);
+
+	return scratch;
+}
+
+// the decryption keys are left to the first decryption, initialize before sharing the context
 void IDEA_init(IdeaContext* context, uint16_t* key)
 {
 	generateEncryptionKeys(key, context->encryptionKeys);
-	generateDecryptionKeys(context->encryptionKeys, context->decryptionKeys);
+	context->decryptionKeysState = KEYS_NONE;
 }
 
 void IDEA_encrypt(IdeaContext* context, uint16_t* block, uint16_t* out)
@@ -196,7 +386,165 @@ void IDEA_encrypt(IdeaContext* context, uint16_t* block, uint16_t* out)
 
 void IDEA_decrypt(IdeaContext* context, uint16_t* encryptedBlock, uint16_t* out)
 {
-	idea(encryptedBlock, context->decryptionKeys, out);
+	uint16_t scratch[ENCRYPTION_KEY_LEN];
+
+	idea(encryptedBlock, decryptionKeys(context, scratch), out);
+}
+
+void IDEA_encrypt_blocks(IdeaContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks)
+{
+	idea_blocks(blocks, context->encryptionKeys, out, nrBlocks);
+}
+
+void IDEA_decrypt_blocks(IdeaContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks)
+{
+	uint16_t scratch[ENCRYPTION_KEY_LEN];
+
+	idea_blocks(blocks, decryptionKeys(context, scratch), out, nrBlocks);
+}
+
+/*
+	Encrypt-only contexts, half the size of IdeaContext, for the modes
+	that never decrypt. Decryption stays possible but derives the
+	decryption keys on the stack at every call, which costs a few
+	blocks, and never writes the context. IdeaContext derives them once.
+*/
+void IDEA_enc_init(IdeaEncContext* context, uint16_t* key)
+{
+	generateEncryptionKeys(key, context->encryptionKeys);
+}
+
+void IDEA_enc_encrypt(IdeaEncContext* context, uint16_t* block, uint16_t* out)
+{
+	idea(block, context->encryptionKeys, out);
+}
+
+void IDEA_enc_decrypt(IdeaEncContext* context, uint16_t* encryptedBlock, uint16_t* out)
+{
+	uint16_t decryptionKeys[ENCRYPTION_KEY_LEN];
+
+	generateDecryptionKeys(context->encryptionKeys, decryptionKeys);
+	idea(encryptedBlock, decryptionKeys, out);
+}
+
+void IDEA_enc_encrypt_blocks(IdeaEncContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks)
+{
+	idea_blocks(blocks, context->encryptionKeys, out, nrBlocks);
+}
+
+void IDEA_enc_decrypt_blocks(IdeaEncContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks)
+{
+	uint16_t decryptionKeys[ENCRYPTION_KEY_LEN];
+
+	generateDecryptionKeys(context->encryptionKeys, decryptionKeys);
+	idea_blocks(blocks, decryptionKeys, out, nrBlocks);
+}
+
+/*
+	Self check of the encrypt-only context on the test vector, through
+	the single block and the bulk functions.
+*/
+static int encCheck(uint16_t* key, uint16_t* text, const uint16_t* expectedCipherText)
+{
+	IdeaEncContext context;
+	uint16_t cipherText[4];
+	uint16_t blocksCipherText[4];
+	uint16_t decryptedText[4];
+	int ok = 1;
+	int i;
+
+	IDEA_enc_init(&context, key);
+	IDEA_enc_encrypt(&context, text, cipherText);
+	IDEA_enc_encrypt_blocks(&context, text, blocksCipherText, 1);
+	IDEA_enc_decrypt(&context, cipherText, decryptedText);
+
+	for (i = 0; i < 4; i++)
+	{
+		ok &= cipherText[i] == expectedCipherText[i] && blocksCipherText[i] == expectedCipherText[i]
+			&& decryptedText[i] == text[i];
+	}
+
+	return ok;
+}
+
+// threads of the shared context check and number of contexts they start with
+#define SHARED_THREADS 8
+#define SHARED_CONTEXTS 64
+
+typedef struct
+{
+	IdeaContext* context;
+	const uint16_t* text;
+	const uint16_t* cipherText;
+	int* failures;
+} IdeaSharedTest;
+
+// the odd tasks decrypt with the bulk function, the even ones block by block
+static void sharedDecryptTask(void* argument, size_t index)
+{
+	IdeaSharedTest* test = (IdeaSharedTest*)argument;
+	uint16_t cipherText[4];
+	uint16_t decryptedText[4];
+
+	memcpy(cipherText, test->cipherText, sizeof(cipherText));
+
+	if (index & 1)
+	{
+		IDEA_decrypt_blocks(test->context, cipherText, decryptedText, 1);
+	}
+	else
+	{
+		IDEA_decrypt(test->context, cipherText, decryptedText);
+	}
+
+	if (memcmp(decryptedText, test->text, sizeof(decryptedText)) != 0)
+	{
+		test->failures[index]++;
+	}
+}
+
+/*
+	Self check of the lazy decryption keys under contention: a pool
+	decrypts the test vector through each new context from all of its
+	threads at once, before anything else has decrypted with it.
+*/
+static int sharedCheck(uint16_t* key, const uint16_t* text, const uint16_t* cipherText)
+{
+	ThreadPool* pool = THREADPOOL_create(SHARED_THREADS);
+	IdeaContext context;
+	IdeaSharedTest test;
+	int failures[SHARED_THREADS];
+	int ok = 1;
+	int i;
+
+	if (pool == NULL)
+	{
+		return 0;
+	}
+
+	memset(failures, 0, sizeof(failures));
+	test.context = &context;
+	test.text = text;
+	test.cipherText = cipherText;
+	test.failures = failures;
+
+	for (i = 0; i < SHARED_CONTEXTS; i++)
+	{
+		IDEA_init(&context, key);
+		THREADPOOL_run(pool, sharedDecryptTask, &test, SHARED_THREADS);
+
+		// published by one of the threads, the others had their own copy
+		ok &= context.decryptionKeysState == KEYS_READY;
+	}
+
+	for (i = 0; i < SHARED_THREADS; i++)
+	{
+		ok &= failures[i] == 0;
+	}
+
+	THREADPOOL_destroy(pool);
+
+	return ok;
 }
 
 void IDEA_main(void)
@@ -267,4 +615,10 @@ void IDEA_main(void)
 		printf("%08x ", decryptedText[i]);
 	}
 	printf("\n");
-}
\ No newline at end of file
+
+	// same vector with the encryption keys only
+	printf("encrypt-only context: \t\t%s\n", encCheck(key, text, expectedCipherText) ? "ok" : "FAILED");
+
+	// same vector from 8 threads sharing each context since before its first decryption
+	printf("shared on first use: \t\t%s\n", sharedCheck(key, text, expectedCipherText) ? "ok" : "FAILED");
+}
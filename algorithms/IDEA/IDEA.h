@@ -14,11 +14,27 @@
 typedef struct
 {
 	uint16_t encryptionKeys[52];
+	// derived from encryptionKeys by the first decryption, decryptionKeysState tells when they are there
+	uint32_t decryptionKeysState;
 	uint16_t decryptionKeys[52];
 } IdeaContext;
 
+// encryption keys only, for the modes that never decrypt
+typedef struct
+{
+	uint16_t encryptionKeys[52];
+} IdeaEncContext;
+
 void IDEA_init(IdeaContext* context, uint16_t* key);
 void IDEA_encrypt(IdeaContext* context, uint16_t* block, uint16_t* out);
 void IDEA_decrypt(IdeaContext* context, uint16_t* encryptedBlock, uint16_t* out);
+void IDEA_encrypt_blocks(IdeaContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks);
+void IDEA_decrypt_blocks(IdeaContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks);
+
+void IDEA_enc_init(IdeaEncContext* context, uint16_t* key);
+void IDEA_enc_encrypt(IdeaEncContext* context, uint16_t* block, uint16_t* out);
+void IDEA_enc_decrypt(IdeaEncContext* context, uint16_t* encryptedBlock, uint16_t* out);
+void IDEA_enc_encrypt_blocks(IdeaEncContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks);
+void IDEA_enc_decrypt_blocks(IdeaEncContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks);
 
 void IDEA_main(void);
\ No newline at end of file
@@ -0,0 +1,129 @@
+/* IDEA_AVX2.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * IDEA bulk encryption and decryption with AVX2.
+ *
+ * Sixteen blocks are transposed so that a register holds the same
+ * 16 bits word of every block, then each round works on all of them
+ * at once. The multiplication modulo 65537 is pmullw/pmulhuw
+ * followed by a branch-free correction.
+ *
+ */
+
+#include "IDEA_AVX2.h"
+
+#ifdef IDEA_AVX2
+
+#include <immintrin.h>
+
+#define NR_ROUNDS 8
+
+/*
+	a * b mod 65537 with 0 standing for 65536. For nonzero operands
+	the product is lo - hi, plus 1 when lo < hi. The product is zero
+	only when an operand is zero, the result is then 1 - a - b.
+*/
+static __m256i mul(__m256i a, __m256i b)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i one = _mm256_set1_epi16(1);
+	__m256i lo = _mm256_mullo_epi16(a, b);
+	__m256i hi = _mm256_mulhi_epu16(a, b);
+	// all ones where hi <= lo
+	__m256i noBorrow = _mm256_cmpeq_epi16(_mm256_subs_epu16(hi, lo), zero);
+	__m256i isZero = _mm256_cmpeq_epi16(_mm256_or_si256(lo, hi), zero);
+	__m256i p = _mm256_add_epi16(_mm256_add_epi16(_mm256_sub_epi16(lo, hi), one), noBorrow);
+	__m256i z = _mm256_sub_epi16(_mm256_sub_epi16(one, a), b);
+
+	return _mm256_or_si256(_mm256_and_si256(isZero, z), _mm256_andnot_si256(isZero, p));
+}
+
+size_t IDEA_blocks_avx2(const uint16_t* Z, const uint16_t* blocks, uint16_t* out, size_t nrBlocks)
+{
+	__m256i k[52];
+	__m256i r0, r1, r2, r3;
+	__m256i t0, t1, t2, t3;
+	__m256i x0, x1, x2, x3;
+	__m256i a, b;
+	size_t done;
+	int i;
+
+	if (nrBlocks < 16)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < 52; i++)
+	{
+		k[i] = _mm256_set1_epi16((short)Z[i]);
+	}
+
+	for (done = 0; nrBlocks - done >= 16; done += 16, blocks += 64, out += 64)
+	{
+		r0 = _mm256_loadu_si256((const __m256i*)blocks);
+		r1 = _mm256_loadu_si256((const __m256i*)blocks + 1);
+		r2 = _mm256_loadu_si256((const __m256i*)blocks + 2);
+		r3 = _mm256_loadu_si256((const __m256i*)blocks + 3);
+
+		/*
+			Word j of the sixteen blocks into xj. The unpacks work
+			inside the 128 bits halves, so the blocks are in a
+			shuffled order that the store undoes.
+		*/
+		t0 = _mm256_unpacklo_epi16(r0, r1);
+		t1 = _mm256_unpackhi_epi16(r0, r1);
+		t2 = _mm256_unpacklo_epi16(r2, r3);
+		t3 = _mm256_unpackhi_epi16(r2, r3);
+		r0 = _mm256_unpacklo_epi16(t0, t1);
+		r1 = _mm256_unpackhi_epi16(t0, t1);
+		r2 = _mm256_unpacklo_epi16(t2, t3);
+		r3 = _mm256_unpackhi_epi16(t2, t3);
+		x0 = _mm256_unpacklo_epi64(r0, r2);
+		x1 = _mm256_unpackhi_epi64(r0, r2);
+		x2 = _mm256_unpacklo_epi64(r1, r3);
+		x3 = _mm256_unpackhi_epi64(r1, r3);
+
+		for (i = 0; i < 6 * NR_ROUNDS; i += 6)
+		{
+			// confusion / group operations
+			x0 = mul(k[i], x0);
+			x1 = _mm256_add_epi16(x1, k[i + 1]);
+			x2 = _mm256_add_epi16(x2, k[i + 2]);
+			x3 = mul(k[i + 3], x3);
+
+			// diffusion / MA (multiplication-addition) structure
+			b = mul(k[i + 4], _mm256_xor_si256(x0, x2));
+			a = mul(k[i + 5], _mm256_add_epi16(b, _mm256_xor_si256(x1, x3)));
+			b = _mm256_add_epi16(b, a);
+
+			// involuntary permutation
+			x0 = _mm256_xor_si256(x0, a);
+			x3 = _mm256_xor_si256(x3, b);
+			b = _mm256_xor_si256(b, x1);
+			x1 = _mm256_xor_si256(x2, a);
+			x2 = b;
+		}
+
+		// output transformation, the middle words swap back
+		x0 = mul(k[48], x0);
+		t1 = _mm256_add_epi16(k[49], x2);
+		t2 = _mm256_add_epi16(k[50], x1);
+		x3 = mul(k[51], x3);
+
+		// back to the block order
+		t0 = _mm256_unpacklo_epi16(x0, t1);
+		t1 = _mm256_unpackhi_epi16(x0, t1);
+		t3 = _mm256_unpackhi_epi16(t2, x3);
+		t2 = _mm256_unpacklo_epi16(t2, x3);
+		_mm256_storeu_si256((__m256i*)out, _mm256_unpacklo_epi32(t0, t2));
+		_mm256_storeu_si256((__m256i*)out + 1, _mm256_unpackhi_epi32(t0, t2));
+		_mm256_storeu_si256((__m256i*)out + 2, _mm256_unpacklo_epi32(t1, t3));
+		_mm256_storeu_si256((__m256i*)out + 3, _mm256_unpackhi_epi32(t1, t3));
+	}
+
+	return done;
+}
+
+#endif
@@ -0,0 +1,25 @@
+/* IDEA_AVX2.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * IDEA bulk kernel with AVX2, used by the bulk functions of IDEA.c
+ * when the CPU supports it. Must be compiled with AVX2 enabled.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define IDEA_AVX2
+#endif
+
+/*
+	Run the 52 subkeys Z (encryption or decryption schedule) over the
+	largest multiple of 16 blocks of nrBlocks and return how many
+	blocks were processed, the caller handles the rest.
+*/
+size_t IDEA_blocks_avx2(const uint16_t* Z, const uint16_t* blocks, uint16_t* out, size_t nrBlocks);
@@ -0,0 +1,125 @@
+/* IDEA_SSE2.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * IDEA bulk encryption and decryption with SSE2.
+ *
+ * Eight blocks are transposed so that a register holds the same
+ * 16 bits word of every block, then each round works on all of them
+ * at once. The multiplication modulo 65537 is pmullw/pmulhuw
+ * followed by a branch-free correction.
+ *
+ */
+
+#include "IDEA_SSE2.h"
+
+#ifdef IDEA_SSE2
+
+#include <emmintrin.h>
+
+#define NR_ROUNDS 8
+
+/*
+	a * b mod 65537 with 0 standing for 65536. For nonzero operands
+	the product is lo - hi, plus 1 when lo < hi. The product is zero
+	only when an operand is zero, the result is then 1 - a - b.
+*/
+static __m128i mul(__m128i a, __m128i b)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i one = _mm_set1_epi16(1);
+	__m128i lo = _mm_mullo_epi16(a, b);
+	__m128i hi = _mm_mulhi_epu16(a, b);
+	// all ones where hi <= lo
+	__m128i noBorrow = _mm_cmpeq_epi16(_mm_subs_epu16(hi, lo), zero);
+	__m128i isZero = _mm_cmpeq_epi16(_mm_or_si128(lo, hi), zero);
+	__m128i p = _mm_add_epi16(_mm_add_epi16(_mm_sub_epi16(lo, hi), one), noBorrow);
+	__m128i z = _mm_sub_epi16(_mm_sub_epi16(one, a), b);
+
+	return _mm_or_si128(_mm_and_si128(isZero, z), _mm_andnot_si128(isZero, p));
+}
+
+size_t IDEA_blocks_sse2(const uint16_t* Z, const uint16_t* blocks, uint16_t* out, size_t nrBlocks)
+{
+	__m128i k[52];
+	__m128i r0, r1, r2, r3;
+	__m128i t0, t1, t2, t3;
+	__m128i x0, x1, x2, x3;
+	__m128i a, b;
+	size_t done;
+	int i;
+
+	if (nrBlocks < 8)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < 52; i++)
+	{
+		k[i] = _mm_set1_epi16((short)Z[i]);
+	}
+
+	for (done = 0; nrBlocks - done >= 8; done += 8, blocks += 32, out += 32)
+	{
+		r0 = _mm_loadu_si128((const __m128i*)blocks);
+		r1 = _mm_loadu_si128((const __m128i*)blocks + 1);
+		r2 = _mm_loadu_si128((const __m128i*)blocks + 2);
+		r3 = _mm_loadu_si128((const __m128i*)blocks + 3);
+
+		// word j of the blocks 0, 1, ..., 7 into xj
+		t0 = _mm_unpacklo_epi16(r0, r1);
+		t1 = _mm_unpackhi_epi16(r0, r1);
+		t2 = _mm_unpacklo_epi16(r2, r3);
+		t3 = _mm_unpackhi_epi16(r2, r3);
+		r0 = _mm_unpacklo_epi16(t0, t1);
+		r1 = _mm_unpackhi_epi16(t0, t1);
+		r2 = _mm_unpacklo_epi16(t2, t3);
+		r3 = _mm_unpackhi_epi16(t2, t3);
+		x0 = _mm_unpacklo_epi64(r0, r2);
+		x1 = _mm_unpackhi_epi64(r0, r2);
+		x2 = _mm_unpacklo_epi64(r1, r3);
+		x3 = _mm_unpackhi_epi64(r1, r3);
+
+		for (i = 0; i < 6 * NR_ROUNDS; i += 6)
+		{
+			// confusion / group operations
+			x0 = mul(k[i], x0);
+			x1 = _mm_add_epi16(x1, k[i + 1]);
+			x2 = _mm_add_epi16(x2, k[i + 2]);
+			x3 = mul(k[i + 3], x3);
+
+			// diffusion / MA (multiplication-addition) structure
+			b = mul(k[i + 4], _mm_xor_si128(x0, x2));
+			a = mul(k[i + 5], _mm_add_epi16(b, _mm_xor_si128(x1, x3)));
+			b = _mm_add_epi16(b, a);
+
+			// involuntary permutation
+			x0 = _mm_xor_si128(x0, a);
+			x3 = _mm_xor_si128(x3, b);
+			b = _mm_xor_si128(b, x1);
+			x1 = _mm_xor_si128(x2, a);
+			x2 = b;
+		}
+
+		// output transformation, the middle words swap back
+		x0 = mul(k[48], x0);
+		t1 = _mm_add_epi16(k[49], x2);
+		t2 = _mm_add_epi16(k[50], x1);
+		x3 = mul(k[51], x3);
+
+		// back to the block order
+		t0 = _mm_unpacklo_epi16(x0, t1);
+		t1 = _mm_unpackhi_epi16(x0, t1);
+		t3 = _mm_unpackhi_epi16(t2, x3);
+		t2 = _mm_unpacklo_epi16(t2, x3);
+		_mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi32(t0, t2));
+		_mm_storeu_si128((__m128i*)out + 1, _mm_unpackhi_epi32(t0, t2));
+		_mm_storeu_si128((__m128i*)out + 2, _mm_unpacklo_epi32(t1, t3));
+		_mm_storeu_si128((__m128i*)out + 3, _mm_unpackhi_epi32(t1, t3));
+	}
+
+	return done;
+}
+
+#endif
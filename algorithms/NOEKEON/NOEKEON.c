@@ -17,6 +17,9 @@
  */
 
 #include "NOEKEON.h"
+#include "NOEKEON_SSE2.h"
+#include "NOEKEON_AVX2.h"
+#include "../../cpu/CPU.h"
 
 #define NR_ROUNDS 16
 
@@ -34,7 +37,7 @@ static const uint32_t NULL_VECTOR[] =
 	0x00, 0x00, 0x00, 0x00
 };
 
-static void MOV_128(uint32_t* y, uint32_t* x)
+static void MOV_128(uint32_t* y, const uint32_t* x)
 {
 	y[0] = x[0];
 	y[1] = x[1];
@@ -104,7 +107,7 @@ static void theta(const uint32_t* k, uint32_t* a)
 	a[2] ^= temp;
 }
 
-static void NOEKEON_round(uint32_t* key, uint32_t* block, uint32_t c1, uint32_t c2)
+static void NOEKEON_round(const uint32_t* key, uint32_t* block, uint32_t c1, uint32_t c2)
 {
 	block[0] ^= c1;
 	theta(key, block);
@@ -114,42 +117,281 @@ static void NOEKEON_round(uint32_t* key, uint32_t* block, uint32_t c1, uint32_t
 	pi2(block);
 }
 
-void NOEKEON_encrypt(uint32_t* block, uint32_t* key, uint32_t* encryptdBlock)
+static void encrypt(const uint32_t* workingKey, const uint32_t* block, uint32_t* out)
 {
-	MOV_128(encryptdBlock, block);
+	MOV_128(out, block);
 	for (int i = 0; i < NR_ROUNDS; i++)
 	{
-		NOEKEON_round(key, encryptdBlock, RC[i], 0);
+		NOEKEON_round(workingKey, out, RC[i], 0);
 	}
 
-	encryptdBlock[0] ^= RC[NR_ROUNDS];
-	theta(key, encryptdBlock);
+	out[0] ^= RC[NR_ROUNDS];
+	theta(workingKey, out);
 }
 
-void NOEKEON_decrypt(uint32_t* encryptedBlock, uint32_t* key, uint32_t* decryptedBlock)
+static void decrypt(const uint32_t* workingKey, const uint32_t* block, uint32_t* out)
+{
+	MOV_128(out, block);
+	for (int i = NR_ROUNDS; i > 0; i--)
+	{
+		NOEKEON_round(workingKey, out, 0, RC[i]);
+	}
+
+	theta(workingKey, out);
+	out[0] ^= RC[0];
+}
+
+/*
+	Direct-key mode, the cipher key is the encryption working key.
+	The decryption working key is theta of it under the null vector,
+	derived here once instead of for every block.
+*/
+void NOEKEON_init(NoekeonContext* context, uint32_t* key)
+{
+	MOV_128(context->encryptionKey, key);
+	MOV_128(context->decryptionKey, key);
+	theta(NULL_VECTOR, context->decryptionKey);
+}
+
+/*
+	Indirect-key mode, the encryption working key is the cipher key
+	encrypted under the null key. To be used when related-key
+	attacks are a concern.
+*/
+void NOEKEON_init_indirect(NoekeonContext* context, uint32_t* key)
 {
 	uint32_t workingKey[4];
 
-	MOV_128(decryptedBlock, encryptedBlock);
-	MOV_128(workingKey, key);
+	encrypt(NULL_VECTOR, key, workingKey);
+	NOEKEON_init(context, workingKey);
+}
+
+void NOEKEON_encrypt(NoekeonContext* context, uint32_t* block, uint32_t* out)
+{
+	encrypt(context->encryptionKey, block, out);
+}
 
-	theta(NULL_VECTOR, workingKey);
+void NOEKEON_decrypt(NoekeonContext* context, uint32_t* block, uint32_t* out)
+{
+	decrypt(context->decryptionKey, block, out);
+}
 
-	for (int i = NR_ROUNDS; i > 0; i--)
+/*
+	Run the SIMD kernels on 8 (AVX2) and then 4 (SSE2) blocks at a
+	time and return how many blocks they processed, the remaining
+	blocks go to the portable code.
+*/
+static size_t NOEKEON_blocks_simd(const uint32_t* workingKey, const uint32_t* blocks, uint32_t* out, size_t nrBlocks, int decrypt)
+{
+	size_t done = 0;
+
+#ifdef NOEKEON_AVX2
+	if (CPU_has(CPU_AVX2))
+	{
+		done = decrypt
+			? NOEKEON_decrypt_blocks_avx2(workingKey, blocks, out, nrBlocks)
+			: NOEKEON_encrypt_blocks_avx2(workingKey, blocks, out, nrBlocks);
+	}
+#endif
+
+#ifdef NOEKEON_SSE2
+	if (CPU_has(CPU_SSE2))
+	{
+		done += decrypt
+			? NOEKEON_decrypt_blocks_sse2(workingKey, blocks + 4 * done, out + 4 * done, nrBlocks - done)
+			: NOEKEON_encrypt_blocks_sse2(workingKey, blocks + 4 * done, out + 4 * done, nrBlocks - done);
+	}
+#endif
+
+	return done;
+}
+
+/*
+	Bulk ECB encryption of nrBlocks consecutive blocks.
+
+	The SIMD kernels take the bulk of the blocks. In the portable
+	code two independent blocks go through each round with the same
+	key, so their theta/gamma chains can overlap in the pipeline.
+*/
+void NOEKEON_encrypt_blocks(NoekeonContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	int i;
+	const uint32_t* key = context->encryptionKey;
+	size_t done = NOEKEON_blocks_simd(key, blocks, out, nrBlocks, 0);
+
+	nrBlocks -= done;
+	blocks += 4 * done;
+	out += 4 * done;
+
+	for (; nrBlocks >= 2; nrBlocks -= 2, blocks += 8, out += 8)
+	{
+		MOV_128(out, blocks);
+		MOV_128(out + 4, blocks + 4);
+
+		for (i = 0; i < NR_ROUNDS; i++)
+		{
+			NOEKEON_round(key, out, RC[i], 0);
+			NOEKEON_round(key, out + 4, RC[i], 0);
+		}
+
+		out[0] ^= RC[NR_ROUNDS];
+		theta(key, out);
+		out[4] ^= RC[NR_ROUNDS];
+		theta(key, out + 4);
+	}
+
+	if (nrBlocks > 0)
+	{
+		encrypt(key, blocks, out);
+	}
+}
+
+void NOEKEON_decrypt_blocks(NoekeonContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	int i;
+	const uint32_t* key = context->decryptionKey;
+	size_t done = NOEKEON_blocks_simd(key, blocks, out, nrBlocks, 1);
+
+	nrBlocks -= done;
+	blocks += 4 * done;
+	out += 4 * done;
+
+	for (; nrBlocks >= 2; nrBlocks -= 2, blocks += 8, out += 8)
+	{
+		MOV_128(out, blocks);
+		MOV_128(out + 4, blocks + 4);
+
+		for (i = NR_ROUNDS; i > 0; i--)
+		{
+			NOEKEON_round(key, out, 0, RC[i]);
+			NOEKEON_round(key, out + 4, 0, RC[i]);
+		}
+
+		theta(key, out);
+		out[0] ^= RC[0];
+		theta(key, out + 4);
+		out[4] ^= RC[0];
+	}
+
+	if (nrBlocks > 0)
+	{
+		decrypt(key, blocks, out);
+	}
+}
+
+/*
+	Encrypt the blocks of NOEKEON_BATCH_LANES contexts with one
+	working key per lane. Returns 0 when the kernel cannot be used.
+*/
+static int NOEKEON_batch_simd(NoekeonContext** contexts, const uint32_t* blocks, uint32_t* out)
+{
+#ifdef NOEKEON_AVX2
+	uint32_t workingKeys[4 * NOEKEON_BATCH_LANES];
+	int b;
+
+	if (!CPU_has(CPU_AVX2))
+	{
+		return 0;
+	}
+
+	for (b = 0; b < NOEKEON_BATCH_LANES; b++)
+	{
+		MOV_128(workingKeys + 4 * b, contexts[b]->encryptionKey);
+	}
+
+	NOEKEON_encrypt_batch_avx2(workingKeys, blocks, out);
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+static int NOEKEON_batch_keys_simd(const uint32_t* keys, const uint32_t* blocks, uint32_t* out)
+{
+#ifdef NOEKEON_AVX2
+	if (CPU_has(CPU_AVX2))
+	{
+		NOEKEON_encrypt_batch_avx2(keys, blocks, out);
+		return 1;
+	}
+#endif
+
+	return 0;
+}
+
+/*
+	Batch encryption of one block under each of nrBlocks keys, the
+	block b (words 4b to 4b + 3) is encrypted under contexts[b].
+
+	The SIMD kernel runs one key per lane instead of one block per
+	lane, the remaining blocks go through the portable code.
+*/
+void NOEKEON_encrypt_batch(NoekeonContext** contexts, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	int b;
+
+	for (; nrBlocks >= NOEKEON_BATCH_LANES; nrBlocks -= NOEKEON_BATCH_LANES,
+		contexts += NOEKEON_BATCH_LANES, blocks += 4 * NOEKEON_BATCH_LANES, out += 4 * NOEKEON_BATCH_LANES)
 	{
-		NOEKEON_round(workingKey, decryptedBlock, 0, RC[i]);
+		if (!NOEKEON_batch_simd(contexts, blocks, out))
+		{
+			for (b = 0; b < NOEKEON_BATCH_LANES; b++)
+			{
+				encrypt(contexts[b]->encryptionKey, blocks + 4 * b, out + 4 * b);
+			}
+		}
 	}
 
-	theta(workingKey, decryptedBlock);
-	decryptedBlock[0] ^= RC[0];
+	for (; nrBlocks > 0; nrBlocks--, contexts++, blocks += 4, out += 4)
+	{
+		encrypt((*contexts)->encryptionKey, blocks, out);
+	}
+}
+
+/*
+	Batch encryption under raw keys in direct-key mode, the key b is
+	keys[4 * b] to keys[4 * b + 3]. As in NOEKEON_init the key is the
+	working key, so no context is built at all.
+*/
+void NOEKEON_encrypt_batch_keys(const uint32_t* keys, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	int b;
+
+	for (; nrBlocks >= NOEKEON_BATCH_LANES; nrBlocks -= NOEKEON_BATCH_LANES,
+		keys += 4 * NOEKEON_BATCH_LANES, blocks += 4 * NOEKEON_BATCH_LANES, out += 4 * NOEKEON_BATCH_LANES)
+	{
+		if (!NOEKEON_batch_keys_simd(keys, blocks, out))
+		{
+			for (b = 0; b < NOEKEON_BATCH_LANES; b++)
+			{
+				encrypt(keys + 4 * b, blocks + 4 * b, out + 4 * b);
+			}
+		}
+	}
+
+	for (; nrBlocks > 0; nrBlocks--, keys += 4, blocks += 4, out += 4)
+	{
+		encrypt(keys, blocks, out);
+	}
 }
 
 void NOEKEON_main(void)
 {
+	NoekeonContext context;
+	NoekeonContext batchContexts[NOEKEON_BATCH_LANES + 3];
+	NoekeonContext* batchPointers[NOEKEON_BATCH_LANES + 3];
+	uint32_t batchKeys[4 * (NOEKEON_BATCH_LANES + 3)];
+	uint32_t batchText[4 * (NOEKEON_BATCH_LANES + 3)];
+	uint32_t batchExpected[4 * (NOEKEON_BATCH_LANES + 3)];
+	uint32_t batchCipherText[4 * (NOEKEON_BATCH_LANES + 3)];
+	uint32_t batchKeysCipherText[4 * (NOEKEON_BATCH_LANES + 3)];
+	int contextsOk;
+	int keysOk;
 	int i;
 	uint32_t key[4];
 	uint32_t text[4];
 	uint32_t cipherText[4];
+	uint32_t expectedCipherText[4];
 	uint32_t decryptedText[4];
 
 	// key 000102030405060708090a0b0c0d0e0f
@@ -164,8 +406,9 @@ void NOEKEON_main(void)
 	text[2] = 0x8899aabb;
 	text[3] = 0xccddeeff;
 
-	NOEKEON_encrypt(text, key, cipherText);
-	NOEKEON_decrypt(cipherText, key, decryptedText);
+	NOEKEON_init(&context, key);
+	NOEKEON_encrypt(&context, text, cipherText);
+	NOEKEON_decrypt(&context, cipherText, decryptedText);
 
 	printf("\nNOEKEON \n\n");
 
@@ -196,4 +439,93 @@ void NOEKEON_main(void)
 		printf("%08x ", decryptedText[i]);
 	}
 	printf("\n");
-}
\ No newline at end of file
+
+	// *** indirect-key mode test ***
+
+	// key ffffffffffffffffffffffffffffffff
+	// text ffffffffffffffffffffffffffffffff
+	for (i = 0; i < 4; i++)
+	{
+		key[i] = 0xffffffff;
+		text[i] = 0xffffffff;
+	}
+
+	// expected encrypted text 52f88a7b283c1f7bdf7b6faa5011c7d8
+	expectedCipherText[0] = 0x52f88a7b;
+	expectedCipherText[1] = 0x283c1f7b;
+	expectedCipherText[2] = 0xdf7b6faa;
+	expectedCipherText[3] = 0x5011c7d8;
+
+	NOEKEON_init_indirect(&context, key);
+	NOEKEON_encrypt(&context, text, cipherText);
+	NOEKEON_decrypt(&context, cipherText, decryptedText);
+
+	printf("\nNOEKEON indirect-key \n\n");
+
+	printf("key: \t\t\t\t");
+	for (i = 0; i < 4; i++)
+	{
+		printf("%08x ", key[i]);
+	}
+	printf("\n");
+
+	printf("text: \t\t\t\t");
+	for (i = 0; i < 4; i++)
+	{
+		printf("%08x ", text[i]);
+	}
+	printf("\n");
+
+	printf("encrypted text: \t\t");
+	for (i = 0; i < 4; i++)
+	{
+		printf("%08x ", cipherText[i]);
+	}
+	printf("\n");
+
+	printf("expected encrypted text: \t");
+	for (i = 0; i < 4; i++)
+	{
+		printf("%08x ", expectedCipherText[i]);
+	}
+	printf("\n");
+
+	printf("decrypted text: \t\t");
+	for (i = 0; i < 4; i++)
+	{
+		printf("%08x ", decryptedText[i]);
+	}
+	printf("\n");
+
+	// *** batch of keys test ***
+
+	// a full batch and 3 more blocks, direct-mode keys and texts
+	// taken from two counters, expected from NOEKEON_encrypt
+	for (i = 0; i < 4 * (NOEKEON_BATCH_LANES + 3); i++)
+	{
+		batchKeys[i] = (uint32_t)i * 0x01020304;
+		batchText[i] = ~((uint32_t)i * 0x04030201);
+	}
+
+	for (i = 0; i < NOEKEON_BATCH_LANES + 3; i++)
+	{
+		NOEKEON_init(&batchContexts[i], batchKeys + 4 * i);
+		NOEKEON_encrypt(&batchContexts[i], batchText + 4 * i, batchExpected + 4 * i);
+		batchPointers[i] = &batchContexts[i];
+	}
+
+	NOEKEON_encrypt_batch(batchPointers, batchText, batchCipherText, NOEKEON_BATCH_LANES + 3);
+	NOEKEON_encrypt_batch_keys(batchKeys, batchText, batchKeysCipherText, NOEKEON_BATCH_LANES + 3);
+
+	contextsOk = 1;
+	keysOk = 1;
+	for (i = 0; i < 4 * (NOEKEON_BATCH_LANES + 3); i++)
+	{
+		contextsOk &= batchCipherText[i] == batchExpected[i];
+		keysOk &= batchKeysCipherText[i] == batchExpected[i];
+	}
+
+	printf("\nNOEKEON batch of %d keys \n\n", NOEKEON_BATCH_LANES + 3);
+	printf("contexts: \t\t\t%s\n", contextsOk ? "ok" : "FAILED");
+	printf("raw keys: \t\t\t%s\n", keysOk ? "ok" : "FAILED");
+}
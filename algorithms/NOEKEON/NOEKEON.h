@@ -10,7 +10,21 @@
 #include <stdio.h>
 #include <stdint.h>
 
-void NOEKEON_encrypt(uint32_t* block, uint32_t* key, uint32_t* encryptdBlock);
-void NOEKEON_decrypt(uint32_t* encryptedBlock, uint32_t* key, uint32_t* decryptedBlock);
+typedef struct
+{
+	// working keys of the encryption and of the decryption
+	uint32_t encryptionKey[4];
+	uint32_t decryptionKey[4];
+} NoekeonContext;
+
+void NOEKEON_init(NoekeonContext* context, uint32_t* key);
+void NOEKEON_init_indirect(NoekeonContext* context, uint32_t* key);
+void NOEKEON_encrypt(NoekeonContext* context, uint32_t* block, uint32_t* out);
+void NOEKEON_decrypt(NoekeonContext* context, uint32_t* block, uint32_t* out);
+void NOEKEON_encrypt_blocks(NoekeonContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
+void NOEKEON_decrypt_blocks(NoekeonContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
+
+void NOEKEON_encrypt_batch(NoekeonContext** contexts, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
+void NOEKEON_encrypt_batch_keys(const uint32_t* keys, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
 
 void NOEKEON_main(void);
\ No newline at end of file
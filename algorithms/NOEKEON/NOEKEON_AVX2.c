@@ -0,0 +1,248 @@
+/* NOEKEON_AVX2.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * NOEKEON bulk encryption and decryption with AVX2.
+ *
+ * The round is made of bitwise operations on four 32 bits words, so
+ * after a 4x4 transposition of the words in each 128 bits half,
+ * register ai holds the word i of eight blocks and the round runs
+ * unchanged on all of them. The rotations by 8 bits are byte
+ * shuffles. The
+ * working key and the round constants are broadcast once per call.
+ *
+ * The batch kernel gives each block its own working key, the keys
+ * are transposed as the blocks, so each lane of the key registers
+ * holds the key of the block in the same lane.
+ *
+ */
+
+#include "NOEKEON_AVX2.h"
+
+#ifdef NOEKEON_AVX2
+
+#include <immintrin.h>
+
+#define NR_ROUNDS 16
+
+static const uint32_t RC[] =
+{
+	0x80, 0x1b, 0x36, 0x6c,
+	0xd8, 0xab, 0x4d, 0x9a,
+	0x2f, 0x5e, 0xbc, 0x63,
+	0xc6, 0x97, 0x35, 0x6a,
+	0xd4
+};
+
+#define ROL(v, n) _mm256_or_si256(_mm256_slli_epi32(v, n), _mm256_srli_epi32(v, 32 - (n)))
+#define ROR(v, n) _mm256_or_si256(_mm256_srli_epi32(v, n), _mm256_slli_epi32(v, 32 - (n)))
+#define ROL8(v) _mm256_shuffle_epi8(v, rol8)
+#define ROR8(v) _mm256_shuffle_epi8(v, ror8)
+
+#define THETA(k) \
+	t = _mm256_xor_si256(a0, a2); \
+	t = _mm256_xor_si256(t, _mm256_xor_si256(ROR8(t), ROL8(t))); \
+	a1 = _mm256_xor_si256(a1, t); \
+	a3 = _mm256_xor_si256(a3, t); \
+	a0 = _mm256_xor_si256(a0, k[0]); \
+	a1 = _mm256_xor_si256(a1, k[1]); \
+	a2 = _mm256_xor_si256(a2, k[2]); \
+	a3 = _mm256_xor_si256(a3, k[3]); \
+	t = _mm256_xor_si256(a1, a3); \
+	t = _mm256_xor_si256(t, _mm256_xor_si256(ROR8(t), ROL8(t))); \
+	a0 = _mm256_xor_si256(a0, t); \
+	a2 = _mm256_xor_si256(a2, t)
+
+#define PI1 \
+	a1 = ROL(a1, 1); \
+	a2 = ROL(a2, 5); \
+	a3 = ROL(a3, 2)
+
+#define PI2 \
+	a1 = ROR(a1, 1); \
+	a2 = ROR(a2, 5); \
+	a3 = ROR(a3, 2)
+
+// ~a3 & ~a2 is written as ~(a3 | a2)
+#define GAMMA \
+	a1 = _mm256_xor_si256(a1, _mm256_xor_si256(_mm256_or_si256(a3, a2), ones)); \
+	a0 = _mm256_xor_si256(a0, _mm256_and_si256(a2, a1)); \
+	t = a3; \
+	a3 = a0; \
+	a0 = t; \
+	a2 = _mm256_xor_si256(a2, _mm256_xor_si256(_mm256_xor_si256(a0, a1), a3)); \
+	a1 = _mm256_xor_si256(a1, _mm256_xor_si256(_mm256_or_si256(a3, a2), ones)); \
+	a0 = _mm256_xor_si256(a0, _mm256_and_si256(a2, a1))
+
+/*
+	Word i of the blocks into ai, each 128 bits half transposes the
+	four blocks loaded into it. The transposition is its own inverse.
+*/
+#define TRANSPOSE \
+	t0 = _mm256_unpacklo_epi32(a0, a1); \
+	t1 = _mm256_unpacklo_epi32(a2, a3); \
+	t2 = _mm256_unpackhi_epi32(a0, a1); \
+	t3 = _mm256_unpackhi_epi32(a2, a3); \
+	a0 = _mm256_unpacklo_epi64(t0, t1); \
+	a1 = _mm256_unpackhi_epi64(t0, t1); \
+	a2 = _mm256_unpacklo_epi64(t2, t3); \
+	a3 = _mm256_unpackhi_epi64(t2, t3)
+
+#define LOAD(blocks) \
+	a0 = _mm256_loadu_si256((const __m256i*)(blocks)); \
+	a1 = _mm256_loadu_si256((const __m256i*)(blocks) + 1); \
+	a2 = _mm256_loadu_si256((const __m256i*)(blocks) + 2); \
+	a3 = _mm256_loadu_si256((const __m256i*)(blocks) + 3); \
+	TRANSPOSE
+
+#define STORE(out) \
+	TRANSPOSE; \
+	_mm256_storeu_si256((__m256i*)(out), a0); \
+	_mm256_storeu_si256((__m256i*)(out) + 1, a1); \
+	_mm256_storeu_si256((__m256i*)(out) + 2, a2); \
+	_mm256_storeu_si256((__m256i*)(out) + 3, a3)
+
+static void broadcast(const uint32_t* workingKey, __m256i* k, __m256i* rc)
+{
+	int i;
+
+	for (i = 0; i < 4; i++)
+	{
+		k[i] = _mm256_set1_epi32((int)workingKey[i]);
+	}
+
+	for (i = 0; i <= NR_ROUNDS; i++)
+	{
+		rc[i] = _mm256_set1_epi32((int)RC[i]);
+	}
+}
+
+size_t NOEKEON_encrypt_blocks_avx2(const uint32_t* workingKey, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	const __m256i ones = _mm256_set1_epi32(-1);
+	const __m256i rol8 = _mm256_set_epi8(
+		14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+		14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+	const __m256i ror8 = _mm256_set_epi8(
+		12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1,
+		12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1);
+	__m256i k[4];
+	__m256i rc[NR_ROUNDS + 1];
+	__m256i a0, a1, a2, a3;
+	__m256i t, t0, t1, t2, t3;
+	size_t done;
+	int i;
+
+	if (nrBlocks < 8)
+	{
+		return 0;
+	}
+
+	broadcast(workingKey, k, rc);
+
+	for (done = 0; nrBlocks - done >= 8; done += 8, blocks += 32, out += 32)
+	{
+		LOAD(blocks);
+
+		for (i = 0; i < NR_ROUNDS; i++)
+		{
+			a0 = _mm256_xor_si256(a0, rc[i]);
+			THETA(k);
+			PI1;
+			GAMMA;
+			PI2;
+		}
+
+		a0 = _mm256_xor_si256(a0, rc[NR_ROUNDS]);
+		THETA(k);
+
+		STORE(out);
+	}
+
+	return done;
+}
+
+size_t NOEKEON_decrypt_blocks_avx2(const uint32_t* workingKey, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	const __m256i ones = _mm256_set1_epi32(-1);
+	const __m256i rol8 = _mm256_set_epi8(
+		14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+		14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+	const __m256i ror8 = _mm256_set_epi8(
+		12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1,
+		12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1);
+	__m256i k[4];
+	__m256i rc[NR_ROUNDS + 1];
+	__m256i a0, a1, a2, a3;
+	__m256i t, t0, t1, t2, t3;
+	size_t done;
+	int i;
+
+	if (nrBlocks < 8)
+	{
+		return 0;
+	}
+
+	broadcast(workingKey, k, rc);
+
+	for (done = 0; nrBlocks - done >= 8; done += 8, blocks += 32, out += 32)
+	{
+		LOAD(blocks);
+
+		for (i = NR_ROUNDS; i > 0; i--)
+		{
+			THETA(k);
+			a0 = _mm256_xor_si256(a0, rc[i]);
+			PI1;
+			GAMMA;
+			PI2;
+		}
+
+		THETA(k);
+		a0 = _mm256_xor_si256(a0, rc[0]);
+
+		STORE(out);
+	}
+
+	return done;
+}
+
+void NOEKEON_encrypt_batch_avx2(const uint32_t* workingKeys, const uint32_t* blocks, uint32_t* out)
+{
+	const __m256i ones = _mm256_set1_epi32(-1);
+	const __m256i rol8 = _mm256_set_epi8(
+		14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+		14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+	const __m256i ror8 = _mm256_set_epi8(
+		12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1,
+		12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1);
+	__m256i k[4];
+	__m256i a0, a1, a2, a3;
+	__m256i t, t0, t1, t2, t3;
+	int i;
+
+	LOAD(workingKeys);
+	k[0] = a0;
+	k[1] = a1;
+	k[2] = a2;
+	k[3] = a3;
+
+	LOAD(blocks);
+
+	for (i = 0; i < NR_ROUNDS; i++)
+	{
+		a0 = _mm256_xor_si256(a0, _mm256_set1_epi32((int)RC[i]));
+		THETA(k);
+		PI1;
+		GAMMA;
+		PI2;
+	}
+
+	a0 = _mm256_xor_si256(a0, _mm256_set1_epi32((int)RC[NR_ROUNDS]));
+	THETA(k);
+
+	STORE(out);
+}
+
+#endif
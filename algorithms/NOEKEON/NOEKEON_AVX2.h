@@ -0,0 +1,37 @@
+/* NOEKEON_AVX2.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * NOEKEON bulk and batch kernels with AVX2, used by the bulk and
+ * batch functions of NOEKEON.c when the CPU supports it. Must be
+ * compiled with AVX2 enabled.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// blocks of a batch kernel, each one under its own key
+#define NOEKEON_BATCH_LANES 8
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define NOEKEON_AVX2
+#endif
+
+/*
+	Process the largest multiple of 8 blocks of nrBlocks and return
+	how many blocks were processed, the caller handles the rest.
+	Decryption takes the decryption working key, theta of the key
+	under the null vector.
+*/
+size_t NOEKEON_encrypt_blocks_avx2(const uint32_t* workingKey, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
+size_t NOEKEON_decrypt_blocks_avx2(const uint32_t* workingKey, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
+
+/*
+	Encrypt NOEKEON_BATCH_LANES blocks, the block b under the working
+	key b, which is workingKeys[4 * b] to workingKeys[4 * b + 3].
+*/
+void NOEKEON_encrypt_batch_avx2(const uint32_t* workingKeys, const uint32_t* blocks, uint32_t* out);
@@ -0,0 +1,188 @@
+/* NOEKEON_SSE2.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * NOEKEON bulk encryption and decryption with SSE2.
+ *
+ * The round is made of bitwise operations on four 32 bits words, so
+ * after a 4x4 transposition of the words register ai holds the word
+ * i of four blocks and the round runs unchanged on all of them. The
+ * working key and the round constants are broadcast once per call.
+ *
+ */
+
+#include "NOEKEON_SSE2.h"
+
+#ifdef NOEKEON_SSE2
+
+#include <emmintrin.h>
+
+#define NR_ROUNDS 16
+
+static const uint32_t RC[] =
+{
+	0x80, 0x1b, 0x36, 0x6c,
+	0xd8, 0xab, 0x4d, 0x9a,
+	0x2f, 0x5e, 0xbc, 0x63,
+	0xc6, 0x97, 0x35, 0x6a,
+	0xd4
+};
+
+#define ROL(v, n) _mm_or_si128(_mm_slli_epi32(v, n), _mm_srli_epi32(v, 32 - (n)))
+#define ROR(v, n) _mm_or_si128(_mm_srli_epi32(v, n), _mm_slli_epi32(v, 32 - (n)))
+
+#define THETA(k) \
+	t = _mm_xor_si128(a0, a2); \
+	t = _mm_xor_si128(t, _mm_xor_si128(ROR(t, 8), ROL(t, 8))); \
+	a1 = _mm_xor_si128(a1, t); \
+	a3 = _mm_xor_si128(a3, t); \
+	a0 = _mm_xor_si128(a0, k[0]); \
+	a1 = _mm_xor_si128(a1, k[1]); \
+	a2 = _mm_xor_si128(a2, k[2]); \
+	a3 = _mm_xor_si128(a3, k[3]); \
+	t = _mm_xor_si128(a1, a3); \
+	t = _mm_xor_si128(t, _mm_xor_si128(ROR(t, 8), ROL(t, 8))); \
+	a0 = _mm_xor_si128(a0, t); \
+	a2 = _mm_xor_si128(a2, t)
+
+#define PI1 \
+	a1 = ROL(a1, 1); \
+	a2 = ROL(a2, 5); \
+	a3 = ROL(a3, 2)
+
+#define PI2 \
+	a1 = ROR(a1, 1); \
+	a2 = ROR(a2, 5); \
+	a3 = ROR(a3, 2)
+
+// ~a3 & ~a2 is written as ~(a3 | a2)
+#define GAMMA \
+	a1 = _mm_xor_si128(a1, _mm_xor_si128(_mm_or_si128(a3, a2), ones)); \
+	a0 = _mm_xor_si128(a0, _mm_and_si128(a2, a1)); \
+	t = a3; \
+	a3 = a0; \
+	a0 = t; \
+	a2 = _mm_xor_si128(a2, _mm_xor_si128(_mm_xor_si128(a0, a1), a3)); \
+	a1 = _mm_xor_si128(a1, _mm_xor_si128(_mm_or_si128(a3, a2), ones)); \
+	a0 = _mm_xor_si128(a0, _mm_and_si128(a2, a1))
+
+// word i of the four blocks into ai, the transposition is its own inverse
+#define TRANSPOSE \
+	t0 = _mm_unpacklo_epi32(a0, a1); \
+	t1 = _mm_unpacklo_epi32(a2, a3); \
+	t2 = _mm_unpackhi_epi32(a0, a1); \
+	t3 = _mm_unpackhi_epi32(a2, a3); \
+	a0 = _mm_unpacklo_epi64(t0, t1); \
+	a1 = _mm_unpackhi_epi64(t0, t1); \
+	a2 = _mm_unpacklo_epi64(t2, t3); \
+	a3 = _mm_unpackhi_epi64(t2, t3)
+
+#define LOAD(blocks) \
+	a0 = _mm_loadu_si128((const __m128i*)(blocks)); \
+	a1 = _mm_loadu_si128((const __m128i*)(blocks) + 1); \
+	a2 = _mm_loadu_si128((const __m128i*)(blocks) + 2); \
+	a3 = _mm_loadu_si128((const __m128i*)(blocks) + 3); \
+	TRANSPOSE
+
+#define STORE(out) \
+	TRANSPOSE; \
+	_mm_storeu_si128((__m128i*)(out), a0); \
+	_mm_storeu_si128((__m128i*)(out) + 1, a1); \
+	_mm_storeu_si128((__m128i*)(out) + 2, a2); \
+	_mm_storeu_si128((__m128i*)(out) + 3, a3)
+
+static void broadcast(const uint32_t* workingKey, __m128i* k, __m128i* rc)
+{
+	int i;
+
+	for (i = 0; i < 4; i++)
+	{
+		k[i] = _mm_set1_epi32((int)workingKey[i]);
+	}
+
+	for (i = 0; i <= NR_ROUNDS; i++)
+	{
+		rc[i] = _mm_set1_epi32((int)RC[i]);
+	}
+}
+
+size_t NOEKEON_encrypt_blocks_sse2(const uint32_t* workingKey, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	const __m128i ones = _mm_set1_epi32(-1);
+	__m128i k[4];
+	__m128i rc[NR_ROUNDS + 1];
+	__m128i a0, a1, a2, a3;
+	__m128i t, t0, t1, t2, t3;
+	size_t done;
+	int i;
+
+	if (nrBlocks < 4)
+	{
+		return 0;
+	}
+
+	broadcast(workingKey, k, rc);
+
+	for (done = 0; nrBlocks - done >= 4; done += 4, blocks += 16, out += 16)
+	{
+		LOAD(blocks);
+
+		for (i = 0; i < NR_ROUNDS; i++)
+		{
+			a0 = _mm_xor_si128(a0, rc[i]);
+			THETA(k);
+			PI1;
+			GAMMA;
+			PI2;
+		}
+
+		a0 = _mm_xor_si128(a0, rc[NR_ROUNDS]);
+		THETA(k);
+
+		STORE(out);
+	}
+
+	return done;
+}
+
+size_t NOEKEON_decrypt_blocks_sse2(const uint32_t* workingKey, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	const __m128i ones = _mm_set1_epi32(-1);
+	__m128i k[4];
+	__m128i rc[NR_ROUNDS + 1];
+	__m128i a0, a1, a2, a3;
+	__m128i t, t0, t1, t2, t3;
+	size_t done;
+	int i;
+
+	if (nrBlocks < 4)
+	{
+		return 0;
+	}
+
+	broadcast(workingKey, k, rc);
+
+	for (done = 0; nrBlocks - done >= 4; done += 4, blocks += 16, out += 16)
+	{
+		LOAD(blocks);
+
+		for (i = NR_ROUNDS; i > 0; i--)
+		{
+			THETA(k);
+			a0 = _mm_xor_si128(a0, rc[i]);
+			PI1;
+			GAMMA;
+			PI2;
+		}
+
+		THETA(k);
+		a0 = _mm_xor_si128(a0, rc[0]);
+
+		STORE(out);
+	}
+
+	return done;
+}
+
+#endif
@@ -0,0 +1,28 @@
+/* NOEKEON_SSE2.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * NOEKEON bulk kernels with SSE2, used by the bulk functions of
+ * NOEKEON.c when the CPU supports it. Must be compiled with SSE2
+ * enabled.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define NOEKEON_SSE2
+#endif
+
+/*
+	Process the largest multiple of 4 blocks of nrBlocks and return
+	how many blocks were processed, the caller handles the rest.
+	Decryption takes the decryption working key, theta of the key
+	under the null vector.
+*/
+size_t NOEKEON_encrypt_blocks_sse2(const uint32_t* workingKey, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
+size_t NOEKEON_decrypt_blocks_sse2(const uint32_t* workingKey, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
@@ -16,10 +16,21 @@
  *
  */
 
+#include <string.h>
+
 #include "PRESENT.h"
+#include "PRESENT_AVX2.h"
+#include "../../cpu/CPU.h"
 
 #define NR_ROUNDS 31
 
+// blocks of the bitsliced engine, one per bit of a 64 bits slice
+#define BITSLICE_BLOCKS 64
+
+// fewest blocks for the AVX2 slices: a pass of 4 groups costs about
+// two scalar passes, so the missing groups are padded only beyond 128
+#define AVX2_MIN_BLOCKS (2 * BITSLICE_BLOCKS + 1)
+
 // s-box
 const uint8_t sbox[16] =
 {
@@ -41,6 +52,1156 @@ const uint8_t p[64] =
 	12, 28, 44, 60, 13, 29, 45, 61, 14, 30, 46, 62, 15, 31, 47, 63
 };
 
+// s-box followed by the permutation layer for each byte of the state, byte 0 is the least significant
+static const uint64_t spBox[8][256] =
+{
+	{
+		0x0003000300000000, 0x0002000300000001, 0x0002000300010000, 0x0003000200010001,
+		0x0003000200000001, 0x0002000200000000, 0x0003000200010000, 0x0003000300000001,
+		0x0002000200010001, 0x0003000300010000, 0x0003000300010001, 0x0003000200000000,
+		0x0002000300000000, 0x0002000300010001, 0x0002000200000001, 0x0002000200010000,
+		0x0001000300000002, 0x0000000300000003, 0x0000000300010002, 0x0001000200010003,
+		0x0001000200000003, 0x0000000200000002, 0x0001000200010002, 0x0001000300000003,
+		0x0000000200010003, 0x0001000300010002, 0x0001000300010003, 0x0001000200000002,
+		0x0000000300000002, 0x0000000300010003, 0x0000000200000003, 0x0000000200010002,
+		0x0001000300020000, 0x0000000300020001, 0x0000000300030000, 0x0001000200030001,
+		0x0001000200020001, 0x0000000200020000, 0x0001000200030000, 0x0001000300020001,
+		0x0000000200030001, 0x0001000300030000, 0x0001000300030001, 0x0001000200020000,
+		0x0000000300020000, 0x0000000300030001, 0x0000000200020001, 0x0000000200030000,
+		0x0003000100020002, 0x0002000100020003, 0x0002000100030002, 0x0003000000030003,
+		0x0003000000020003, 0x0002000000020002, 0x0003000000030002, 0x0003000100020003,
+		0x0002000000030003, 0x0003000100030002, 0x0003000100030003, 0x0003000000020002,
+		0x0002000100020002, 0x0002000100030003, 0x0002000000020003, 0x0002000000030002,
+		0x0003000100000002, 0x0002000100000003, 0x0002000100010002, 0x0003000000010003,
+		0x0003000000000003, 0x0002000000000002, 0x0003000000010002, 0x0003000100000003,
+		0x0002000000010003, 0x0003000100010002, 0x0003000100010003, 0x0003000000000002,
+		0x0002000100000002, 0x0002000100010003, 0x0002000000000003, 0x0002000000010002,
+		0x0001000100000000, 0x0000000100000001, 0x0000000100010000, 0x0001000000010001,
+		0x0001000000000001, 0x0000000000000000, 0x0001000000010000, 0x0001000100000001,
+		0x0000000000010001, 0x0001000100010000, 0x0001000100010001, 0x0001000000000000,
+		0x0000000100000000, 0x0000000100010001, 0x0000000000000001, 0x0000000000010000,
+		0x0003000100020000, 0x0002000100020001, 0x0002000100030000, 0x0003000000030001,
+		0x0003000000020001, 0x0002000000020000, 0x0003000000030000, 0x0003000100020001,
+		0x0002000000030001, 0x0003000100030000, 0x0003000100030001, 0x0003000000020000,
+		0x0002000100020000, 0x0002000100030001, 0x0002000000020001, 0x0002000000030000,
+		0x0003000300000002, 0x0002000300000003, 0x0002000300010002, 0x0003000200010003,
+		0x0003000200000003, 0x0002000200000002, 0x0003000200010002, 0x0003000300000003,
+		0x0002000200010003, 0x0003000300010002, 0x0003000300010003, 0x0003000200000002,
+		0x0002000300000002, 0x0002000300010003, 0x0002000200000003, 0x0002000200010002,
+		0x0001000100020002, 0x0000000100020003, 0x0000000100030002, 0x0001000000030003,
+		0x0001000000020003, 0x0000000000020002, 0x0001000000030002, 0x0001000100020003,
+		0x0000000000030003, 0x0001000100030002, 0x0001000100030003, 0x0001000000020002,
+		0x0000000100020002, 0x0000000100030003, 0x0000000000020003, 0x0000000000030002,
+		0x0003000300020000, 0x0002000300020001, 0x0002000300030000, 0x0003000200030001,
+		0x0003000200020001, 0x0002000200020000, 0x0003000200030000, 0x0003000300020001,
+		0x0002000200030001, 0x0003000300030000, 0x0003000300030001, 0x0003000200020000,
+		0x0002000300020000, 0x0002000300030001, 0x0002000200020001, 0x0002000200030000,
+		0x0003000300020002, 0x0002000300020003, 0x0002000300030002, 0x0003000200030003,
+		0x0003000200020003, 0x0002000200020002, 0x0003000200030002, 0x0003000300020003,
+		0x0002000200030003, 0x0003000300030002, 0x0003000300030003, 0x0003000200020002,
+		0x0002000300020002, 0x0002000300030003, 0x0002000200020003, 0x0002000200030002,
+		0x0003000100000000, 0x0002000100000001, 0x0002000100010000, 0x0003000000010001,
+		0x0003000000000001, 0x0002000000000000, 0x0003000000010000, 0x0003000100000001,
+		0x0002000000010001, 0x0003000100010000, 0x0003000100010001, 0x0003000000000000,
+		0x0002000100000000, 0x0002000100010001, 0x0002000000000001, 0x0002000000010000,
+		0x0001000300000000, 0x0000000300000001, 0x0000000300010000, 0x0001000200010001,
+		0x0001000200000001, 0x0000000200000000, 0x0001000200010000, 0x0001000300000001,
+		0x0000000200010001, 0x0001000300010000, 0x0001000300010001, 0x0001000200000000,
+		0x0000000300000000, 0x0000000300010001, 0x0000000200000001, 0x0000000200010000,
+		0x0001000300020002, 0x0000000300020003, 0x0000000300030002, 0x0001000200030003,
+		0x0001000200020003, 0x0000000200020002, 0x0001000200030002, 0x0001000300020003,
+		0x0000000200030003, 0x0001000300030002, 0x0001000300030003, 0x0001000200020002,
+		0x0000000300020002, 0x0000000300030003, 0x0000000200020003, 0x0000000200030002,
+		0x0001000100000002, 0x0000000100000003, 0x0000000100010002, 0x0001000000010003,
+		0x0001000000000003, 0x0000000000000002, 0x0001000000010002, 0x0001000100000003,
+		0x0000000000010003, 0x0001000100010002, 0x0001000100010003, 0x0001000000000002,
+		0x0000000100000002, 0x0000000100010003, 0x0000000000000003, 0x0000000000010002,
+		0x0001000100020000, 0x0000000100020001, 0x0000000100030000, 0x0001000000030001,
+		0x0001000000020001, 0x0000000000020000, 0x0001000000030000, 0x0001000100020001,
+		0x0000000000030001, 0x0001000100030000, 0x0001000100030001, 0x0001000000020000,
+		0x0000000100020000, 0x0000000100030001, 0x0000000000020001, 0x0000000000030000
+	},
+	{
+		0x000c000c00000000, 0x0008000c00000004, 0x0008000c00040000, 0x000c000800040004,
+		0x000c000800000004, 0x0008000800000000, 0x000c000800040000, 0x000c000c00000004,
+		0x0008000800040004, 0x000c000c00040000, 0x000c000c00040004, 0x000c000800000000,
+		0x0008000c00000000, 0x0008000c00040004, 0x0008000800000004, 0x0008000800040000,
+		0x0004000c00000008, 0x0000000c0000000c, 0x0000000c00040008, 0x000400080004000c,
+		0x000400080000000c, 0x0000000800000008, 0x0004000800040008, 0x0004000c0000000c,
+		0x000000080004000c, 0x0004000c00040008, 0x0004000c0004000c, 0x0004000800000008,
+		0x0000000c00000008, 0x0000000c0004000c, 0x000000080000000c, 0x0000000800040008,
+		0x0004000c00080000, 0x0000000c00080004, 0x0000000c000c0000, 0x00040008000c0004,
+		0x0004000800080004, 0x0000000800080000, 0x00040008000c0000, 0x0004000c00080004,
+		0x00000008000c0004, 0x0004000c000c0000, 0x0004000c000c0004, 0x0004000800080000,
+		0x0000000c00080000, 0x0000000c000c0004, 0x0000000800080004, 0x00000008000c0000,
+		0x000c000400080008, 0x000800040008000c, 0x00080004000c0008, 0x000c0000000c000c,
+		0x000c00000008000c, 0x0008000000080008, 0x000c0000000c0008, 0x000c00040008000c,
+		0x00080000000c000c, 0x000c0004000c0008, 0x000c0004000c000c, 0x000c000000080008,
+		0x0008000400080008, 0x00080004000c000c, 0x000800000008000c, 0x00080000000c0008,
+		0x000c000400000008, 0x000800040000000c, 0x0008000400040008, 0x000c00000004000c,
+		0x000c00000000000c, 0x0008000000000008, 0x000c000000040008, 0x000c00040000000c,
+		0x000800000004000c, 0x000c000400040008, 0x000c00040004000c, 0x000c000000000008,
+		0x0008000400000008, 0x000800040004000c, 0x000800000000000c, 0x0008000000040008,
+		0x0004000400000000, 0x0000000400000004, 0x0000000400040000, 0x0004000000040004,
+		0x0004000000000004, 0x0000000000000000, 0x0004000000040000, 0x0004000400000004,
+		0x0000000000040004, 0x0004000400040000, 0x0004000400040004, 0x0004000000000000,
+		0x0000000400000000, 0x0000000400040004, 0x0000000000000004, 0x0000000000040000,
+		0x000c000400080000, 0x0008000400080004, 0x00080004000c0000, 0x000c0000000c0004,
+		0x000c000000080004, 0x0008000000080000, 0x000c0000000c0000, 0x000c000400080004,
+		0x00080000000c0004, 0x000c0004000c0000, 0x000c0004000c0004, 0x000c000000080000,
+		0x0008000400080000, 0x00080004000c0004, 0x0008000000080004, 0x00080000000c0000,
+		0x000c000c00000008, 0x0008000c0000000c, 0x0008000c00040008, 0x000c00080004000c,
+		0x000c00080000000c, 0x0008000800000008, 0x000c000800040008, 0x000c000c0000000c,
+		0x000800080004000c, 0x000c000c00040008, 0x000c000c0004000c, 0x000c000800000008,
+		0x0008000c00000008, 0x0008000c0004000c, 0x000800080000000c, 0x0008000800040008,
+		0x0004000400080008, 0x000000040008000c, 0x00000004000c0008, 0x00040000000c000c,
+		0x000400000008000c, 0x0000000000080008, 0x00040000000c0008, 0x000400040008000c,
+		0x00000000000c000c, 0x00040004000c0008, 0x00040004000c000c, 0x0004000000080008,
+		0x0000000400080008, 0x00000004000c000c, 0x000000000008000c, 0x00000000000c0008,
+		0x000c000c00080000, 0x0008000c00080004, 0x0008000c000c0000, 0x000c0008000c0004,
+		0x000c000800080004, 0x0008000800080000, 0x000c0008000c0000, 0x000c000c00080004,
+		0x00080008000c0004, 0x000c000c000c0000, 0x000c000c000c0004, 0x000c000800080000,
+		0x0008000c00080000, 0x0008000c000c0004, 0x0008000800080004, 0x00080008000c0000,
+		0x000c000c00080008, 0x0008000c0008000c, 0x0008000c000c0008, 0x000c0008000c000c,
+		0x000c00080008000c, 0x0008000800080008, 0x000c0008000c0008, 0x000c000c0008000c,
+		0x00080008000c000c, 0x000c000c000c0008, 0x000c000c000c000c, 0x000c000800080008,
+		0x0008000c00080008, 0x0008000c000c000c, 0x000800080008000c, 0x00080008000c0008,
+		0x000c000400000000, 0x0008000400000004, 0x0008000400040000, 0x000c000000040004,
+		0x000c000000000004, 0x0008000000000000, 0x000c000000040000, 0x000c000400000004,
+		0x0008000000040004, 0x000c000400040000, 0x000c000400040004, 0x000c000000000000,
+		0x0008000400000000, 0x0008000400040004, 0x0008000000000004, 0x0008000000040000,
+		0x0004000c00000000, 0x0000000c00000004, 0x0000000c00040000, 0x0004000800040004,
+		0x0004000800000004, 0x0000000800000000, 0x0004000800040000, 0x0004000c00000004,
+		0x0000000800040004, 0x0004000c00040000, 0x0004000c00040004, 0x0004000800000000,
+		0x0000000c00000000, 0x0000000c00040004, 0x0000000800000004, 0x0000000800040000,
+		0x0004000c00080008, 0x0000000c0008000c, 0x0000000c000c0008, 0x00040008000c000c,
+		0x000400080008000c, 0x0000000800080008, 0x00040008000c0008, 0x0004000c0008000c,
+		0x00000008000c000c, 0x0004000c000c0008, 0x0004000c000c000c, 0x0004000800080008,
+		0x0000000c00080008, 0x0000000c000c000c, 0x000000080008000c, 0x00000008000c0008,
+		0x0004000400000008, 0x000000040000000c, 0x0000000400040008, 0x000400000004000c,
+		0x000400000000000c, 0x0000000000000008, 0x0004000000040008, 0x000400040000000c,
+		0x000000000004000c, 0x0004000400040008, 0x000400040004000c, 0x0004000000000008,
+		0x0000000400000008, 0x000000040004000c, 0x000000000000000c, 0x0000000000040008,
+		0x0004000400080000, 0x0000000400080004, 0x00000004000c0000, 0x00040000000c0004,
+		0x0004000000080004, 0x0000000000080000, 0x00040000000c0000, 0x0004000400080004,
+		0x00000000000c0004, 0x00040004000c0000, 0x00040004000c0004, 0x0004000000080000,
+		0x0000000400080000, 0x00000004000c0004, 0x0000000000080004, 0x00000000000c0000
+	},
+	{
+		0x0030003000000000, 0x0020003000000010, 0x0020003000100000, 0x0030002000100010,
+		0x0030002000000010, 0x0020002000000000, 0x0030002000100000, 0x0030003000000010,
+		0x0020002000100010, 0x0030003000100000, 0x0030003000100010, 0x0030002000000000,
+		0x0020003000000000, 0x0020003000100010, 0x0020002000000010, 0x0020002000100000,
+		0x0010003000000020, 0x0000003000000030, 0x0000003000100020, 0x0010002000100030,
+		0x0010002000000030, 0x0000002000000020, 0x0010002000100020, 0x0010003000000030,
+		0x0000002000100030, 0x0010003000100020, 0x0010003000100030, 0x0010002000000020,
+		0x0000003000000020, 0x0000003000100030, 0x0000002000000030, 0x0000002000100020,
+		0x0010003000200000, 0x0000003000200010, 0x0000003000300000, 0x0010002000300010,
+		0x0010002000200010, 0x0000002000200000, 0x0010002000300000, 0x0010003000200010,
+		0x0000002000300010, 0x0010003000300000, 0x0010003000300010, 0x0010002000200000,
+		0x0000003000200000, 0x0000003000300010, 0x0000002000200010, 0x0000002000300000,
+		0x0030001000200020, 0x0020001000200030, 0x0020001000300020, 0x0030000000300030,
+		0x0030000000200030, 0x0020000000200020, 0x0030000000300020, 0x0030001000200030,
+		0x0020000000300030, 0x0030001000300020, 0x0030001000300030, 0x0030000000200020,
+		0x0020001000200020, 0x0020001000300030, 0x0020000000200030, 0x0020000000300020,
+		0x0030001000000020, 0x0020001000000030, 0x0020001000100020, 0x0030000000100030,
+		0x0030000000000030, 0x0020000000000020, 0x0030000000100020, 0x0030001000000030,
+		0x0020000000100030, 0x0030001000100020, 0x0030001000100030, 0x0030000000000020,
+		0x0020001000000020, 0x0020001000100030, 0x0020000000000030, 0x0020000000100020,
+		0x0010001000000000, 0x0000001000000010, 0x0000001000100000, 0x0010000000100010,
+		0x0010000000000010, 0x0000000000000000, 0x0010000000100000, 0x0010001000000010,
+		0x0000000000100010, 0x0010001000100000, 0x0010001000100010, 0x0010000000000000,
+		0x0000001000000000, 0x0000001000100010, 0x0000000000000010, 0x0000000000100000,
+		0x0030001000200000, 0x0020001000200010, 0x0020001000300000, 0x0030000000300010,
+		0x0030000000200010, 0x0020000000200000, 0x0030000000300000, 0x0030001000200010,
+		0x0020000000300010, 0x0030001000300000, 0x0030001000300010, 0x0030000000200000,
+		0x0020001000200000, 0x0020001000300010, 0x0020000000200010, 0x0020000000300000,
+		0x0030003000000020, 0x0020003000000030, 0x0020003000100020, 0x0030002000100030,
+		0x0030002000000030, 0x0020002000000020, 0x0030002000100020, 0x0030003000000030,
+		0x0020002000100030, 0x0030003000100020, 0x0030003000100030, 0x0030002000000020,
+		0x0020003000000020, 0x0020003000100030, 0x0020002000000030, 0x0020002000100020,
+		0x0010001000200020, 0x0000001000200030, 0x0000001000300020, 0x0010000000300030,
+		0x0010000000200030, 0x0000000000200020, 0x0010000000300020, 0x0010001000200030,
+		0x0000000000300030, 0x0010001000300020, 0x0010001000300030, 0x0010000000200020,
+		0x0000001000200020, 0x0000001000300030, 0x0000000000200030, 0x0000000000300020,
+		0x0030003000200000, 0x0020003000200010, 0x0020003000300000, 0x0030002000300010,
+		0x0030002000200010, 0x0020002000200000, 0x0030002000300000, 0x0030003000200010,
+		0x0020002000300010, 0x0030003000300000, 0x0030003000300010, 0x0030002000200000,
+		0x0020003000200000, 0x0020003000300010, 0x0020002000200010, 0x0020002000300000,
+		0x0030003000200020, 0x0020003000200030, 0x0020003000300020, 0x0030002000300030,
+		0x0030002000200030, 0x0020002000200020, 0x0030002000300020, 0x0030003000200030,
+		0x0020002000300030, 0x0030003000300020, 0x0030003000300030, 0x0030002000200020,
+		0x0020003000200020, 0x0020003000300030, 0x0020002000200030, 0x0020002000300020,
+		0x0030001000000000, 0x0020001000000010, 0x0020001000100000, 0x0030000000100010,
+		0x0030000000000010, 0x0020000000000000, 0x0030000000100000, 0x0030001000000010,
+		0x0020000000100010, 0x0030001000100000, 0x0030001000100010, 0x0030000000000000,
+		0x0020001000000000, 0x0020001000100010, 0x0020000000000010, 0x0020000000100000,
+		0x0010003000000000, 0x0000003000000010, 0x0000003000100000, 0x0010002000100010,
+		0x0010002000000010, 0x0000002000000000, 0x0010002000100000, 0x0010003000000010,
+		0x0000002000100010, 0x0010003000100000, 0x0010003000100010, 0x0010002000000000,
+		0x0000003000000000, 0x0000003000100010, 0x0000002000000010, 0x0000002000100000,
+		0x0010003000200020, 0x0000003000200030, 0x0000003000300020, 0x0010002000300030,
+		0x0010002000200030, 0x0000002000200020, 0x0010002000300020, 0x0010003000200030,
+		0x0000002000300030, 0x0010003000300020, 0x0010003000300030, 0x0010002000200020,
+		0x0000003000200020, 0x0000003000300030, 0x0000002000200030, 0x0000002000300020,
+		0x0010001000000020, 0x0000001000000030, 0x0000001000100020, 0x0010000000100030,
+		0x0010000000000030, 0x0000000000000020, 0x0010000000100020, 0x0010001000000030,
+		0x0000000000100030, 0x0010001000100020, 0x0010001000100030, 0x0010000000000020,
+		0x0000001000000020, 0x0000001000100030, 0x0000000000000030, 0x0000000000100020,
+		0x0010001000200000, 0x0000001000200010, 0x0000001000300000, 0x0010000000300010,
+		0x0010000000200010, 0x0000000000200000, 0x0010000000300000, 0x0010001000200010,
+		0x0000000000300010, 0x0010001000300000, 0x0010001000300010, 0x0010000000200000,
+		0x0000001000200000, 0x0000001000300010, 0x0000000000200010, 0x0000000000300000
+	},
+	{
+		0x00c000c000000000, 0x008000c000000040, 0x008000c000400000, 0x00c0008000400040,
+		0x00c0008000000040, 0x0080008000000000, 0x00c0008000400000, 0x00c000c000000040,
+		0x0080008000400040, 0x00c000c000400000, 0x00c000c000400040, 0x00c0008000000000,
+		0x008000c000000000, 0x008000c000400040, 0x0080008000000040, 0x0080008000400000,
+		0x004000c000000080, 0x000000c0000000c0, 0x000000c000400080, 0x00400080004000c0,
+		0x00400080000000c0, 0x0000008000000080, 0x0040008000400080, 0x004000c0000000c0,
+		0x00000080004000c0, 0x004000c000400080, 0x004000c0004000c0, 0x0040008000000080,
+		0x000000c000000080, 0x000000c0004000c0, 0x00000080000000c0, 0x0000008000400080,
+		0x004000c000800000, 0x000000c000800040, 0x000000c000c00000, 0x0040008000c00040,
+		0x0040008000800040, 0x0000008000800000, 0x0040008000c00000, 0x004000c000800040,
+		0x0000008000c00040, 0x004000c000c00000, 0x004000c000c00040, 0x0040008000800000,
+		0x000000c000800000, 0x000000c000c00040, 0x0000008000800040, 0x0000008000c00000,
+		0x00c0004000800080, 0x00800040008000c0, 0x0080004000c00080, 0x00c0000000c000c0,
+		0x00c00000008000c0, 0x0080000000800080, 0x00c0000000c00080, 0x00c00040008000c0,
+		0x0080000000c000c0, 0x00c0004000c00080, 0x00c0004000c000c0, 0x00c0000000800080,
+		0x0080004000800080, 0x0080004000c000c0, 0x00800000008000c0, 0x0080000000c00080,
+		0x00c0004000000080, 0x00800040000000c0, 0x0080004000400080, 0x00c00000004000c0,
+		0x00c00000000000c0, 0x0080000000000080, 0x00c0000000400080, 0x00c00040000000c0,
+		0x00800000004000c0, 0x00c0004000400080, 0x00c00040004000c0, 0x00c0000000000080,
+		0x0080004000000080, 0x00800040004000c0, 0x00800000000000c0, 0x0080000000400080,
+		0x0040004000000000, 0x0000004000000040, 0x0000004000400000, 0x0040000000400040,
+		0x0040000000000040, 0x0000000000000000, 0x0040000000400000, 0x0040004000000040,
+		0x0000000000400040, 0x0040004000400000, 0x0040004000400040, 0x0040000000000000,
+		0x0000004000000000, 0x0000004000400040, 0x0000000000000040, 0x0000000000400000,
+		0x00c0004000800000, 0x0080004000800040, 0x0080004000c00000, 0x00c0000000c00040,
+		0x00c0000000800040, 0x0080000000800000, 0x00c0000000c00000, 0x00c0004000800040,
+		0x0080000000c00040, 0x00c0004000c00000, 0x00c0004000c00040, 0x00c0000000800000,
+		0x0080004000800000, 0x0080004000c00040, 0x0080000000800040, 0x0080000000c00000,
+		0x00c000c000000080, 0x008000c0000000c0, 0x008000c000400080, 0x00c00080004000c0,
+		0x00c00080000000c0, 0x0080008000000080, 0x00c0008000400080, 0x00c000c0000000c0,
+		0x00800080004000c0, 0x00c000c000400080, 0x00c000c0004000c0, 0x00c0008000000080,
+		0x008000c000000080, 0x008000c0004000c0, 0x00800080000000c0, 0x0080008000400080,
+		0x0040004000800080, 0x00000040008000c0, 0x0000004000c00080, 0x0040000000c000c0,
+		0x00400000008000c0, 0x0000000000800080, 0x0040000000c00080, 0x00400040008000c0,
+		0x0000000000c000c0, 0x0040004000c00080, 0x0040004000c000c0, 0x0040000000800080,
+		0x0000004000800080, 0x0000004000c000c0, 0x00000000008000c0, 0x0000000000c00080,
+		0x00c000c000800000, 0x008000c000800040, 0x008000c000c00000, 0x00c0008000c00040,
+		0x00c0008000800040, 0x0080008000800000, 0x00c0008000c00000, 0x00c000c000800040,
+		0x0080008000c00040, 0x00c000c000c00000, 0x00c000c000c00040, 0x00c0008000800000,
+		0x008000c000800000, 0x008000c000c00040, 0x0080008000800040, 0x0080008000c00000,
+		0x00c000c000800080, 0x008000c0008000c0, 0x008000c000c00080, 0x00c0008000c000c0,
+		0x00c00080008000c0, 0x0080008000800080, 0x00c0008000c00080, 0x00c000c0008000c0,
+		0x0080008000c000c0, 0x00c000c000c00080, 0x00c000c000c000c0, 0x00c0008000800080,
+		0x008000c000800080, 0x008000c000c000c0, 0x00800080008000c0, 0x0080008000c00080,
+		0x00c0004000000000, 0x0080004000000040, 0x0080004000400000, 0x00c0000000400040,
+		0x00c0000000000040, 0x0080000000000000, 0x00c0000000400000, 0x00c0004000000040,
+		0x0080000000400040, 0x00c0004000400000, 0x00c0004000400040, 0x00c0000000000000,
+		0x0080004000000000, 0x0080004000400040, 0x0080000000000040, 0x0080000000400000,
+		0x004000c000000000, 0x000000c000000040, 0x000000c000400000, 0x0040008000400040,
+		0x0040008000000040, 0x0000008000000000, 0x0040008000400000, 0x004000c000000040,
+		0x0000008000400040, 0x004000c000400000, 0x004000c000400040, 0x0040008000000000,
+		0x000000c000000000, 0x000000c000400040, 0x0000008000000040, 0x0000008000400000,
+		0x004000c000800080, 0x000000c0008000c0, 0x000000c000c00080, 0x0040008000c000c0,
+		0x00400080008000c0, 0x0000008000800080, 0x0040008000c00080, 0x004000c0008000c0,
+		0x0000008000c000c0, 0x004000c000c00080, 0x004000c000c000c0, 0x0040008000800080,
+		0x000000c000800080, 0x000000c000c000c0, 0x00000080008000c0, 0x0000008000c00080,
+		0x0040004000000080, 0x00000040000000c0, 0x0000004000400080, 0x00400000004000c0,
+		0x00400000000000c0, 0x0000000000000080, 0x0040000000400080, 0x00400040000000c0,
+		0x00000000004000c0, 0x0040004000400080, 0x00400040004000c0, 0x0040000000000080,
+		0x0000004000000080, 0x00000040004000c0, 0x00000000000000c0, 0x0000000000400080,
+		0x0040004000800000, 0x0000004000800040, 0x0000004000c00000, 0x0040000000c00040,
+		0x0040000000800040, 0x0000000000800000, 0x0040000000c00000, 0x0040004000800040,
+		0x0000000000c00040, 0x0040004000c00000, 0x0040004000c00040, 0x0040000000800000,
+		0x0000004000800000, 0x0000004000c00040, 0x0000000000800040, 0x0000000000c00000
+	},
+	{
+		0x0300030000000000, 0x0200030000000100, 0x0200030001000000, 0x0300020001000100,
+		0x0300020000000100, 0x0200020000000000, 0x0300020001000000, 0x0300030000000100,
+		0x0200020001000100, 0x0300030001000000, 0x0300030001000100, 0x0300020000000000,
+		0x0200030000000000, 0x0200030001000100, 0x0200020000000100, 0x0200020001000000,
+		0x0100030000000200, 0x0000030000000300, 0x0000030001000200, 0x0100020001000300,
+		0x0100020000000300, 0x0000020000000200, 0x0100020001000200, 0x0100030000000300,
+		0x0000020001000300, 0x0100030001000200, 0x0100030001000300, 0x0100020000000200,
+		0x0000030000000200, 0x0000030001000300, 0x0000020000000300, 0x0000020001000200,
+		0x0100030002000000, 0x0000030002000100, 0x0000030003000000, 0x0100020003000100,
+		0x0100020002000100, 0x0000020002000000, 0x0100020003000000, 0x0100030002000100,
+		0x0000020003000100, 0x0100030003000000, 0x0100030003000100, 0x0100020002000000,
+		0x0000030002000000, 0x0000030003000100, 0x0000020002000100, 0x0000020003000000,
+		0x0300010002000200, 0x0200010002000300, 0x0200010003000200, 0x0300000003000300,
+		0x0300000002000300, 0x0200000002000200, 0x0300000003000200, 0x0300010002000300,
+		0x0200000003000300, 0x0300010003000200, 0x0300010003000300, 0x0300000002000200,
+		0x0200010002000200, 0x0200010003000300, 0x0200000002000300, 0x0200000003000200,
+		0x0300010000000200, 0x0200010000000300, 0x0200010001000200, 0x0300000001000300,
+		0x0300000000000300, 0x0200000000000200, 0x0300000001000200, 0x0300010000000300,
+		0x0200000001000300, 0x0300010001000200, 0x0300010001000300, 0x0300000000000200,
+		0x0200010000000200, 0x0200010001000300, 0x0200000000000300, 0x0200000001000200,
+		0x0100010000000000, 0x0000010000000100, 0x0000010001000000, 0x0100000001000100,
+		0x0100000000000100, 0x0000000000000000, 0x0100000001000000, 0x0100010000000100,
+		0x0000000001000100, 0x0100010001000000, 0x0100010001000100, 0x0100000000000000,
+		0x0000010000000000, 0x0000010001000100, 0x0000000000000100, 0x0000000001000000,
+		0x0300010002000000, 0x0200010002000100, 0x0200010003000000, 0x0300000003000100,
+		0x0300000002000100, 0x0200000002000000, 0x0300000003000000, 0x0300010002000100,
+		0x0200000003000100, 0x0300010003000000, 0x0300010003000100, 0x0300000002000000,
+		0x0200010002000000, 0x0200010003000100, 0x0200000002000100, 0x0200000003000000,
+		0x0300030000000200, 0x0200030000000300, 0x0200030001000200, 0x0300020001000300,
+		0x0300020000000300, 0x0200020000000200, 0x0300020001000200, 0x0300030000000300,
+		0x0200020001000300, 0x0300030001000200, 0x0300030001000300, 0x0300020000000200,
+		0x0200030000000200, 0x0200030001000300, 0x0200020000000300, 0x0200020001000200,
+		0x0100010002000200, 0x0000010002000300, 0x0000010003000200, 0x0100000003000300,
+		0x0100000002000300, 0x0000000002000200, 0x0100000003000200, 0x0100010002000300,
+		0x0000000003000300, 0x0100010003000200, 0x0100010003000300, 0x0100000002000200,
+		0x0000010002000200, 0x0000010003000300, 0x0000000002000300, 0x0000000003000200,
+		0x0300030002000000, 0x0200030002000100, 0x0200030003000000, 0x0300020003000100,
+		0x0300020002000100, 0x0200020002000000, 0x0300020003000000, 0x0300030002000100,
+		0x0200020003000100, 0x0300030003000000, 0x0300030003000100, 0x0300020002000000,
+		0x0200030002000000, 0x0200030003000100, 0x0200020002000100, 0x0200020003000000,
+		0x0300030002000200, 0x0200030002000300, 0x0200030003000200, 0x0300020003000300,
+		0x0300020002000300, 0x0200020002000200, 0x0300020003000200, 0x0300030002000300,
+		0x0200020003000300, 0x0300030003000200, 0x0300030003000300, 0x0300020002000200,
+		0x0200030002000200, 0x0200030003000300, 0x0200020002000300, 0x0200020003000200,
+		0x0300010000000000, 0x0200010000000100, 0x0200010001000000, 0x0300000001000100,
+		0x0300000000000100, 0x0200000000000000, 0x0300000001000000, 0x0300010000000100,
+		0x0200000001000100, 0x0300010001000000, 0x0300010001000100, 0x0300000000000000,
+		0x0200010000000000, 0x0200010001000100, 0x0200000000000100, 0x0200000001000000,
+		0x0100030000000000, 0x0000030000000100, 0x0000030001000000, 0x0100020001000100,
+		0x0100020000000100, 0x0000020000000000, 0x0100020001000000, 0x0100030000000100,
+		0x0000020001000100, 0x0100030001000000, 0x0100030001000100, 0x0100020000000000,
+		0x0000030000000000, 0x0000030001000100, 0x0000020000000100, 0x0000020001000000,
+		0x0100030002000200, 0x0000030002000300, 0x0000030003000200, 0x0100020003000300,
+		0x0100020002000300, 0x0000020002000200, 0x0100020003000200, 0x0100030002000300,
+		0x0000020003000300, 0x0100030003000200, 0x0100030003000300, 0x0100020002000200,
+		0x0000030002000200, 0x0000030003000300, 0x0000020002000300, 0x0000020003000200,
+		0x0100010000000200, 0x0000010000000300, 0x0000010001000200, 0x0100000001000300,
+		0x0100000000000300, 0x0000000000000200, 0x0100000001000200, 0x0100010000000300,
+		0x0000000001000300, 0x0100010001000200, 0x0100010001000300, 0x0100000000000200,
+		0x0000010000000200, 0x0000010001000300, 0x0000000000000300, 0x0000000001000200,
+		0x0100010002000000, 0x0000010002000100, 0x0000010003000000, 0x0100000003000100,
+		0x0100000002000100, 0x0000000002000000, 0x0100000003000000, 0x0100010002000100,
+		0x0000000003000100, 0x0100010003000000, 0x0100010003000100, 0x0100000002000000,
+		0x0000010002000000, 0x0000010003000100, 0x0000000002000100, 0x0000000003000000
+	},
+	{
+		0x0c000c0000000000, 0x08000c0000000400, 0x08000c0004000000, 0x0c00080004000400,
+		0x0c00080000000400, 0x0800080000000000, 0x0c00080004000000, 0x0c000c0000000400,
+		0x0800080004000400, 0x0c000c0004000000, 0x0c000c0004000400, 0x0c00080000000000,
+		0x08000c0000000000, 0x08000c0004000400, 0x0800080000000400, 0x0800080004000000,
+		0x04000c0000000800, 0x00000c0000000c00, 0x00000c0004000800, 0x0400080004000c00,
+		0x0400080000000c00, 0x0000080000000800, 0x0400080004000800, 0x04000c0000000c00,
+		0x0000080004000c00, 0x04000c0004000800, 0x04000c0004000c00, 0x0400080000000800,
+		0x00000c0000000800, 0x00000c0004000c00, 0x0000080000000c00, 0x0000080004000800,
+		0x04000c0008000000, 0x00000c0008000400, 0x00000c000c000000, 0x040008000c000400,
+		0x0400080008000400, 0x0000080008000000, 0x040008000c000000, 0x04000c0008000400,
+		0x000008000c000400, 0x04000c000c000000, 0x04000c000c000400, 0x0400080008000000,
+		0x00000c0008000000, 0x00000c000c000400, 0x0000080008000400, 0x000008000c000000,
+		0x0c00040008000800, 0x0800040008000c00, 0x080004000c000800, 0x0c0000000c000c00,
+		0x0c00000008000c00, 0x0800000008000800, 0x0c0000000c000800, 0x0c00040008000c00,
+		0x080000000c000c00, 0x0c0004000c000800, 0x0c0004000c000c00, 0x0c00000008000800,
+		0x0800040008000800, 0x080004000c000c00, 0x0800000008000c00, 0x080000000c000800,
+		0x0c00040000000800, 0x0800040000000c00, 0x0800040004000800, 0x0c00000004000c00,
+		0x0c00000000000c00, 0x0800000000000800, 0x0c00000004000800, 0x0c00040000000c00,
+		0x0800000004000c00, 0x0c00040004000800, 0x0c00040004000c00, 0x0c00000000000800,
+		0x0800040000000800, 0x0800040004000c00, 0x0800000000000c00, 0x0800000004000800,
+		0x0400040000000000, 0x0000040000000400, 0x0000040004000000, 0x0400000004000400,
+		0x0400000000000400, 0x0000000000000000, 0x0400000004000000, 0x0400040000000400,
+		0x0000000004000400, 0x0400040004000000, 0x0400040004000400, 0x0400000000000000,
+		0x0000040000000000, 0x0000040004000400, 0x0000000000000400, 0x0000000004000000,
+		0x0c00040008000000, 0x0800040008000400, 0x080004000c000000, 0x0c0000000c000400,
+		0x0c00000008000400, 0x0800000008000000, 0x0c0000000c000000, 0x0c00040008000400,
+		0x080000000c000400, 0x0c0004000c000000, 0x0c0004000c000400, 0x0c00000008000000,
+		0x0800040008000000, 0x080004000c000400, 0x0800000008000400, 0x080000000c000000,
+		0x0c000c0000000800, 0x08000c0000000c00, 0x08000c0004000800, 0x0c00080004000c00,
+		0x0c00080000000c00, 0x0800080000000800, 0x0c00080004000800, 0x0c000c0000000c00,
+		0x0800080004000c00, 0x0c000c0004000800, 0x0c000c0004000c00, 0x0c00080000000800,
+		0x08000c0000000800, 0x08000c0004000c00, 0x0800080000000c00, 0x0800080004000800,
+		0x0400040008000800, 0x0000040008000c00, 0x000004000c000800, 0x040000000c000c00,
+		0x0400000008000c00, 0x0000000008000800, 0x040000000c000800, 0x0400040008000c00,
+		0x000000000c000c00, 0x040004000c000800, 0x040004000c000c00, 0x0400000008000800,
+		0x0000040008000800, 0x000004000c000c00, 0x0000000008000c00, 0x000000000c000800,
+		0x0c000c0008000000, 0x08000c0008000400, 0x08000c000c000000, 0x0c0008000c000400,
+		0x0c00080008000400, 0x0800080008000000, 0x0c0008000c000000, 0x0c000c0008000400,
+		0x080008000c000400, 0x0c000c000c000000, 0x0c000c000c000400, 0x0c00080008000000,
+		0x08000c0008000000, 0x08000c000c000400, 0x0800080008000400, 0x080008000c000000,
+		0x0c000c0008000800, 0x08000c0008000c00, 0x08000c000c000800, 0x0c0008000c000c00,
+		0x0c00080008000c00, 0x0800080008000800, 0x0c0008000c000800, 0x0c000c0008000c00,
+		0x080008000c000c00, 0x0c000c000c000800, 0x0c000c000c000c00, 0x0c00080008000800,
+		0x08000c0008000800, 0x08000c000c000c00, 0x0800080008000c00, 0x080008000c000800,
+		0x0c00040000000000, 0x0800040000000400, 0x0800040004000000, 0x0c00000004000400,
+		0x0c00000000000400, 0x0800000000000000, 0x0c00000004000000, 0x0c00040000000400,
+		0x0800000004000400, 0x0c00040004000000, 0x0c00040004000400, 0x0c00000000000000,
+		0x0800040000000000, 0x0800040004000400, 0x0800000000000400, 0x0800000004000000,
+		0x04000c0000000000, 0x00000c0000000400, 0x00000c0004000000, 0x0400080004000400,
+		0x0400080000000400, 0x0000080000000000, 0x0400080004000000, 0x04000c0000000400,
+		0x0000080004000400, 0x04000c0004000000, 0x04000c0004000400, 0x0400080000000000,
+		0x00000c0000000000, 0x00000c0004000400, 0x0000080000000400, 0x0000080004000000,
+		0x04000c0008000800, 0x00000c0008000c00, 0x00000c000c000800, 0x040008000c000c00,
+		0x0400080008000c00, 0x0000080008000800, 0x040008000c000800, 0x04000c0008000c00,
+		0x000008000c000c00, 0x04000c000c000800, 0x04000c000c000c00, 0x0400080008000800,
+		0x00000c0008000800, 0x00000c000c000c00, 0x0000080008000c00, 0x000008000c000800,
+		0x0400040000000800, 0x0000040000000c00, 0x0000040004000800, 0x0400000004000c00,
+		0x0400000000000c00, 0x0000000000000800, 0x0400000004000800, 0x0400040000000c00,
+		0x0000000004000c00, 0x0400040004000800, 0x0400040004000c00, 0x0400000000000800,
+		0x0000040000000800, 0x0000040004000c00, 0x0000000000000c00, 0x0000000004000800,
+		0x0400040008000000, 0x0000040008000400, 0x000004000c000000, 0x040000000c000400,
+		0x0400000008000400, 0x0000000008000000, 0x040000000c000000, 0x0400040008000400,
+		0x000000000c000400, 0x040004000c000000, 0x040004000c000400, 0x0400000008000000,
+		0x0000040008000000, 0x000004000c000400, 0x0000000008000400, 0x000000000c000000
+	},
+	{
+		0x3000300000000000, 0x2000300000001000, 0x2000300010000000, 0x3000200010001000,
+		0x3000200000001000, 0x2000200000000000, 0x3000200010000000, 0x3000300000001000,
+		0x2000200010001000, 0x3000300010000000, 0x3000300010001000, 0x3000200000000000,
+		0x2000300000000000, 0x2000300010001000, 0x2000200000001000, 0x2000200010000000,
+		0x1000300000002000, 0x0000300000003000, 0x0000300010002000, 0x1000200010003000,
+		0x1000200000003000, 0x0000200000002000, 0x1000200010002000, 0x1000300000003000,
+		0x0000200010003000, 0x1000300010002000, 0x1000300010003000, 0x1000200000002000,
+		0x0000300000002000, 0x0000300010003000, 0x0000200000003000, 0x0000200010002000,
+		0x1000300020000000, 0x0000300020001000, 0x0000300030000000, 0x1000200030001000,
+		0x1000200020001000, 0x0000200020000000, 0x1000200030000000, 0x1000300020001000,
+		0x0000200030001000, 0x1000300030000000, 0x1000300030001000, 0x1000200020000000,
+		0x0000300020000000, 0x0000300030001000, 0x0000200020001000, 0x0000200030000000,
+		0x3000100020002000, 0x2000100020003000, 0x2000100030002000, 0x3000000030003000,
+		0x3000000020003000, 0x2000000020002000, 0x3000000030002000, 0x3000100020003000,
+		0x2000000030003000, 0x3000100030002000, 0x3000100030003000, 0x3000000020002000,
+		0x2000100020002000, 0x2000100030003000, 0x2000000020003000, 0x2000000030002000,
+		0x3000100000002000, 0x2000100000003000, 0x2000100010002000, 0x3000000010003000,
+		0x3000000000003000, 0x2000000000002000, 0x3000000010002000, 0x3000100000003000,
+		0x2000000010003000, 0x3000100010002000, 0x3000100010003000, 0x3000000000002000,
+		0x2000100000002000, 0x2000100010003000, 0x2000000000003000, 0x2000000010002000,
+		0x1000100000000000, 0x0000100000001000, 0x0000100010000000, 0x1000000010001000,
+		0x1000000000001000, 0x0000000000000000, 0x1000000010000000, 0x1000100000001000,
+		0x0000000010001000, 0x1000100010000000, 0x1000100010001000, 0x1000000000000000,
+		0x0000100000000000, 0x0000100010001000, 0x0000000000001000, 0x0000000010000000,
+		0x3000100020000000, 0x2000100020001000, 0x2000100030000000, 0x3000000030001000,
+		0x3000000020001000, 0x2000000020000000, 0x3000000030000000, 0x3000100020001000,
+		0x2000000030001000, 0x3000100030000000, 0x3000100030001000, 0x3000000020000000,
+		0x2000100020000000, 0x2000100030001000, 0x2000000020001000, 0x2000000030000000,
+		0x3000300000002000, 0x2000300000003000, 0x2000300010002000, 0x3000200010003000,
+		0x3000200000003000, 0x2000200000002000, 0x3000200010002000, 0x3000300000003000,
+		0x2000200010003000, 0x3000300010002000, 0x3000300010003000, 0x3000200000002000,
+		0x2000300000002000, 0x2000300010003000, 0x2000200000003000, 0x2000200010002000,
+		0x1000100020002000, 0x0000100020003000, 0x0000100030002000, 0x1000000030003000,
+		0x1000000020003000, 0x0000000020002000, 0x1000000030002000, 0x1000100020003000,
+		0x0000000030003000, 0x1000100030002000, 0x1000100030003000, 0x1000000020002000,
+		0x0000100020002000, 0x0000100030003000, 0x0000000020003000, 0x0000000030002000,
+		0x3000300020000000, 0x2000300020001000, 0x2000300030000000, 0x3000200030001000,
+		0x3000200020001000, 0x2000200020000000, 0x3000200030000000, 0x3000300020001000,
+		0x2000200030001000, 0x3000300030000000, 0x3000300030001000, 0x3000200020000000,
+		0x2000300020000000, 0x2000300030001000, 0x2000200020001000, 0x2000200030000000,
+		0x3000300020002000, 0x2000300020003000, 0x2000300030002000, 0x3000200030003000,
+		0x3000200020003000, 0x2000200020002000, 0x3000200030002000, 0x3000300020003000,
+		0x2000200030003000, 0x3000300030002000, 0x3000300030003000, 0x3000200020002000,
+		0x2000300020002000, 0x2000300030003000, 0x2000200020003000, 0x2000200030002000,
+		0x3000100000000000, 0x2000100000001000, 0x2000100010000000, 0x3000000010001000,
+		0x3000000000001000, 0x2000000000000000, 0x3000000010000000, 0x3000100000001000,
+		0x2000000010001000, 0x3000100010000000, 0x3000100010001000, 0x3000000000000000,
+		0x2000100000000000, 0x2000100010001000, 0x2000000000001000, 0x2000000010000000,
+		0x1000300000000000, 0x0000300000001000, 0x0000300010000000, 0x1000200010001000,
+		0x1000200000001000, 0x0000200000000000, 0x1000200010000000, 0x1000300000001000,
+		0x0000200010001000, 0x1000300010000000, 0x1000300010001000, 0x1000200000000000,
+		0x0000300000000000, 0x0000300010001000, 0x0000200000001000, 0x0000200010000000,
+		0x1000300020002000, 0x0000300020003000, 0x0000300030002000, 0x1000200030003000,
+		0x1000200020003000, 0x0000200020002000, 0x1000200030002000, 0x1000300020003000,
+		0x0000200030003000, 0x1000300030002000, 0x1000300030003000, 0x1000200020002000,
+		0x0000300020002000, 0x0000300030003000, 0x0000200020003000, 0x0000200030002000,
+		0x1000100000002000, 0x0000100000003000, 0x0000100010002000, 0x1000000010003000,
+		0x1000000000003000, 0x0000000000002000, 0x1000000010002000, 0x1000100000003000,
+		0x0000000010003000, 0x1000100010002000, 0x1000100010003000, 0x1000000000002000,
+		0x0000100000002000, 0x0000100010003000, 0x0000000000003000, 0x0000000010002000,
+		0x1000100020000000, 0x0000100020001000, 0x0000100030000000, 0x1000000030001000,
+		0x1000000020001000, 0x0000000020000000, 0x1000000030000000, 0x1000100020001000,
+		0x0000000030001000, 0x1000100030000000, 0x1000100030001000, 0x1000000020000000,
+		0x0000100020000000, 0x0000100030001000, 0x0000000020001000, 0x0000000030000000
+	},
+	{
+		0xc000c00000000000, 0x8000c00000004000, 0x8000c00040000000, 0xc000800040004000,
+		0xc000800000004000, 0x8000800000000000, 0xc000800040000000, 0xc000c00000004000,
+		0x8000800040004000, 0xc000c00040000000, 0xc000c00040004000, 0xc000800000000000,
+		0x8000c00000000000, 0x8000c00040004000, 0x8000800000004000, 0x8000800040000000,
+		0x4000c00000008000, 0x0000c0000000c000, 0x0000c00040008000, 0x400080004000c000,
+		0x400080000000c000, 0x0000800000008000, 0x4000800040008000, 0x4000c0000000c000,
+		0x000080004000c000, 0x4000c00040008000, 0x4000c0004000c000, 0x4000800000008000,
+		0x0000c00000008000, 0x0000c0004000c000, 0x000080000000c000, 0x0000800040008000,
+		0x4000c00080000000, 0x0000c00080004000, 0x0000c000c0000000, 0x40008000c0004000,
+		0x4000800080004000, 0x0000800080000000, 0x40008000c0000000, 0x4000c00080004000,
+		0x00008000c0004000, 0x4000c000c0000000, 0x4000c000c0004000, 0x4000800080000000,
+		0x0000c00080000000, 0x0000c000c0004000, 0x0000800080004000, 0x00008000c0000000,
+		0xc000400080008000, 0x800040008000c000, 0x80004000c0008000, 0xc0000000c000c000,
+		0xc00000008000c000, 0x8000000080008000, 0xc0000000c0008000, 0xc00040008000c000,
+		0x80000000c000c000, 0xc0004000c0008000, 0xc0004000c000c000, 0xc000000080008000,
+		0x8000400080008000, 0x80004000c000c000, 0x800000008000c000, 0x80000000c0008000,
+		0xc000400000008000, 0x800040000000c000, 0x8000400040008000, 0xc00000004000c000,
+		0xc00000000000c000, 0x8000000000008000, 0xc000000040008000, 0xc00040000000c000,
+		0x800000004000c000, 0xc000400040008000, 0xc00040004000c000, 0xc000000000008000,
+		0x8000400000008000, 0x800040004000c000, 0x800000000000c000, 0x8000000040008000,
+		0x4000400000000000, 0x0000400000004000, 0x0000400040000000, 0x4000000040004000,
+		0x4000000000004000, 0x0000000000000000, 0x4000000040000000, 0x4000400000004000,
+		0x0000000040004000, 0x4000400040000000, 0x4000400040004000, 0x4000000000000000,
+		0x0000400000000000, 0x0000400040004000, 0x0000000000004000, 0x0000000040000000,
+		0xc000400080000000, 0x8000400080004000, 0x80004000c0000000, 0xc0000000c0004000,
+		0xc000000080004000, 0x8000000080000000, 0xc0000000c0000000, 0xc000400080004000,
+		0x80000000c0004000, 0xc0004000c0000000, 0xc0004000c0004000, 0xc000000080000000,
+		0x8000400080000000, 0x80004000c0004000, 0x8000000080004000, 0x80000000c0000000,
+		0xc000c00000008000, 0x8000c0000000c000, 0x8000c00040008000, 0xc00080004000c000,
+		0xc00080000000c000, 0x8000800000008000, 0xc000800040008000, 0xc000c0000000c000,
+		0x800080004000c000, 0xc000c00040008000, 0xc000c0004000c000, 0xc000800000008000,
+		0x8000c00000008000, 0x8000c0004000c000, 0x800080000000c000, 0x8000800040008000,
+		0x4000400080008000, 0x000040008000c000, 0x00004000c0008000, 0x40000000c000c000,
+		0x400000008000c000, 0x0000000080008000, 0x40000000c0008000, 0x400040008000c000,
+		0x00000000c000c000, 0x40004000c0008000, 0x40004000c000c000, 0x4000000080008000,
+		0x0000400080008000, 0x00004000c000c000, 0x000000008000c000, 0x00000000c0008000,
+		0xc000c00080000000, 0x8000c00080004000, 0x8000c000c0000000, 0xc0008000c0004000,
+		0xc000800080004000, 0x8000800080000000, 0xc0008000c0000000, 0xc000c00080004000,
+		0x80008000c0004000, 0xc000c000c0000000, 0xc000c000c0004000, 0xc000800080000000,
+		0x8000c00080000000, 0x8000c000c0004000, 0x8000800080004000, 0x80008000c0000000,
+		0xc000c00080008000, 0x8000c0008000c000, 0x8000c000c0008000, 0xc0008000c000c000,
+		0xc00080008000c000, 0x8000800080008000, 0xc0008000c0008000, 0xc000c0008000c000,
+		0x80008000c000c000, 0xc000c000c0008000, 0xc000c000c000c000, 0xc000800080008000,
+		0x8000c00080008000, 0x8000c000c000c000, 0x800080008000c000, 0x80008000c0008000,
+		0xc000400000000000, 0x8000400000004000, 0x8000400040000000, 0xc000000040004000,
+		0xc000000000004000, 0x8000000000000000, 0xc000000040000000, 0xc000400000004000,
+		0x8000000040004000, 0xc000400040000000, 0xc000400040004000, 0xc000000000000000,
+		0x8000400000000000, 0x8000400040004000, 0x8000000000004000, 0x8000000040000000,
+		0x4000c00000000000, 0x0000c00000004000, 0x0000c00040000000, 0x4000800040004000,
+		0x4000800000004000, 0x0000800000000000, 0x4000800040000000, 0x4000c00000004000,
+		0x0000800040004000, 0x4000c00040000000, 0x4000c00040004000, 0x4000800000000000,
+		0x0000c00000000000, 0x0000c00040004000, 0x0000800000004000, 0x0000800040000000,
+		0x4000c00080008000, 0x0000c0008000c000, 0x0000c000c0008000, 0x40008000c000c000,
+		0x400080008000c000, 0x0000800080008000, 0x40008000c0008000, 0x4000c0008000c000,
+		0x00008000c000c000, 0x4000c000c0008000, 0x4000c000c000c000, 0x4000800080008000,
+		0x0000c00080008000, 0x0000c000c000c000, 0x000080008000c000, 0x00008000c0008000,
+		0x4000400000008000, 0x000040000000c000, 0x0000400040008000, 0x400000004000c000,
+		0x400000000000c000, 0x0000000000008000, 0x4000000040008000, 0x400040000000c000,
+		0x000000004000c000, 0x4000400040008000, 0x400040004000c000, 0x4000000000008000,
+		0x0000400000008000, 0x000040004000c000, 0x000000000000c000, 0x0000000040008000,
+		0x4000400080000000, 0x0000400080004000, 0x00004000c0000000, 0x40000000c0004000,
+		0x4000000080004000, 0x0000000080000000, 0x40000000c0000000, 0x4000400080004000,
+		0x00000000c0004000, 0x40004000c0000000, 0x40004000c0004000, 0x4000000080000000,
+		0x0000400080000000, 0x00004000c0004000, 0x0000000080004000, 0x00000000c0000000
+	}
+};
+
+// inverse s-box followed by the inverse permutation layer for each byte of the state
+static const uint64_t inverseSpBox[8][256] =
+{
+	{
+		0x0000000001010101, 0x0000000001011110, 0x0000000001011111, 0x0000000001011000,
+		0x0000000001011100, 0x0000000001010001, 0x0000000001010010, 0x0000000001011101,
+		0x0000000001011011, 0x0000000001010100, 0x0000000001010110, 0x0000000001010011,
+		0x0000000001010000, 0x0000000001010111, 0x0000000001011001, 0x0000000001011010,
+		0x0000000011100101, 0x0000000011101110, 0x0000000011101111, 0x0000000011101000,
+		0x0000000011101100, 0x0000000011100001, 0x0000000011100010, 0x0000000011101101,
+		0x0000000011101011, 0x0000000011100100, 0x0000000011100110, 0x0000000011100011,
+		0x0000000011100000, 0x0000000011100111, 0x0000000011101001, 0x0000000011101010,
+		0x0000000011110101, 0x0000000011111110, 0x0000000011111111, 0x0000000011111000,
+		0x0000000011111100, 0x0000000011110001, 0x0000000011110010, 0x0000000011111101,
+		0x0000000011111011, 0x0000000011110100, 0x0000000011110110, 0x0000000011110011,
+		0x0000000011110000, 0x0000000011110111, 0x0000000011111001, 0x0000000011111010,
+		0x0000000010000101, 0x0000000010001110, 0x0000000010001111, 0x0000000010001000,
+		0x0000000010001100, 0x0000000010000001, 0x0000000010000010, 0x0000000010001101,
+		0x0000000010001011, 0x0000000010000100, 0x0000000010000110, 0x0000000010000011,
+		0x0000000010000000, 0x0000000010000111, 0x0000000010001001, 0x0000000010001010,
+		0x0000000011000101, 0x0000000011001110, 0x0000000011001111, 0x0000000011001000,
+		0x0000000011001100, 0x0000000011000001, 0x0000000011000010, 0x0000000011001101,
+		0x0000000011001011, 0x0000000011000100, 0x0000000011000110, 0x0000000011000011,
+		0x0000000011000000, 0x0000000011000111, 0x0000000011001001, 0x0000000011001010,
+		0x0000000000010101, 0x0000000000011110, 0x0000000000011111, 0x0000000000011000,
+		0x0000000000011100, 0x0000000000010001, 0x0000000000010010, 0x0000000000011101,
+		0x0000000000011011, 0x0000000000010100, 0x0000000000010110, 0x0000000000010011,
+		0x0000000000010000, 0x0000000000010111, 0x0000000000011001, 0x0000000000011010,
+		0x0000000000100101, 0x0000000000101110, 0x0000000000101111, 0x0000000000101000,
+		0x0000000000101100, 0x0000000000100001, 0x0000000000100010, 0x0000000000101101,
+		0x0000000000101011, 0x0000000000100100, 0x0000000000100110, 0x0000000000100011,
+		0x0000000000100000, 0x0000000000100111, 0x0000000000101001, 0x0000000000101010,
+		0x0000000011010101, 0x0000000011011110, 0x0000000011011111, 0x0000000011011000,
+		0x0000000011011100, 0x0000000011010001, 0x0000000011010010, 0x0000000011011101,
+		0x0000000011011011, 0x0000000011010100, 0x0000000011010110, 0x0000000011010011,
+		0x0000000011010000, 0x0000000011010111, 0x0000000011011001, 0x0000000011011010,
+		0x0000000010110101, 0x0000000010111110, 0x0000000010111111, 0x0000000010111000,
+		0x0000000010111100, 0x0000000010110001, 0x0000000010110010, 0x0000000010111101,
+		0x0000000010111011, 0x0000000010110100, 0x0000000010110110, 0x0000000010110011,
+		0x0000000010110000, 0x0000000010110111, 0x0000000010111001, 0x0000000010111010,
+		0x0000000001000101, 0x0000000001001110, 0x0000000001001111, 0x0000000001001000,
+		0x0000000001001100, 0x0000000001000001, 0x0000000001000010, 0x0000000001001101,
+		0x0000000001001011, 0x0000000001000100, 0x0000000001000110, 0x0000000001000011,
+		0x0000000001000000, 0x0000000001000111, 0x0000000001001001, 0x0000000001001010,
+		0x0000000001100101, 0x0000000001101110, 0x0000000001101111, 0x0000000001101000,
+		0x0000000001101100, 0x0000000001100001, 0x0000000001100010, 0x0000000001101101,
+		0x0000000001101011, 0x0000000001100100, 0x0000000001100110, 0x0000000001100011,
+		0x0000000001100000, 0x0000000001100111, 0x0000000001101001, 0x0000000001101010,
+		0x0000000000110101, 0x0000000000111110, 0x0000000000111111, 0x0000000000111000,
+		0x0000000000111100, 0x0000000000110001, 0x0000000000110010, 0x0000000000111101,
+		0x0000000000111011, 0x0000000000110100, 0x0000000000110110, 0x0000000000110011,
+		0x0000000000110000, 0x0000000000110111, 0x0000000000111001, 0x0000000000111010,
+		0x0000000000000101, 0x0000000000001110, 0x0000000000001111, 0x0000000000001000,
+		0x0000000000001100, 0x0000000000000001, 0x0000000000000010, 0x0000000000001101,
+		0x0000000000001011, 0x0000000000000100, 0x0000000000000110, 0x0000000000000011,
+		0x0000000000000000, 0x0000000000000111, 0x0000000000001001, 0x0000000000001010,
+		0x0000000001110101, 0x0000000001111110, 0x0000000001111111, 0x0000000001111000,
+		0x0000000001111100, 0x0000000001110001, 0x0000000001110010, 0x0000000001111101,
+		0x0000000001111011, 0x0000000001110100, 0x0000000001110110, 0x0000000001110011,
+		0x0000000001110000, 0x0000000001110111, 0x0000000001111001, 0x0000000001111010,
+		0x0000000010010101, 0x0000000010011110, 0x0000000010011111, 0x0000000010011000,
+		0x0000000010011100, 0x0000000010010001, 0x0000000010010010, 0x0000000010011101,
+		0x0000000010011011, 0x0000000010010100, 0x0000000010010110, 0x0000000010010011,
+		0x0000000010010000, 0x0000000010010111, 0x0000000010011001, 0x0000000010011010,
+		0x0000000010100101, 0x0000000010101110, 0x0000000010101111, 0x0000000010101000,
+		0x0000000010101100, 0x0000000010100001, 0x0000000010100010, 0x0000000010101101,
+		0x0000000010101011, 0x0000000010100100, 0x0000000010100110, 0x0000000010100011,
+		0x0000000010100000, 0x0000000010100111, 0x0000000010101001, 0x0000000010101010
+	},
+	{
+		0x0101010100000000, 0x0101111000000000, 0x0101111100000000, 0x0101100000000000,
+		0x0101110000000000, 0x0101000100000000, 0x0101001000000000, 0x0101110100000000,
+		0x0101101100000000, 0x0101010000000000, 0x0101011000000000, 0x0101001100000000,
+		0x0101000000000000, 0x0101011100000000, 0x0101100100000000, 0x0101101000000000,
+		0x1110010100000000, 0x1110111000000000, 0x1110111100000000, 0x1110100000000000,
+		0x1110110000000000, 0x1110000100000000, 0x1110001000000000, 0x1110110100000000,
+		0x1110101100000000, 0x1110010000000000, 0x1110011000000000, 0x1110001100000000,
+		0x1110000000000000, 0x1110011100000000, 0x1110100100000000, 0x1110101000000000,
+		0x1111010100000000, 0x1111111000000000, 0x1111111100000000, 0x1111100000000000,
+		0x1111110000000000, 0x1111000100000000, 0x1111001000000000, 0x1111110100000000,
+		0x1111101100000000, 0x1111010000000000, 0x1111011000000000, 0x1111001100000000,
+		0x1111000000000000, 0x1111011100000000, 0x1111100100000000, 0x1111101000000000,
+		0x1000010100000000, 0x1000111000000000, 0x1000111100000000, 0x1000100000000000,
+		0x1000110000000000, 0x1000000100000000, 0x1000001000000000, 0x1000110100000000,
+		0x1000101100000000, 0x1000010000000000, 0x1000011000000000, 0x1000001100000000,
+		0x1000000000000000, 0x1000011100000000, 0x1000100100000000, 0x1000101000000000,
+		0x1100010100000000, 0x1100111000000000, 0x1100111100000000, 0x1100100000000000,
+		0x1100110000000000, 0x1100000100000000, 0x1100001000000000, 0x1100110100000000,
+		0x1100101100000000, 0x1100010000000000, 0x1100011000000000, 0x1100001100000000,
+		0x1100000000000000, 0x1100011100000000, 0x1100100100000000, 0x1100101000000000,
+		0x0001010100000000, 0x0001111000000000, 0x0001111100000000, 0x0001100000000000,
+		0x0001110000000000, 0x0001000100000000, 0x0001001000000000, 0x0001110100000000,
+		0x0001101100000000, 0x0001010000000000, 0x0001011000000000, 0x0001001100000000,
+		0x0001000000000000, 0x0001011100000000, 0x0001100100000000, 0x0001101000000000,
+		0x0010010100000000, 0x0010111000000000, 0x0010111100000000, 0x0010100000000000,
+		0x0010110000000000, 0x0010000100000000, 0x0010001000000000, 0x0010110100000000,
+		0x0010101100000000, 0x0010010000000000, 0x0010011000000000, 0x0010001100000000,
+		0x0010000000000000, 0x0010011100000000, 0x0010100100000000, 0x0010101000000000,
+		0x1101010100000000, 0x1101111000000000, 0x1101111100000000, 0x1101100000000000,
+		0x1101110000000000, 0x1101000100000000, 0x1101001000000000, 0x1101110100000000,
+		0x1101101100000000, 0x1101010000000000, 0x1101011000000000, 0x1101001100000000,
+		0x1101000000000000, 0x1101011100000000, 0x1101100100000000, 0x1101101000000000,
+		0x1011010100000000, 0x1011111000000000, 0x1011111100000000, 0x1011100000000000,
+		0x1011110000000000, 0x1011000100000000, 0x1011001000000000, 0x1011110100000000,
+		0x1011101100000000, 0x1011010000000000, 0x1011011000000000, 0x1011001100000000,
+		0x1011000000000000, 0x1011011100000000, 0x1011100100000000, 0x1011101000000000,
+		0x0100010100000000, 0x0100111000000000, 0x0100111100000000, 0x0100100000000000,
+		0x0100110000000000, 0x0100000100000000, 0x0100001000000000, 0x0100110100000000,
+		0x0100101100000000, 0x0100010000000000, 0x0100011000000000, 0x0100001100000000,
+		0x0100000000000000, 0x0100011100000000, 0x0100100100000000, 0x0100101000000000,
+		0x0110010100000000, 0x0110111000000000, 0x0110111100000000, 0x0110100000000000,
+		0x0110110000000000, 0x0110000100000000, 0x0110001000000000, 0x0110110100000000,
+		0x0110101100000000, 0x0110010000000000, 0x0110011000000000, 0x0110001100000000,
+		0x0110000000000000, 0x0110011100000000, 0x0110100100000000, 0x0110101000000000,
+		0x0011010100000000, 0x0011111000000000, 0x0011111100000000, 0x0011100000000000,
+		0x0011110000000000, 0x0011000100000000, 0x0011001000000000, 0x0011110100000000,
+		0x0011101100000000, 0x0011010000000000, 0x0011011000000000, 0x0011001100000000,
+		0x0011000000000000, 0x0011011100000000, 0x0011100100000000, 0x0011101000000000,
+		0x0000010100000000, 0x0000111000000000, 0x0000111100000000, 0x0000100000000000,
+		0x0000110000000000, 0x0000000100000000, 0x0000001000000000, 0x0000110100000000,
+		0x0000101100000000, 0x0000010000000000, 0x0000011000000000, 0x0000001100000000,
+		0x0000000000000000, 0x0000011100000000, 0x0000100100000000, 0x0000101000000000,
+		0x0111010100000000, 0x0111111000000000, 0x0111111100000000, 0x0111100000000000,
+		0x0111110000000000, 0x0111000100000000, 0x0111001000000000, 0x0111110100000000,
+		0x0111101100000000, 0x0111010000000000, 0x0111011000000000, 0x0111001100000000,
+		0x0111000000000000, 0x0111011100000000, 0x0111100100000000, 0x0111101000000000,
+		0x1001010100000000, 0x1001111000000000, 0x1001111100000000, 0x1001100000000000,
+		0x1001110000000000, 0x1001000100000000, 0x1001001000000000, 0x1001110100000000,
+		0x1001101100000000, 0x1001010000000000, 0x1001011000000000, 0x1001001100000000,
+		0x1001000000000000, 0x1001011100000000, 0x1001100100000000, 0x1001101000000000,
+		0x1010010100000000, 0x1010111000000000, 0x1010111100000000, 0x1010100000000000,
+		0x1010110000000000, 0x1010000100000000, 0x1010001000000000, 0x1010110100000000,
+		0x1010101100000000, 0x1010010000000000, 0x1010011000000000, 0x1010001100000000,
+		0x1010000000000000, 0x1010011100000000, 0x1010100100000000, 0x1010101000000000
+	},
+	{
+		0x0000000002020202, 0x0000000002022220, 0x0000000002022222, 0x0000000002022000,
+		0x0000000002022200, 0x0000000002020002, 0x0000000002020020, 0x0000000002022202,
+		0x0000000002022022, 0x0000000002020200, 0x0000000002020220, 0x0000000002020022,
+		0x0000000002020000, 0x0000000002020222, 0x0000000002022002, 0x0000000002022020,
+		0x0000000022200202, 0x0000000022202220, 0x0000000022202222, 0x0000000022202000,
+		0x0000000022202200, 0x0000000022200002, 0x0000000022200020, 0x0000000022202202,
+		0x0000000022202022, 0x0000000022200200, 0x0000000022200220, 0x0000000022200022,
+		0x0000000022200000, 0x0000000022200222, 0x0000000022202002, 0x0000000022202020,
+		0x0000000022220202, 0x0000000022222220, 0x0000000022222222, 0x0000000022222000,
+		0x0000000022222200, 0x0000000022220002, 0x0000000022220020, 0x0000000022222202,
+		0x0000000022222022, 0x0000000022220200, 0x0000000022220220, 0x0000000022220022,
+		0x0000000022220000, 0x0000000022220222, 0x0000000022222002, 0x0000000022222020,
+		0x0000000020000202, 0x0000000020002220, 0x0000000020002222, 0x0000000020002000,
+		0x0000000020002200, 0x0000000020000002, 0x0000000020000020, 0x0000000020002202,
+		0x0000000020002022, 0x0000000020000200, 0x0000000020000220, 0x0000000020000022,
+		0x0000000020000000, 0x0000000020000222, 0x0000000020002002, 0x0000000020002020,
+		0x0000000022000202, 0x0000000022002220, 0x0000000022002222, 0x0000000022002000,
+		0x0000000022002200, 0x0000000022000002, 0x0000000022000020, 0x0000000022002202,
+		0x0000000022002022, 0x0000000022000200, 0x0000000022000220, 0x0000000022000022,
+		0x0000000022000000, 0x0000000022000222, 0x0000000022002002, 0x0000000022002020,
+		0x0000000000020202, 0x0000000000022220, 0x0000000000022222, 0x0000000000022000,
+		0x0000000000022200, 0x0000000000020002, 0x0000000000020020, 0x0000000000022202,
+		0x0000000000022022, 0x0000000000020200, 0x0000000000020220, 0x0000000000020022,
+		0x0000000000020000, 0x0000000000020222, 0x0000000000022002, 0x0000000000022020,
+		0x0000000000200202, 0x0000000000202220, 0x0000000000202222, 0x0000000000202000,
+		0x0000000000202200, 0x0000000000200002, 0x0000000000200020, 0x0000000000202202,
+		0x0000000000202022, 0x0000000000200200, 0x0000000000200220, 0x0000000000200022,
+		0x0000000000200000, 0x0000000000200222, 0x0000000000202002, 0x0000000000202020,
+		0x0000000022020202, 0x0000000022022220, 0x0000000022022222, 0x0000000022022000,
+		0x0000000022022200, 0x0000000022020002, 0x0000000022020020, 0x0000000022022202,
+		0x0000000022022022, 0x0000000022020200, 0x0000000022020220, 0x0000000022020022,
+		0x0000000022020000, 0x0000000022020222, 0x0000000022022002, 0x0000000022022020,
+		0x0000000020220202, 0x0000000020222220, 0x0000000020222222, 0x0000000020222000,
+		0x0000000020222200, 0x0000000020220002, 0x0000000020220020, 0x0000000020222202,
+		0x0000000020222022, 0x0000000020220200, 0x0000000020220220, 0x0000000020220022,
+		0x0000000020220000, 0x0000000020220222, 0x0000000020222002, 0x0000000020222020,
+		0x0000000002000202, 0x0000000002002220, 0x0000000002002222, 0x0000000002002000,
+		0x0000000002002200, 0x0000000002000002, 0x0000000002000020, 0x0000000002002202,
+		0x0000000002002022, 0x0000000002000200, 0x0000000002000220, 0x0000000002000022,
+		0x0000000002000000, 0x0000000002000222, 0x0000000002002002, 0x0000000002002020,
+		0x0000000002200202, 0x0000000002202220, 0x0000000002202222, 0x0000000002202000,
+		0x0000000002202200, 0x0000000002200002, 0x0000000002200020, 0x0000000002202202,
+		0x0000000002202022, 0x0000000002200200, 0x0000000002200220, 0x0000000002200022,
+		0x0000000002200000, 0x0000000002200222, 0x0000000002202002, 0x0000000002202020,
+		0x0000000000220202, 0x0000000000222220, 0x0000000000222222, 0x0000000000222000,
+		0x0000000000222200, 0x0000000000220002, 0x0000000000220020, 0x0000000000222202,
+		0x0000000000222022, 0x0000000000220200, 0x0000000000220220, 0x0000000000220022,
+		0x0000000000220000, 0x0000000000220222, 0x0000000000222002, 0x0000000000222020,
+		0x0000000000000202, 0x0000000000002220, 0x0000000000002222, 0x0000000000002000,
+		0x0000000000002200, 0x0000000000000002, 0x0000000000000020, 0x0000000000002202,
+		0x0000000000002022, 0x0000000000000200, 0x0000000000000220, 0x0000000000000022,
+		0x0000000000000000, 0x0000000000000222, 0x0000000000002002, 0x0000000000002020,
+		0x0000000002220202, 0x0000000002222220, 0x0000000002222222, 0x0000000002222000,
+		0x0000000002222200, 0x0000000002220002, 0x0000000002220020, 0x0000000002222202,
+		0x0000000002222022, 0x0000000002220200, 0x0000000002220220, 0x0000000002220022,
+		0x0000000002220000, 0x0000000002220222, 0x0000000002222002, 0x0000000002222020,
+		0x0000000020020202, 0x0000000020022220, 0x0000000020022222, 0x0000000020022000,
+		0x0000000020022200, 0x0000000020020002, 0x0000000020020020, 0x0000000020022202,
+		0x0000000020022022, 0x0000000020020200, 0x0000000020020220, 0x0000000020020022,
+		0x0000000020020000, 0x0000000020020222, 0x0000000020022002, 0x0000000020022020,
+		0x0000000020200202, 0x0000000020202220, 0x0000000020202222, 0x0000000020202000,
+		0x0000000020202200, 0x0000000020200002, 0x0000000020200020, 0x0000000020202202,
+		0x0000000020202022, 0x0000000020200200, 0x0000000020200220, 0x0000000020200022,
+		0x0000000020200000, 0x0000000020200222, 0x0000000020202002, 0x0000000020202020
+	},
+	{
+		0x0202020200000000, 0x0202222000000000, 0x0202222200000000, 0x0202200000000000,
+		0x0202220000000000, 0x0202000200000000, 0x0202002000000000, 0x0202220200000000,
+		0x0202202200000000, 0x0202020000000000, 0x0202022000000000, 0x0202002200000000,
+		0x0202000000000000, 0x0202022200000000, 0x0202200200000000, 0x0202202000000000,
+		0x2220020200000000, 0x2220222000000000, 0x2220222200000000, 0x2220200000000000,
+		0x2220220000000000, 0x2220000200000000, 0x2220002000000000, 0x2220220200000000,
+		0x2220202200000000, 0x2220020000000000, 0x2220022000000000, 0x2220002200000000,
+		0x2220000000000000, 0x2220022200000000, 0x2220200200000000, 0x2220202000000000,
+		0x2222020200000000, 0x2222222000000000, 0x2222222200000000, 0x2222200000000000,
+		0x2222220000000000, 0x2222000200000000, 0x2222002000000000, 0x2222220200000000,
+		0x2222202200000000, 0x2222020000000000, 0x2222022000000000, 0x2222002200000000,
+		0x2222000000000000, 0x2222022200000000, 0x2222200200000000, 0x2222202000000000,
+		0x2000020200000000, 0x2000222000000000, 0x2000222200000000, 0x2000200000000000,
+		0x2000220000000000, 0x2000000200000000, 0x2000002000000000, 0x2000220200000000,
+		0x2000202200000000, 0x2000020000000000, 0x2000022000000000, 0x2000002200000000,
+		0x2000000000000000, 0x2000022200000000, 0x2000200200000000, 0x2000202000000000,
+		0x2200020200000000, 0x2200222000000000, 0x2200222200000000, 0x2200200000000000,
+		0x2200220000000000, 0x2200000200000000, 0x2200002000000000, 0x2200220200000000,
+		0x2200202200000000, 0x2200020000000000, 0x2200022000000000, 0x2200002200000000,
+		0x2200000000000000, 0x2200022200000000, 0x2200200200000000, 0x2200202000000000,
+		0x0002020200000000, 0x0002222000000000, 0x0002222200000000, 0x0002200000000000,
+		0x0002220000000000, 0x0002000200000000, 0x0002002000000000, 0x0002220200000000,
+		0x0002202200000000, 0x0002020000000000, 0x0002022000000000, 0x0002002200000000,
+		0x0002000000000000, 0x0002022200000000, 0x0002200200000000, 0x0002202000000000,
+		0x0020020200000000, 0x0020222000000000, 0x0020222200000000, 0x0020200000000000,
+		0x0020220000000000, 0x0020000200000000, 0x0020002000000000, 0x0020220200000000,
+		0x0020202200000000, 0x0020020000000000, 0x0020022000000000, 0x0020002200000000,
+		0x0020000000000000, 0x0020022200000000, 0x0020200200000000, 0x0020202000000000,
+		0x2202020200000000, 0x2202222000000000, 0x2202222200000000, 0x2202200000000000,
+		0x2202220000000000, 0x2202000200000000, 0x2202002000000000, 0x2202220200000000,
+		0x2202202200000000, 0x2202020000000000, 0x2202022000000000, 0x2202002200000000,
+		0x2202000000000000, 0x2202022200000000, 0x2202200200000000, 0x2202202000000000,
+		0x2022020200000000, 0x2022222000000000, 0x2022222200000000, 0x2022200000000000,
+		0x2022220000000000, 0x2022000200000000, 0x2022002000000000, 0x2022220200000000,
+		0x2022202200000000, 0x2022020000000000, 0x2022022000000000, 0x2022002200000000,
+		0x2022000000000000, 0x2022022200000000, 0x2022200200000000, 0x2022202000000000,
+		0x0200020200000000, 0x0200222000000000, 0x0200222200000000, 0x0200200000000000,
+		0x0200220000000000, 0x0200000200000000, 0x0200002000000000, 0x0200220200000000,
+		0x0200202200000000, 0x0200020000000000, 0x0200022000000000, 0x0200002200000000,
+		0x0200000000000000, 0x0200022200000000, 0x0200200200000000, 0x0200202000000000,
+		0x0220020200000000, 0x0220222000000000, 0x0220222200000000, 0x0220200000000000,
+		0x0220220000000000, 0x0220000200000000, 0x0220002000000000, 0x0220220200000000,
+		0x0220202200000000, 0x0220020000000000, 0x0220022000000000, 0x0220002200000000,
+		0x0220000000000000, 0x0220022200000000, 0x0220200200000000, 0x0220202000000000,
+		0x0022020200000000, 0x0022222000000000, 0x0022222200000000, 0x0022200000000000,
+		0x0022220000000000, 0x0022000200000000, 0x0022002000000000, 0x0022220200000000,
+		0x0022202200000000, 0x0022020000000000, 0x0022022000000000, 0x0022002200000000,
+		0x0022000000000000, 0x0022022200000000, 0x0022200200000000, 0x0022202000000000,
+		0x0000020200000000, 0x0000222000000000, 0x0000222200000000, 0x0000200000000000,
+		0x0000220000000000, 0x0000000200000000, 0x0000002000000000, 0x0000220200000000,
+		0x0000202200000000, 0x0000020000000000, 0x0000022000000000, 0x0000002200000000,
+		0x0000000000000000, 0x0000022200000000, 0x0000200200000000, 0x0000202000000000,
+		0x0222020200000000, 0x0222222000000000, 0x0222222200000000, 0x0222200000000000,
+		0x0222220000000000, 0x0222000200000000, 0x0222002000000000, 0x0222220200000000,
+		0x0222202200000000, 0x0222020000000000, 0x0222022000000000, 0x0222002200000000,
+		0x0222000000000000, 0x0222022200000000, 0x0222200200000000, 0x0222202000000000,
+		0x2002020200000000, 0x2002222000000000, 0x2002222200000000, 0x2002200000000000,
+		0x2002220000000000, 0x2002000200000000, 0x2002002000000000, 0x2002220200000000,
+		0x2002202200000000, 0x2002020000000000, 0x2002022000000000, 0x2002002200000000,
+		0x2002000000000000, 0x2002022200000000, 0x2002200200000000, 0x2002202000000000,
+		0x2020020200000000, 0x2020222000000000, 0x2020222200000000, 0x2020200000000000,
+		0x2020220000000000, 0x2020000200000000, 0x2020002000000000, 0x2020220200000000,
+		0x2020202200000000, 0x2020020000000000, 0x2020022000000000, 0x2020002200000000,
+		0x2020000000000000, 0x2020022200000000, 0x2020200200000000, 0x2020202000000000
+	},
+	{
+		0x0000000004040404, 0x0000000004044440, 0x0000000004044444, 0x0000000004044000,
+		0x0000000004044400, 0x0000000004040004, 0x0000000004040040, 0x0000000004044404,
+		0x0000000004044044, 0x0000000004040400, 0x0000000004040440, 0x0000000004040044,
+		0x0000000004040000, 0x0000000004040444, 0x0000000004044004, 0x0000000004044040,
+		0x0000000044400404, 0x0000000044404440, 0x0000000044404444, 0x0000000044404000,
+		0x0000000044404400, 0x0000000044400004, 0x0000000044400040, 0x0000000044404404,
+		0x0000000044404044, 0x0000000044400400, 0x0000000044400440, 0x0000000044400044,
+		0x0000000044400000, 0x0000000044400444, 0x0000000044404004, 0x0000000044404040,
+		0x0000000044440404, 0x0000000044444440, 0x0000000044444444, 0x0000000044444000,
+		0x0000000044444400, 0x0000000044440004, 0x0000000044440040, 0x0000000044444404,
+		0x0000000044444044, 0x0000000044440400, 0x0000000044440440, 0x0000000044440044,
+		0x0000000044440000, 0x0000000044440444, 0x0000000044444004, 0x0000000044444040,
+		0x0000000040000404, 0x0000000040004440, 0x0000000040004444, 0x0000000040004000,
+		0x0000000040004400, 0x0000000040000004, 0x0000000040000040, 0x0000000040004404,
+		0x0000000040004044, 0x0000000040000400, 0x0000000040000440, 0x0000000040000044,
+		0x0000000040000000, 0x0000000040000444, 0x0000000040004004, 0x0000000040004040,
+		0x0000000044000404, 0x0000000044004440, 0x0000000044004444, 0x0000000044004000,
+		0x0000000044004400, 0x0000000044000004, 0x0000000044000040, 0x0000000044004404,
+		0x0000000044004044, 0x0000000044000400, 0x0000000044000440, 0x0000000044000044,
+		0x0000000044000000, 0x0000000044000444, 0x0000000044004004, 0x0000000044004040,
+		0x0000000000040404, 0x0000000000044440, 0x0000000000044444, 0x0000000000044000,
+		0x0000000000044400, 0x0000000000040004, 0x0000000000040040, 0x0000000000044404,
+		0x0000000000044044, 0x0000000000040400, 0x0000000000040440, 0x0000000000040044,
+		0x0000000000040000, 0x0000000000040444, 0x0000000000044004, 0x0000000000044040,
+		0x0000000000400404, 0x0000000000404440, 0x0000000000404444, 0x0000000000404000,
+		0x0000000000404400, 0x0000000000400004, 0x0000000000400040, 0x0000000000404404,
+		0x0000000000404044, 0x0000000000400400, 0x0000000000400440, 0x0000000000400044,
+		0x0000000000400000, 0x0000000000400444, 0x0000000000404004, 0x0000000000404040,
+		0x0000000044040404, 0x0000000044044440, 0x0000000044044444, 0x0000000044044000,
+		0x0000000044044400, 0x0000000044040004, 0x0000000044040040, 0x0000000044044404,
+		0x0000000044044044, 0x0000000044040400, 0x0000000044040440, 0x0000000044040044,
+		0x0000000044040000, 0x0000000044040444, 0x0000000044044004, 0x0000000044044040,
+		0x0000000040440404, 0x0000000040444440, 0x0000000040444444, 0x0000000040444000,
+		0x0000000040444400, 0x0000000040440004, 0x0000000040440040, 0x0000000040444404,
+		0x0000000040444044, 0x0000000040440400, 0x0000000040440440, 0x0000000040440044,
+		0x0000000040440000, 0x0000000040440444, 0x0000000040444004, 0x0000000040444040,
+		0x0000000004000404, 0x0000000004004440, 0x0000000004004444, 0x0000000004004000,
+		0x0000000004004400, 0x0000000004000004, 0x0000000004000040, 0x0000000004004404,
+		0x0000000004004044, 0x0000000004000400, 0x0000000004000440, 0x0000000004000044,
+		0x0000000004000000, 0x0000000004000444, 0x0000000004004004, 0x0000000004004040,
+		0x0000000004400404, 0x0000000004404440, 0x0000000004404444, 0x0000000004404000,
+		0x0000000004404400, 0x0000000004400004, 0x0000000004400040, 0x0000000004404404,
+		0x0000000004404044, 0x0000000004400400, 0x0000000004400440, 0x0000000004400044,
+		0x0000000004400000, 0x0000000004400444, 0x0000000004404004, 0x0000000004404040,
+		0x0000000000440404, 0x0000000000444440, 0x0000000000444444, 0x0000000000444000,
+		0x0000000000444400, 0x0000000000440004, 0x0000000000440040, 0x0000000000444404,
+		0x0000000000444044, 0x0000000000440400, 0x0000000000440440, 0x0000000000440044,
+		0x0000000000440000, 0x0000000000440444, 0x0000000000444004, 0x0000000000444040,
+		0x0000000000000404, 0x0000000000004440, 0x0000000000004444, 0x0000000000004000,
+		0x0000000000004400, 0x0000000000000004, 0x0000000000000040, 0x0000000000004404,
+		0x0000000000004044, 0x0000000000000400, 0x0000000000000440, 0x0000000000000044,
+		0x0000000000000000, 0x0000000000000444, 0x0000000000004004, 0x0000000000004040,
+		0x0000000004440404, 0x0000000004444440, 0x0000000004444444, 0x0000000004444000,
+		0x0000000004444400, 0x0000000004440004, 0x0000000004440040, 0x0000000004444404,
+		0x0000000004444044, 0x0000000004440400, 0x0000000004440440, 0x0000000004440044,
+		0x0000000004440000, 0x0000000004440444, 0x0000000004444004, 0x0000000004444040,
+		0x0000000040040404, 0x0000000040044440, 0x0000000040044444, 0x0000000040044000,
+		0x0000000040044400, 0x0000000040040004, 0x0000000040040040, 0x0000000040044404,
+		0x0000000040044044, 0x0000000040040400, 0x0000000040040440, 0x0000000040040044,
+		0x0000000040040000, 0x0000000040040444, 0x0000000040044004, 0x0000000040044040,
+		0x0000000040400404, 0x0000000040404440, 0x0000000040404444, 0x0000000040404000,
+		0x0000000040404400, 0x0000000040400004, 0x0000000040400040, 0x0000000040404404,
+		0x0000000040404044, 0x0000000040400400, 0x0000000040400440, 0x0000000040400044,
+		0x0000000040400000, 0x0000000040400444, 0x0000000040404004, 0x0000000040404040
+	},
+	{
+		0x0404040400000000, 0x0404444000000000, 0x0404444400000000, 0x0404400000000000,
+		0x0404440000000000, 0x0404000400000000, 0x0404004000000000, 0x0404440400000000,
+		0x0404404400000000, 0x0404040000000000, 0x0404044000000000, 0x0404004400000000,
+		0x0404000000000000, 0x0404044400000000, 0x0404400400000000, 0x0404404000000000,
+		0x4440040400000000, 0x4440444000000000, 0x4440444400000000, 0x4440400000000000,
+		0x4440440000000000, 0x4440000400000000, 0x4440004000000000, 0x4440440400000000,
+		0x4440404400000000, 0x4440040000000000, 0x4440044000000000, 0x4440004400000000,
+		0x4440000000000000, 0x4440044400000000, 0x4440400400000000, 0x4440404000000000,
+		0x4444040400000000, 0x4444444000000000, 0x4444444400000000, 0x4444400000000000,
+		0x4444440000000000, 0x4444000400000000, 0x4444004000000000, 0x4444440400000000,
+		0x4444404400000000, 0x4444040000000000, 0x4444044000000000, 0x4444004400000000,
+		0x4444000000000000, 0x4444044400000000, 0x4444400400000000, 0x4444404000000000,
+		0x4000040400000000, 0x4000444000000000, 0x4000444400000000, 0x4000400000000000,
+		0x4000440000000000, 0x4000000400000000, 0x4000004000000000, 0x4000440400000000,
+		0x4000404400000000, 0x4000040000000000, 0x4000044000000000, 0x4000004400000000,
+		0x4000000000000000, 0x4000044400000000, 0x4000400400000000, 0x4000404000000000,
+		0x4400040400000000, 0x4400444000000000, 0x4400444400000000, 0x4400400000000000,
+		0x4400440000000000, 0x4400000400000000, 0x4400004000000000, 0x4400440400000000,
+		0x4400404400000000, 0x4400040000000000, 0x4400044000000000, 0x4400004400000000,
+		0x4400000000000000, 0x4400044400000000, 0x4400400400000000, 0x4400404000000000,
+		0x0004040400000000, 0x0004444000000000, 0x0004444400000000, 0x0004400000000000,
+		0x0004440000000000, 0x0004000400000000, 0x0004004000000000, 0x0004440400000000,
+		0x0004404400000000, 0x0004040000000000, 0x0004044000000000, 0x0004004400000000,
+		0x0004000000000000, 0x0004044400000000, 0x0004400400000000, 0x0004404000000000,
+		0x0040040400000000, 0x0040444000000000, 0x0040444400000000, 0x0040400000000000,
+		0x0040440000000000, 0x0040000400000000, 0x0040004000000000, 0x0040440400000000,
+		0x0040404400000000, 0x0040040000000000, 0x0040044000000000, 0x0040004400000000,
+		0x0040000000000000, 0x0040044400000000, 0x0040400400000000, 0x0040404000000000,
+		0x4404040400000000, 0x4404444000000000, 0x4404444400000000, 0x4404400000000000,
+		0x4404440000000000, 0x4404000400000000, 0x4404004000000000, 0x4404440400000000,
+		0x4404404400000000, 0x4404040000000000, 0x4404044000000000, 0x4404004400000000,
+		0x4404000000000000, 0x4404044400000000, 0x4404400400000000, 0x4404404000000000,
+		0x4044040400000000, 0x4044444000000000, 0x4044444400000000, 0x4044400000000000,
+		0x4044440000000000, 0x4044000400000000, 0x4044004000000000, 0x4044440400000000,
+		0x4044404400000000, 0x4044040000000000, 0x4044044000000000, 0x4044004400000000,
+		0x4044000000000000, 0x4044044400000000, 0x4044400400000000, 0x4044404000000000,
+		0x0400040400000000, 0x0400444000000000, 0x0400444400000000, 0x0400400000000000,
+		0x0400440000000000, 0x0400000400000000, 0x0400004000000000, 0x0400440400000000,
+		0x0400404400000000, 0x0400040000000000, 0x0400044000000000, 0x0400004400000000,
+		0x0400000000000000, 0x0400044400000000, 0x0400400400000000, 0x0400404000000000,
+		0x0440040400000000, 0x0440444000000000, 0x0440444400000000, 0x0440400000000000,
+		0x0440440000000000, 0x0440000400000000, 0x0440004000000000, 0x0440440400000000,
+		0x0440404400000000, 0x0440040000000000, 0x0440044000000000, 0x0440004400000000,
+		0x0440000000000000, 0x0440044400000000, 0x0440400400000000, 0x0440404000000000,
+		0x0044040400000000, 0x0044444000000000, 0x0044444400000000, 0x0044400000000000,
+		0x0044440000000000, 0x0044000400000000, 0x0044004000000000, 0x0044440400000000,
+		0x0044404400000000, 0x0044040000000000, 0x0044044000000000, 0x0044004400000000,
+		0x0044000000000000, 0x0044044400000000, 0x0044400400000000, 0x0044404000000000,
+		0x0000040400000000, 0x0000444000000000, 0x0000444400000000, 0x0000400000000000,
+		0x0000440000000000, 0x0000000400000000, 0x0000004000000000, 0x0000440400000000,
+		0x0000404400000000, 0x0000040000000000, 0x0000044000000000, 0x0000004400000000,
+		0x0000000000000000, 0x0000044400000000, 0x0000400400000000, 0x0000404000000000,
+		0x0444040400000000, 0x0444444000000000, 0x0444444400000000, 0x0444400000000000,
+		0x0444440000000000, 0x0444000400000000, 0x0444004000000000, 0x0444440400000000,
+		0x0444404400000000, 0x0444040000000000, 0x0444044000000000, 0x0444004400000000,
+		0x0444000000000000, 0x0444044400000000, 0x0444400400000000, 0x0444404000000000,
+		0x4004040400000000, 0x4004444000000000, 0x4004444400000000, 0x4004400000000000,
+		0x4004440000000000, 0x4004000400000000, 0x4004004000000000, 0x4004440400000000,
+		0x4004404400000000, 0x4004040000000000, 0x4004044000000000, 0x4004004400000000,
+		0x4004000000000000, 0x4004044400000000, 0x4004400400000000, 0x4004404000000000,
+		0x4040040400000000, 0x4040444000000000, 0x4040444400000000, 0x4040400000000000,
+		0x4040440000000000, 0x4040000400000000, 0x4040004000000000, 0x4040440400000000,
+		0x4040404400000000, 0x4040040000000000, 0x4040044000000000, 0x4040004400000000,
+		0x4040000000000000, 0x4040044400000000, 0x4040400400000000, 0x4040404000000000
+	},
+	{
+		0x0000000008080808, 0x0000000008088880, 0x0000000008088888, 0x0000000008088000,
+		0x0000000008088800, 0x0000000008080008, 0x0000000008080080, 0x0000000008088808,
+		0x0000000008088088, 0x0000000008080800, 0x0000000008080880, 0x0000000008080088,
+		0x0000000008080000, 0x0000000008080888, 0x0000000008088008, 0x0000000008088080,
+		0x0000000088800808, 0x0000000088808880, 0x0000000088808888, 0x0000000088808000,
+		0x0000000088808800, 0x0000000088800008, 0x0000000088800080, 0x0000000088808808,
+		0x0000000088808088, 0x0000000088800800, 0x0000000088800880, 0x0000000088800088,
+		0x0000000088800000, 0x0000000088800888, 0x0000000088808008, 0x0000000088808080,
+		0x0000000088880808, 0x0000000088888880, 0x0000000088888888, 0x0000000088888000,
+		0x0000000088888800, 0x0000000088880008, 0x0000000088880080, 0x0000000088888808,
+		0x0000000088888088, 0x0000000088880800, 0x0000000088880880, 0x0000000088880088,
+		0x0000000088880000, 0x0000000088880888, 0x0000000088888008, 0x0000000088888080,
+		0x0000000080000808, 0x0000000080008880, 0x0000000080008888, 0x0000000080008000,
+		0x0000000080008800, 0x0000000080000008, 0x0000000080000080, 0x0000000080008808,
+		0x0000000080008088, 0x0000000080000800, 0x0000000080000880, 0x0000000080000088,
+		0x0000000080000000, 0x0000000080000888, 0x0000000080008008, 0x0000000080008080,
+		0x0000000088000808, 0x0000000088008880, 0x0000000088008888, 0x0000000088008000,
+		0x0000000088008800, 0x0000000088000008, 0x0000000088000080, 0x0000000088008808,
+		0x0000000088008088, 0x0000000088000800, 0x0000000088000880, 0x0000000088000088,
+		0x0000000088000000, 0x0000000088000888, 0x0000000088008008, 0x0000000088008080,
+		0x0000000000080808, 0x0000000000088880, 0x0000000000088888, 0x0000000000088000,
+		0x0000000000088800, 0x0000000000080008, 0x0000000000080080, 0x0000000000088808,
+		0x0000000000088088, 0x0000000000080800, 0x0000000000080880, 0x0000000000080088,
+		0x0000000000080000, 0x0000000000080888, 0x0000000000088008, 0x0000000000088080,
+		0x0000000000800808, 0x0000000000808880, 0x0000000000808888, 0x0000000000808000,
+		0x0000000000808800, 0x0000000000800008, 0x0000000000800080, 0x0000000000808808,
+		0x0000000000808088, 0x0000000000800800, 0x0000000000800880, 0x0000000000800088,
+		0x0000000000800000, 0x0000000000800888, 0x0000000000808008, 0x0000000000808080,
+		0x0000000088080808, 0x0000000088088880, 0x0000000088088888, 0x0000000088088000,
+		0x0000000088088800, 0x0000000088080008, 0x0000000088080080, 0x0000000088088808,
+		0x0000000088088088, 0x0000000088080800, 0x0000000088080880, 0x0000000088080088,
+		0x0000000088080000, 0x0000000088080888, 0x0000000088088008, 0x0000000088088080,
+		0x0000000080880808, 0x0000000080888880, 0x0000000080888888, 0x0000000080888000,
+		0x0000000080888800, 0x0000000080880008, 0x0000000080880080, 0x0000000080888808,
+		0x0000000080888088, 0x0000000080880800, 0x0000000080880880, 0x0000000080880088,
+		0x0000000080880000, 0x0000000080880888, 0x0000000080888008, 0x0000000080888080,
+		0x0000000008000808, 0x0000000008008880, 0x0000000008008888, 0x0000000008008000,
+		0x0000000008008800, 0x0000000008000008, 0x0000000008000080, 0x0000000008008808,
+		0x0000000008008088, 0x0000000008000800, 0x0000000008000880, 0x0000000008000088,
+		0x0000000008000000, 0x0000000008000888, 0x0000000008008008, 0x0000000008008080,
+		0x0000000008800808, 0x0000000008808880, 0x0000000008808888, 0x0000000008808000,
+		0x0000000008808800, 0x0000000008800008, 0x0000000008800080, 0x0000000008808808,
+		0x0000000008808088, 0x0000000008800800, 0x0000000008800880, 0x0000000008800088,
+		0x0000000008800000, 0x0000000008800888, 0x0000000008808008, 0x0000000008808080,
+		0x0000000000880808, 0x0000000000888880, 0x0000000000888888, 0x0000000000888000,
+		0x0000000000888800, 0x0000000000880008, 0x0000000000880080, 0x0000000000888808,
+		0x0000000000888088, 0x0000000000880800, 0x0000000000880880, 0x0000000000880088,
+		0x0000000000880000, 0x0000000000880888, 0x0000000000888008, 0x0000000000888080,
+		0x0000000000000808, 0x0000000000008880, 0x0000000000008888, 0x0000000000008000,
+		0x0000000000008800, 0x0000000000000008, 0x0000000000000080, 0x0000000000008808,
+		0x0000000000008088, 0x0000000000000800, 0x0000000000000880, 0x0000000000000088,
+		0x0000000000000000, 0x0000000000000888, 0x0000000000008008, 0x0000000000008080,
+		0x0000000008880808, 0x0000000008888880, 0x0000000008888888, 0x0000000008888000,
+		0x0000000008888800, 0x0000000008880008, 0x0000000008880080, 0x0000000008888808,
+		0x0000000008888088, 0x0000000008880800, 0x0000000008880880, 0x0000000008880088,
+		0x0000000008880000, 0x0000000008880888, 0x0000000008888008, 0x0000000008888080,
+		0x0000000080080808, 0x0000000080088880, 0x0000000080088888, 0x0000000080088000,
+		0x0000000080088800, 0x0000000080080008, 0x0000000080080080, 0x0000000080088808,
+		0x0000000080088088, 0x0000000080080800, 0x0000000080080880, 0x0000000080080088,
+		0x0000000080080000, 0x0000000080080888, 0x0000000080088008, 0x0000000080088080,
+		0x0000000080800808, 0x0000000080808880, 0x0000000080808888, 0x0000000080808000,
+		0x0000000080808800, 0x0000000080800008, 0x0000000080800080, 0x0000000080808808,
+		0x0000000080808088, 0x0000000080800800, 0x0000000080800880, 0x0000000080800088,
+		0x0000000080800000, 0x0000000080800888, 0x0000000080808008, 0x0000000080808080
+	},
+	{
+		0x0808080800000000, 0x0808888000000000, 0x0808888800000000, 0x0808800000000000,
+		0x0808880000000000, 0x0808000800000000, 0x0808008000000000, 0x0808880800000000,
+		0x0808808800000000, 0x0808080000000000, 0x0808088000000000, 0x0808008800000000,
+		0x0808000000000000, 0x0808088800000000, 0x0808800800000000, 0x0808808000000000,
+		0x8880080800000000, 0x8880888000000000, 0x8880888800000000, 0x8880800000000000,
+		0x8880880000000000, 0x8880000800000000, 0x8880008000000000, 0x8880880800000000,
+		0x8880808800000000, 0x8880080000000000, 0x8880088000000000, 0x8880008800000000,
+		0x8880000000000000, 0x8880088800000000, 0x8880800800000000, 0x8880808000000000,
+		0x8888080800000000, 0x8888888000000000, 0x8888888800000000, 0x8888800000000000,
+		0x8888880000000000, 0x8888000800000000, 0x8888008000000000, 0x8888880800000000,
+		0x8888808800000000, 0x8888080000000000, 0x8888088000000000, 0x8888008800000000,
+		0x8888000000000000, 0x8888088800000000, 0x8888800800000000, 0x8888808000000000,
+		0x8000080800000000, 0x8000888000000000, 0x8000888800000000, 0x8000800000000000,
+		0x8000880000000000, 0x8000000800000000, 0x8000008000000000, 0x8000880800000000,
+		0x8000808800000000, 0x8000080000000000, 0x8000088000000000, 0x8000008800000000,
+		0x8000000000000000, 0x8000088800000000, 0x8000800800000000, 0x8000808000000000,
+		0x8800080800000000, 0x8800888000000000, 0x8800888800000000, 0x8800800000000000,
+		0x8800880000000000, 0x8800000800000000, 0x8800008000000000, 0x8800880800000000,
+		0x8800808800000000, 0x8800080000000000, 0x8800088000000000, 0x8800008800000000,
+		0x8800000000000000, 0x8800088800000000, 0x8800800800000000, 0x8800808000000000,
+		0x0008080800000000, 0x0008888000000000, 0x0008888800000000, 0x0008800000000000,
+		0x0008880000000000, 0x0008000800000000, 0x0008008000000000, 0x0008880800000000,
+		0x0008808800000000, 0x0008080000000000, 0x0008088000000000, 0x0008008800000000,
+		0x0008000000000000, 0x0008088800000000, 0x0008800800000000, 0x0008808000000000,
+		0x0080080800000000, 0x0080888000000000, 0x0080888800000000, 0x0080800000000000,
+		0x0080880000000000, 0x0080000800000000, 0x0080008000000000, 0x0080880800000000,
+		0x0080808800000000, 0x0080080000000000, 0x0080088000000000, 0x0080008800000000,
+		0x0080000000000000, 0x0080088800000000, 0x0080800800000000, 0x0080808000000000,
+		0x8808080800000000, 0x8808888000000000, 0x8808888800000000, 0x8808800000000000,
+		0x8808880000000000, 0x8808000800000000, 0x8808008000000000, 0x8808880800000000,
+		0x8808808800000000, 0x8808080000000000, 0x8808088000000000, 0x8808008800000000,
+		0x8808000000000000, 0x8808088800000000, 0x8808800800000000, 0x8808808000000000,
+		0x8088080800000000, 0x8088888000000000, 0x8088888800000000, 0x8088800000000000,
+		0x8088880000000000, 0x8088000800000000, 0x8088008000000000, 0x8088880800000000,
+		0x8088808800000000, 0x8088080000000000, 0x8088088000000000, 0x8088008800000000,
+		0x8088000000000000, 0x8088088800000000, 0x8088800800000000, 0x8088808000000000,
+		0x0800080800000000, 0x0800888000000000, 0x0800888800000000, 0x0800800000000000,
+		0x0800880000000000, 0x0800000800000000, 0x0800008000000000, 0x0800880800000000,
+		0x0800808800000000, 0x0800080000000000, 0x0800088000000000, 0x0800008800000000,
+		0x0800000000000000, 0x0800088800000000, 0x0800800800000000, 0x0800808000000000,
+		0x0880080800000000, 0x0880888000000000, 0x0880888800000000, 0x0880800000000000,
+		0x0880880000000000, 0x0880000800000000, 0x0880008000000000, 0x0880880800000000,
+		0x0880808800000000, 0x0880080000000000, 0x0880088000000000, 0x0880008800000000,
+		0x0880000000000000, 0x0880088800000000, 0x0880800800000000, 0x0880808000000000,
+		0x0088080800000000, 0x0088888000000000, 0x0088888800000000, 0x0088800000000000,
+		0x0088880000000000, 0x0088000800000000, 0x0088008000000000, 0x0088880800000000,
+		0x0088808800000000, 0x0088080000000000, 0x0088088000000000, 0x0088008800000000,
+		0x0088000000000000, 0x0088088800000000, 0x0088800800000000, 0x0088808000000000,
+		0x0000080800000000, 0x0000888000000000, 0x0000888800000000, 0x0000800000000000,
+		0x0000880000000000, 0x0000000800000000, 0x0000008000000000, 0x0000880800000000,
+		0x0000808800000000, 0x0000080000000000, 0x0000088000000000, 0x0000008800000000,
+		0x0000000000000000, 0x0000088800000000, 0x0000800800000000, 0x0000808000000000,
+		0x0888080800000000, 0x0888888000000000, 0x0888888800000000, 0x0888800000000000,
+		0x0888880000000000, 0x0888000800000000, 0x0888008000000000, 0x0888880800000000,
+		0x0888808800000000, 0x0888080000000000, 0x0888088000000000, 0x0888008800000000,
+		0x0888000000000000, 0x0888088800000000, 0x0888800800000000, 0x0888808000000000,
+		0x8008080800000000, 0x8008888000000000, 0x8008888800000000, 0x8008800000000000,
+		0x8008880000000000, 0x8008000800000000, 0x8008008000000000, 0x8008880800000000,
+		0x8008808800000000, 0x8008080000000000, 0x8008088000000000, 0x8008008800000000,
+		0x8008000000000000, 0x8008088800000000, 0x8008800800000000, 0x8008808000000000,
+		0x8080080800000000, 0x8080888000000000, 0x8080888800000000, 0x8080800000000000,
+		0x8080880000000000, 0x8080000800000000, 0x8080008000000000, 0x8080880800000000,
+		0x8080808800000000, 0x8080080000000000, 0x8080088000000000, 0x8080008800000000,
+		0x8080000000000000, 0x8080088800000000, 0x8080800800000000, 0x8080808000000000
+	}
+};
+
+// sbox substitution layer
+// divide state into 16 parts of 4 bits and substitute these parts
+// according to the sbox
+// in this case we are dividing in 8 parts in the loop, but inside the loop
+// splitting into high and low parts
+static uint64_t sBoxLayer(uint64_t state, const uint8_t* box)
+{
+	uint8_t i;
+	uint64_t temp = 0;
+
+	for (i = 0; i < 8; i++)
+	{
+		uint8_t pos = (uint8_t)(state >> (8 * (7 - i)));
+		uint8_t highNybble = box[(pos >> 4) & 0x0f];
+		uint8_t lowNybble = box[pos & 0x0f];
+
+		uint64_t mask = 0;
+		mask |= highNybble << 4 | lowNybble;
+		mask = mask << (56 - (8 * i));
+		temp |= mask;
+	}
+
+	return temp;
+}
+
+// permutation layer
+// change order of all bits according to the permutation table
+static uint64_t pLayer(uint64_t state)
+{
+	uint8_t i;
+	uint64_t temp = 0;
+
+	for (i = 0; i < 64; i++)
+	{
+		uint8_t distance = 63 - i;
+		temp |= ((state >> distance & 0x1) << (63 - p[i]));
+	}
+
+	return temp;
+}
+
+// inverse permutation layer
+// change order of all bits according to the permutation table
+// but in reverse order
+static uint64_t inversePLayer(uint64_t state)
+{
+	uint8_t i;
+	uint64_t temp = 0;
+
+	for (i = 0; i < 64; i++)
+	{
+		uint8_t distance = 63 - p[i];
+		temp = (temp << 1) | ((state >> distance) & 0x1);
+	}
+
+	return temp;
+}
+
+// s-box and permutation layers with one table lookup per byte
+static uint64_t spLayer(uint64_t state)
+{
+	return spBox[0][state & 0xff]
+		| spBox[1][(state >> 8) & 0xff]
+		| spBox[2][(state >> 16) & 0xff]
+		| spBox[3][(state >> 24) & 0xff]
+		| spBox[4][(state >> 32) & 0xff]
+		| spBox[5][(state >> 40) & 0xff]
+		| spBox[6][(state >> 48) & 0xff]
+		| spBox[7][state >> 56];
+}
+
+// inverse s-box followed by the inverse permutation layer
+static uint64_t inverseSpLayer(uint64_t state)
+{
+	return inverseSpBox[0][state & 0xff]
+		| inverseSpBox[1][(state >> 8) & 0xff]
+		| inverseSpBox[2][(state >> 16) & 0xff]
+		| inverseSpBox[3][(state >> 24) & 0xff]
+		| inverseSpBox[4][(state >> 32) & 0xff]
+		| inverseSpBox[5][(state >> 40) & 0xff]
+		| inverseSpBox[6][(state >> 48) & 0xff]
+		| inverseSpBox[7][state >> 56];
+}
+
 void PRESENT_init(PresentContext* context, uint16_t* key, uint16_t keyLen)
 {
 	uint64_t keyHigh;
@@ -97,10 +1258,8 @@ void PRESENT_init(PresentContext* context, uint16_t* key, uint16_t keyLen)
 			keyLow = keyLow << 61 | temp >> 3;;
 
 			// the left-most eight bits are passed through the sbox
-			temp = sbox[(keyHigh >> 60) & 0xf];
-			keyHigh |= temp << 60;
-			temp = sbox[(keyHigh >> 56) & 0xf];
-			keyHigh |= temp << 56;
+			temp = (uint64_t)sbox[keyHigh >> 60] << 60 | (uint64_t)sbox[(keyHigh >> 56) & 0xf] << 56;
+			keyHigh = (keyHigh & 0x00ffffffffffffff) | temp;
 
 			// round_counter value i is exclusive - ored with bits k66 k65 k64 k63 k62
 			keyHigh ^= i >> 2;
@@ -110,9 +1269,17 @@ void PRESENT_init(PresentContext* context, uint16_t* key, uint16_t keyLen)
 			context->roundKeys[i] = keyHigh;
 		}
 	}
+
+	for (uint8_t i = 0; i <= NR_ROUNDS; i++)
+	{
+		context->decryptionKeys[i] = inversePLayer(context->roundKeys[i]);
+	}
 }
 
 /*
+	Reference encryption with the bit by bit layers of the
+	specification, kept to check the table driven path.
+
 	Encryption order:
 
 	for round = 0 to 30 do
@@ -123,12 +1290,10 @@ void PRESENT_init(PresentContext* context, uint16_t* key, uint16_t keyLen)
 
 	addRoundKey(state, k31)
 */
-void PRESENT_encrypt(PresentContext* context, uint16_t* block, uint16_t* out)
+void PRESENT_encrypt_reference(PresentContext* context, uint16_t* block, uint16_t* out)
 {
-	uint8_t i;
 	uint8_t round;
 	uint64_t state;
-	uint64_t temp;
 
 	// copy block to state
 	state = (uint64_t)block[0] << 48
@@ -141,34 +1306,8 @@ void PRESENT_encrypt(PresentContext* context, uint16_t* block, uint16_t* out)
 		// add round key
 		state ^= context->roundKeys[round];
 
-		// sbox substitution layer
-		// divide state into 16 parts of 4 bits and substitute these parts
-		// according to the sbox
-		// in this case we are dividing in 8 parts in the loop, but inside the loop
-		// splitting into high and low parts
-		temp = 0;
-		for (i = 0; i < 8; i++)
-		{
-			uint8_t pos = (uint8_t)(state >> (8 * (7 - i)));
-			uint8_t highNybble = sbox[(pos >> 4) & 0x0f];
-			uint8_t lowNybble = sbox[pos & 0x0f];
-
-			uint64_t mask = 0;
-			mask |= highNybble << 4 | lowNybble;
-			mask = mask << (56 - (8 * i));
-			temp |= mask;
-		}
-		state = temp;
-
-		// permutation layer
-		// change order of all bits according to the permutation table
-		temp = 0;
-		for (i = 0; i < 64; i++)
-		{
-			uint8_t distance = 63 - i;
-			temp |= ((state >> distance & 0x1) << (63 - p[i]));
-		}
-		state = temp;
+		state = sBoxLayer(state, sbox);
+		state = pLayer(state);
 	}
 
 	// add last round key
@@ -182,6 +1321,8 @@ void PRESENT_encrypt(PresentContext* context, uint16_t* block, uint16_t* out)
 }
 
 /*
+	Reference decryption with the bit by bit layers.
+
 	Decryption order:
 
 	for round = 31 to 1 do
@@ -192,12 +1333,10 @@ void PRESENT_encrypt(PresentContext* context, uint16_t* block, uint16_t* out)
 
 	addRoundKey(state, k0)
 */
-void PRESENT_decrypt(PresentContext* context, uint16_t* block, uint16_t* out)
+void PRESENT_decrypt_reference(PresentContext* context, uint16_t* block, uint16_t* out)
 {
-	uint8_t i;
 	uint8_t round;
 	uint64_t state;
-	uint64_t temp;
 
 	// copy block to state
 	state = (uint64_t)block[0] << 48
@@ -211,35 +1350,8 @@ void PRESENT_decrypt(PresentContext* context, uint16_t* block, uint16_t* out)
 		// add round key
 		state ^= context->roundKeys[round];
 
-		// permutation layer
-		// change order of all bits according to the permutation table
-		// but in reverse order
-		temp = 0;
-		for (i = 0; i < 64; i++)
-		{
-			uint8_t distance = 63 - p[i];
-			temp = (temp << 1) | ((state >> distance) & 0x1);
-		}
-		state = temp;
-
-		// sbox substitution layer
-		// divide state into 16 parts of 4 bits and substitute these parts
-		// according to the inverse sbox
-		// in this case we are dividing in 8 parts in the loop, but inside the loop
-		// splitting into high and low parts
-		temp = 0;
-		for (i = 0; i < 8; i++)
-		{
-			uint8_t pos = (uint8_t)(state >> (8 * (7 - i)));
-			uint8_t highNybble = isbox[(pos >> 4) & 0x0f];
-			uint8_t lowNybble = isbox[pos & 0x0f];
-
-			uint64_t mask = 0;
-			mask |= highNybble << 4 | lowNybble;
-			mask = mask << (56 - (8 * i));
-			temp |= mask;
-		}
-		state = temp;
+		state = inversePLayer(state);
+		state = sBoxLayer(state, isbox);
 	}
 
 	// add last key
@@ -252,6 +1364,427 @@ void PRESENT_decrypt(PresentContext* context, uint16_t* block, uint16_t* out)
 	out[3] = (uint16_t)state;
 }
 
+static uint64_t PRESENT_encrypt_state(const PresentContext* context, uint64_t state)
+{
+	uint8_t round;
+
+	for (round = 0; round < NR_ROUNDS; round++)
+	{
+		state = spLayer(state ^ context->roundKeys[round]);
+	}
+
+	return state ^ context->roundKeys[NR_ROUNDS];
+}
+
+/*
+	The inverse permutation is linear, so the state is kept after
+	it: w = inversePLayer(state ^ Ki) = inverseSpLayer(w) ^ inversePLayer(Ki)
+	for the previous w, which turns every round into byte lookups.
+	Entering that form costs one s-box layer, leaving it costs one
+	inverse s-box layer.
+*/
+static uint64_t PRESENT_decrypt_state(const PresentContext* context, uint64_t state)
+{
+	uint8_t round;
+
+	// inversePLayer(state) = inverseSpLayer(sBoxLayer(state))
+	state = inverseSpLayer(sBoxLayer(state, sbox)) ^ context->decryptionKeys[NR_ROUNDS];
+
+	for (round = NR_ROUNDS - 1; round > 0; round--)
+	{
+		state = inverseSpLayer(state) ^ context->decryptionKeys[round];
+	}
+
+	return sBoxLayer(state, isbox) ^ context->roundKeys[0];
+}
+
+void PRESENT_encrypt(PresentContext* context, uint16_t* block, uint16_t* out)
+{
+	uint64_t state;
+
+	state = (uint64_t)block[0] << 48
+		| (uint64_t)block[1] << 32
+		| (uint64_t)block[2] << 16
+		| block[3];
+
+	state = PRESENT_encrypt_state(context, state);
+
+	out[0] = (uint16_t)(state >> 48);
+	out[1] = (uint16_t)(state >> 32);
+	out[2] = (uint16_t)(state >> 16);
+	out[3] = (uint16_t)state;
+}
+
+void PRESENT_decrypt(PresentContext* context, uint16_t* block, uint16_t* out)
+{
+	uint64_t state;
+
+	state = (uint64_t)block[0] << 48
+		| (uint64_t)block[1] << 32
+		| (uint64_t)block[2] << 16
+		| block[3];
+
+	state = PRESENT_decrypt_state(context, state);
+
+	out[0] = (uint16_t)(state >> 48);
+	out[1] = (uint16_t)(state >> 32);
+	out[2] = (uint16_t)(state >> 16);
+	out[3] = (uint16_t)state;
+}
+
+static void PRESENT_bitsliced(PresentContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks, int decrypt);
+
+/*
+	Bulk ECB encryption of nrBlocks consecutive blocks. From 64 blocks
+	on the bitsliced engine is used, below that two independent
+	blocks share each round key of the table driven path.
+*/
+void PRESENT_encrypt_blocks(PresentContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks)
+{
+	uint8_t round;
+	uint64_t k;
+	uint64_t a;
+	uint64_t b;
+
+	if (nrBlocks >= BITSLICE_BLOCKS)
+	{
+		PRESENT_bitsliced(context, blocks, out, nrBlocks, 0);
+		return;
+	}
+
+	for (; nrBlocks >= 2; nrBlocks -= 2, blocks += 8, out += 8)
+	{
+		a = (uint64_t)blocks[0] << 48 | (uint64_t)blocks[1] << 32 | (uint64_t)blocks[2] << 16 | blocks[3];
+		b = (uint64_t)blocks[4] << 48 | (uint64_t)blocks[5] << 32 | (uint64_t)blocks[6] << 16 | blocks[7];
+
+		for (round = 0; round < NR_ROUNDS; round++)
+		{
+			k = context->roundKeys[round];
+			a = spLayer(a ^ k);
+			b = spLayer(b ^ k);
+		}
+
+		a ^= context->roundKeys[round];
+		b ^= context->roundKeys[round];
+
+		out[0] = (uint16_t)(a >> 48);
+		out[1] = (uint16_t)(a >> 32);
+		out[2] = (uint16_t)(a >> 16);
+		out[3] = (uint16_t)a;
+		out[4] = (uint16_t)(b >> 48);
+		out[5] = (uint16_t)(b >> 32);
+		out[6] = (uint16_t)(b >> 16);
+		out[7] = (uint16_t)b;
+	}
+
+	if (nrBlocks > 0)
+	{
+		PRESENT_encrypt(context, (uint16_t*)blocks, out);
+	}
+}
+
+void PRESENT_decrypt_blocks(PresentContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks)
+{
+	uint8_t round;
+	uint64_t k;
+	uint64_t a;
+	uint64_t b;
+
+	if (nrBlocks >= BITSLICE_BLOCKS)
+	{
+		PRESENT_bitsliced(context, blocks, out, nrBlocks, 1);
+		return;
+	}
+
+	for (; nrBlocks >= 2; nrBlocks -= 2, blocks += 8, out += 8)
+	{
+		a = (uint64_t)blocks[0] << 48 | (uint64_t)blocks[1] << 32 | (uint64_t)blocks[2] << 16 | blocks[3];
+		b = (uint64_t)blocks[4] << 48 | (uint64_t)blocks[5] << 32 | (uint64_t)blocks[6] << 16 | blocks[7];
+
+		k = context->decryptionKeys[NR_ROUNDS];
+		a = inverseSpLayer(sBoxLayer(a, sbox)) ^ k;
+		b = inverseSpLayer(sBoxLayer(b, sbox)) ^ k;
+
+		for (round = NR_ROUNDS - 1; round > 0; round--)
+		{
+			k = context->decryptionKeys[round];
+			a = inverseSpLayer(a) ^ k;
+			b = inverseSpLayer(b) ^ k;
+		}
+
+		a = sBoxLayer(a, isbox) ^ context->roundKeys[0];
+		b = sBoxLayer(b, isbox) ^ context->roundKeys[0];
+
+		out[0] = (uint16_t)(a >> 48);
+		out[1] = (uint16_t)(a >> 32);
+		out[2] = (uint16_t)(a >> 16);
+		out[3] = (uint16_t)a;
+		out[4] = (uint16_t)(b >> 48);
+		out[5] = (uint16_t)(b >> 32);
+		out[6] = (uint16_t)(b >> 16);
+		out[7] = (uint16_t)b;
+	}
+
+	if (nrBlocks > 0)
+	{
+		PRESENT_decrypt(context, (uint16_t*)blocks, out);
+	}
+}
+
+/*
+	Bitsliced engine: slice i holds bit i of the state of 64 blocks,
+	so the s-box is a boolean circuit on 64 bits words and the
+	permutation layer only changes which word is written. Without
+	table lookups or branches on secret data it runs in constant time.
+*/
+
+// 64x64 bit matrix transpose, bit j of word i moves to bit i of word j
+static void transpose64(uint64_t* x)
+{
+	uint64_t mask = 0x00000000ffffffff;
+	uint64_t temp;
+	int j;
+	int k;
+
+	for (j = 32; j != 0; j >>= 1, mask ^= mask << j)
+	{
+		for (k = 0; k < 64; k = ((k | j) + 1) & ~j)
+		{
+			temp = ((x[k] >> j) ^ x[k | j]) & mask;
+			x[k] ^= temp << j;
+			x[k | j] ^= temp;
+		}
+	}
+}
+
+// all ones when bit i of the round key is set, zero otherwise
+static uint64_t keyMask(uint64_t k, int i)
+{
+	return 0 - ((k >> i) & 1);
+}
+
+static void encryptSlices(const uint64_t* roundKeys, uint64_t* slices)
+{
+	uint64_t t[64];
+	uint64_t* in = slices;
+	uint64_t* out = t;
+	uint64_t* temp;
+	uint64_t x0, x1, x2, x3;
+	uint64_t T1, T2, T3, T4;
+	uint64_t y0, y1, y2, y3;
+	uint64_t k;
+	int round;
+	int n;
+	int i;
+
+	for (round = 0; round < NR_ROUNDS; round++)
+	{
+		k = roundKeys[round];
+
+		for (n = 0; n < 16; n++)
+		{
+			x0 = in[4 * n] ^ keyMask(k, 4 * n);
+			x1 = in[4 * n + 1] ^ keyMask(k, 4 * n + 1);
+			x2 = in[4 * n + 2] ^ keyMask(k, 4 * n + 2);
+			x3 = in[4 * n + 3] ^ keyMask(k, 4 * n + 3);
+
+			// s-box in 14 operations
+			T1 = x1 ^ x2;
+			T2 = x2 & T1;
+			T3 = x3 ^ T2;
+			y0 = x0 ^ T3;
+			T2 = T1 & T3;
+			T1 ^= y0;
+			T2 ^= x2;
+			T4 = x0 | T2;
+			y1 = T1 ^ T4;
+			T2 ^= ~x0;
+			y3 = y1 ^ T2;
+			T2 |= T1;
+			y2 = T3 ^ T2;
+
+			// permutation layer, bit 4n + b moves to bit 16b + n
+			out[n] = y0;
+			out[16 + n] = y1;
+			out[32 + n] = y2;
+			out[48 + n] = y3;
+		}
+
+		temp = in;
+		in = out;
+		out = temp;
+	}
+
+	// odd number of rounds, the state ended in the local copy
+	k = roundKeys[NR_ROUNDS];
+
+	for (i = 0; i < 64; i++)
+	{
+		slices[i] = in[i] ^ keyMask(k, i);
+	}
+}
+
+static void decryptSlices(const uint64_t* roundKeys, uint64_t* slices)
+{
+	uint64_t t[64];
+	uint64_t* in = slices;
+	uint64_t* out = t;
+	uint64_t* temp;
+	uint64_t x0, x1, x2, x3;
+	uint64_t a01, a02, a03, a12, a13, a23, a012, a013, a023;
+	uint64_t T1, T2;
+	uint64_t k;
+	int round;
+	int n;
+	int i;
+
+	for (round = NR_ROUNDS; round > 0; round--)
+	{
+		k = roundKeys[round];
+
+		for (n = 0; n < 16; n++)
+		{
+			// inverse permutation layer, bit 16b + n moves to bit 4n + b
+			x0 = in[n] ^ keyMask(k, n);
+			x1 = in[16 + n] ^ keyMask(k, 16 + n);
+			x2 = in[32 + n] ^ keyMask(k, 32 + n);
+			x3 = in[48 + n] ^ keyMask(k, 48 + n);
+
+			// inverse s-box from its algebraic normal form
+			a01 = x0 & x1;
+			a02 = x0 & x2;
+			a03 = x0 & x3;
+			a12 = x1 & x2;
+			a13 = x1 & x3;
+			a23 = x2 & x3;
+			a012 = a01 & x2;
+			a013 = a01 & x3;
+			a023 = a02 & x3;
+
+			T1 = x0 ^ x1 ^ x3 ^ a012 ^ a023;
+			T2 = a02 ^ a13 ^ a013;
+
+			out[4 * n] = ~(x0 ^ x2 ^ a13);
+			out[4 * n + 1] = T1 ^ T2 ^ a23;
+			out[4 * n + 2] = ~(T2 ^ a01 ^ a12 ^ a012 ^ x3 ^ a03 ^ a023);
+			out[4 * n + 3] = T1 ^ a01 ^ x2;
+		}
+
+		temp = in;
+		in = out;
+		out = temp;
+	}
+
+	k = roundKeys[0];
+
+	for (i = 0; i < 64; i++)
+	{
+		slices[i] = in[i] ^ keyMask(k, i);
+	}
+}
+
+/*
+	Transpose up to 64 blocks of every group into slices, run the
+	rounds on all groups at once and transpose back. The last call
+	pads the missing blocks with zeros. The AVX2 slices are used only
+	for more than 128 blocks, below that the padding costs more than
+	the scalar slices of 64 blocks.
+*/
+static void PRESENT_bitsliced(PresentContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks, int decrypt)
+{
+	uint64_t slices[64 * PRESENT_AVX2_GROUPS];
+	uint64_t states[BITSLICE_BLOCKS];
+	size_t nrGroups;
+	size_t n;
+	size_t g;
+	size_t i;
+	size_t j;
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 4 * n, out += 4 * n)
+	{
+		nrGroups = CPU_has(CPU_AVX2) && nrBlocks >= AVX2_MIN_BLOCKS ? PRESENT_AVX2_GROUPS : 1;
+		n = nrBlocks < nrGroups * BITSLICE_BLOCKS ? nrBlocks : nrGroups * BITSLICE_BLOCKS;
+
+		for (g = 0; g < nrGroups; g++)
+		{
+			for (i = 0; i < BITSLICE_BLOCKS; i++)
+			{
+				j = g * BITSLICE_BLOCKS + i;
+				states[i] = j >= n ? 0 : (uint64_t)blocks[4 * j] << 48
+					| (uint64_t)blocks[4 * j + 1] << 32
+					| (uint64_t)blocks[4 * j + 2] << 16
+					| blocks[4 * j + 3];
+			}
+
+			transpose64(states);
+
+			for (i = 0; i < 64; i++)
+			{
+				slices[nrGroups * i + g] = states[i];
+			}
+		}
+
+#ifdef PRESENT_AVX2
+		if (nrGroups == PRESENT_AVX2_GROUPS)
+		{
+			if (decrypt)
+			{
+				PRESENT_decrypt_slices_avx2(context->roundKeys, slices);
+			}
+			else
+			{
+				PRESENT_encrypt_slices_avx2(context->roundKeys, slices);
+			}
+		}
+		else
+#endif
+		if (decrypt)
+		{
+			decryptSlices(context->roundKeys, slices);
+		}
+		else
+		{
+			encryptSlices(context->roundKeys, slices);
+		}
+
+		for (g = 0; g < nrGroups; g++)
+		{
+			for (i = 0; i < 64; i++)
+			{
+				states[i] = slices[nrGroups * i + g];
+			}
+
+			transpose64(states);
+
+			for (i = 0; i < BITSLICE_BLOCKS; i++)
+			{
+				j = g * BITSLICE_BLOCKS + i;
+				if (j < n)
+				{
+					out[4 * j] = (uint16_t)(states[i] >> 48);
+					out[4 * j + 1] = (uint16_t)(states[i] >> 32);
+					out[4 * j + 2] = (uint16_t)(states[i] >> 16);
+					out[4 * j + 3] = (uint16_t)states[i];
+				}
+			}
+		}
+	}
+}
+
+/*
+	Constant time bulk ECB processing of nrBlocks consecutive blocks,
+	64 blocks at a time, or 256 when the CPU supports AVX2.
+*/
+void PRESENT_encrypt_bitsliced(PresentContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks)
+{
+	PRESENT_bitsliced(context, blocks, out, nrBlocks, 0);
+}
+
+void PRESENT_decrypt_bitsliced(PresentContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks)
+{
+	PRESENT_bitsliced(context, blocks, out, nrBlocks, 1);
+}
+
 void PRESENT_main(void)
 {
 	PresentContext context;
@@ -332,11 +1865,11 @@ void PRESENT_main(void)
 
 	// *** 128-bits key test ***
 
-	// expected encryption text 04bdd5f4 eaefcc19
-	expectedCipherText[0] = 0x04bd;
-	expectedCipherText[1] = 0xd5f4;
-	expectedCipherText[2] = 0xeaef;
-	expectedCipherText[3] = 0xcc19;
+	// expected encryption text 96db702a 2e6900af
+	expectedCipherText[0] = 0x96db;
+	expectedCipherText[1] = 0x702a;
+	expectedCipherText[2] = 0x2e69;
+	expectedCipherText[3] = 0x00af;
 
 	PRESENT_init(&context, key, 128);
 
@@ -379,4 +1912,54 @@ void PRESENT_main(void)
 		printf("%08x ", decryptedText[i]);
 	}
 	printf("\n");
+
+	// *** table driven path against the reference path ***
+
+	uint16_t referenceText[4];
+	int matches = 1;
+
+	for (i = 0; i < 1000; i++)
+	{
+		text[0] = (uint16_t)(i * 0x9e37);
+		text[1] = (uint16_t)(i * 0x79b9);
+		text[2] = (uint16_t)(i * 0x7f4a);
+		text[3] = (uint16_t)(i * 0x7c15);
+		key[i % 8] ^= text[i % 4];
+
+		PRESENT_init(&context, key, i % 2 == 0 ? 80 : 128);
+
+		PRESENT_encrypt(&context, text, cipherText);
+		PRESENT_encrypt_reference(&context, text, referenceText);
+		matches &= memcmp(cipherText, referenceText, sizeof(cipherText)) == 0;
+
+		PRESENT_decrypt(&context, text, decryptedText);
+		PRESENT_decrypt_reference(&context, text, referenceText);
+		matches &= memcmp(decryptedText, referenceText, sizeof(decryptedText)) == 0;
+	}
+
+	printf("\ntable driven path against reference path: %s\n", matches ? "ok" : "FAILED");
+
+	// *** bitsliced engine against the reference path ***
+
+	uint16_t blocks[4 * 300];
+	uint16_t bitsliced[4 * 300];
+
+	for (i = 0; i < 4 * 300; i++)
+	{
+		blocks[i] = (uint16_t)(i * 0x9e37 + 0x79b9);
+	}
+
+	matches = 1;
+
+	PRESENT_encrypt_bitsliced(&context, blocks, bitsliced, 300);
+	for (i = 0; i < 300; i++)
+	{
+		PRESENT_encrypt_reference(&context, blocks + 4 * i, referenceText);
+		matches &= memcmp(bitsliced + 4 * i, referenceText, sizeof(referenceText)) == 0;
+	}
+
+	PRESENT_decrypt_bitsliced(&context, bitsliced, bitsliced, 300);
+	matches &= memcmp(bitsliced, blocks, sizeof(blocks)) == 0;
+
+	printf("bitsliced engine against reference path: %s\n", matches ? "ok" : "FAILED");
 }
\ No newline at end of file
@@ -13,10 +13,18 @@
 typedef struct
 {
 	uint64_t roundKeys[32];
+	// round keys through the inverse permutation layer, used by the table driven decryption
+	uint64_t decryptionKeys[32];
 } PresentContext;
 
 void PRESENT_init(PresentContext* context, uint16_t* key, uint16_t keyLen);
 void PRESENT_encrypt(PresentContext* context, uint16_t* block, uint16_t* out);
 void PRESENT_decrypt(PresentContext* context, uint16_t* block, uint16_t* out);
+void PRESENT_encrypt_reference(PresentContext* context, uint16_t* block, uint16_t* out);
+void PRESENT_decrypt_reference(PresentContext* context, uint16_t* block, uint16_t* out);
+void PRESENT_encrypt_blocks(PresentContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks);
+void PRESENT_decrypt_blocks(PresentContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks);
+void PRESENT_encrypt_bitsliced(PresentContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks);
+void PRESENT_decrypt_bitsliced(PresentContext* context, const uint16_t* blocks, uint16_t* out, size_t nrBlocks);
 
 void PRESENT_main(void);
\ No newline at end of file
@@ -0,0 +1,164 @@
+/* PRESENT_AVX2.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Bitsliced PRESENT rounds with AVX2, 256 blocks per call.
+ *
+ * Every 256 bits register holds one bit of the state of all the
+ * blocks, so the s-box is a boolean circuit on registers and the
+ * permutation layer only changes which register is written. There
+ * are no table lookups and no branches on data or key, so the
+ * running time does not depend on them.
+ *
+ */
+
+#include "PRESENT_AVX2.h"
+
+#ifdef PRESENT_AVX2
+
+#include <immintrin.h>
+
+#define NR_ROUNDS 31
+
+// all ones when bit i of the round key is set, zero otherwise
+static __m256i keyMask(uint64_t k, int i)
+{
+	return _mm256_set1_epi64x((long long)(0 - ((k >> i) & 1)));
+}
+
+void PRESENT_encrypt_slices_avx2(const uint64_t* roundKeys, uint64_t* slices)
+{
+	__m256i s[64];
+	__m256i t[64];
+	__m256i* in = s;
+	__m256i* out = t;
+	__m256i* temp;
+	__m256i x0, x1, x2, x3;
+	__m256i T1, T2, T3, T4;
+	__m256i y0, y1, y2, y3;
+	const __m256i ones = _mm256_set1_epi64x(-1);
+	uint64_t k;
+	int round;
+	int n;
+	int i;
+
+	for (i = 0; i < 64; i++)
+	{
+		s[i] = _mm256_loadu_si256((const __m256i*)(slices + PRESENT_AVX2_GROUPS * i));
+	}
+
+	for (round = 0; round < NR_ROUNDS; round++)
+	{
+		k = roundKeys[round];
+
+		for (n = 0; n < 16; n++)
+		{
+			x0 = _mm256_xor_si256(in[4 * n], keyMask(k, 4 * n));
+			x1 = _mm256_xor_si256(in[4 * n + 1], keyMask(k, 4 * n + 1));
+			x2 = _mm256_xor_si256(in[4 * n + 2], keyMask(k, 4 * n + 2));
+			x3 = _mm256_xor_si256(in[4 * n + 3], keyMask(k, 4 * n + 3));
+
+			// s-box
+			T1 = _mm256_xor_si256(x1, x2);
+			T2 = _mm256_and_si256(x2, T1);
+			T3 = _mm256_xor_si256(x3, T2);
+			y0 = _mm256_xor_si256(x0, T3);
+			T2 = _mm256_and_si256(T1, T3);
+			T1 = _mm256_xor_si256(T1, y0);
+			T2 = _mm256_xor_si256(T2, x2);
+			T4 = _mm256_or_si256(x0, T2);
+			y1 = _mm256_xor_si256(T1, T4);
+			T2 = _mm256_xor_si256(T2, _mm256_xor_si256(x0, ones));
+			y3 = _mm256_xor_si256(y1, T2);
+			T2 = _mm256_or_si256(T2, T1);
+			y2 = _mm256_xor_si256(T3, T2);
+
+			// permutation layer, bit 4n + b moves to bit 16b + n
+			out[n] = y0;
+			out[16 + n] = y1;
+			out[32 + n] = y2;
+			out[48 + n] = y3;
+		}
+
+		temp = in;
+		in = out;
+		out = temp;
+	}
+
+	k = roundKeys[NR_ROUNDS];
+
+	for (i = 0; i < 64; i++)
+	{
+		_mm256_storeu_si256((__m256i*)(slices + PRESENT_AVX2_GROUPS * i), _mm256_xor_si256(in[i], keyMask(k, i)));
+	}
+}
+
+void PRESENT_decrypt_slices_avx2(const uint64_t* roundKeys, uint64_t* slices)
+{
+	__m256i s[64];
+	__m256i t[64];
+	__m256i* in = s;
+	__m256i* out = t;
+	__m256i* temp;
+	__m256i x0, x1, x2, x3;
+	__m256i a01, a02, a03, a12, a13, a23, a012, a013, a023;
+	__m256i T1, T2;
+	const __m256i ones = _mm256_set1_epi64x(-1);
+	uint64_t k;
+	int round;
+	int n;
+	int i;
+
+	for (i = 0; i < 64; i++)
+	{
+		s[i] = _mm256_loadu_si256((const __m256i*)(slices + PRESENT_AVX2_GROUPS * i));
+	}
+
+	for (round = NR_ROUNDS; round > 0; round--)
+	{
+		k = roundKeys[round];
+
+		for (n = 0; n < 16; n++)
+		{
+			// inverse permutation layer, bit 16b + n moves to bit 4n + b
+			x0 = _mm256_xor_si256(in[n], keyMask(k, n));
+			x1 = _mm256_xor_si256(in[16 + n], keyMask(k, 16 + n));
+			x2 = _mm256_xor_si256(in[32 + n], keyMask(k, 32 + n));
+			x3 = _mm256_xor_si256(in[48 + n], keyMask(k, 48 + n));
+
+			// inverse s-box
+			a01 = _mm256_and_si256(x0, x1);
+			a02 = _mm256_and_si256(x0, x2);
+			a03 = _mm256_and_si256(x0, x3);
+			a12 = _mm256_and_si256(x1, x2);
+			a13 = _mm256_and_si256(x1, x3);
+			a23 = _mm256_and_si256(x2, x3);
+			a012 = _mm256_and_si256(a01, x2);
+			a013 = _mm256_and_si256(a01, x3);
+			a023 = _mm256_and_si256(a02, x3);
+
+			T1 = _mm256_xor_si256(_mm256_xor_si256(x0, x1), _mm256_xor_si256(x3, _mm256_xor_si256(a012, a023)));
+			T2 = _mm256_xor_si256(a02, _mm256_xor_si256(a13, a013));
+
+			out[4 * n] = _mm256_xor_si256(_mm256_xor_si256(x0, x2), _mm256_xor_si256(a13, ones));
+			out[4 * n + 1] = _mm256_xor_si256(T1, _mm256_xor_si256(T2, a23));
+			out[4 * n + 2] = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(T2, a01), _mm256_xor_si256(a12, a012)),
+				_mm256_xor_si256(_mm256_xor_si256(x3, a03), _mm256_xor_si256(a023, ones)));
+			out[4 * n + 3] = _mm256_xor_si256(T1, _mm256_xor_si256(a01, x2));
+		}
+
+		temp = in;
+		in = out;
+		out = temp;
+	}
+
+	k = roundKeys[0];
+
+	for (i = 0; i < 64; i++)
+	{
+		_mm256_storeu_si256((__m256i*)(slices + PRESENT_AVX2_GROUPS * i), _mm256_xor_si256(in[i], keyMask(k, i)));
+	}
+}
+
+#endif
@@ -0,0 +1,28 @@
+/* PRESENT_AVX2.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Bitsliced PRESENT rounds on four groups of 64 blocks with AVX2,
+ * used by the bitsliced bulk functions of PRESENT.c when the CPU
+ * supports it. Must be compiled with AVX2 enabled.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define PRESENT_AVX2
+#endif
+
+// groups of 64 blocks in a 256 bits register
+#define PRESENT_AVX2_GROUPS 4
+
+/*
+	slices holds 64 slices of PRESENT_AVX2_GROUPS words, word g of
+	slice i has bit i of the 64 blocks of group g.
+*/
+void PRESENT_encrypt_slices_avx2(const uint64_t* roundKeys, uint64_t* slices);
+void PRESENT_decrypt_slices_avx2(const uint64_t* roundKeys, uint64_t* slices);
@@ -16,7 +16,11 @@
  *
  */
 
+#include <string.h>
+
 #include "SEED.h"
+#include "SEED_AVX2.h"
+#include "../../cpu/CPU.h"
 
 #define NR_ROUNDS 16
 
@@ -213,19 +217,20 @@ void SEED_init(SeedContext* context, uint32_t* key)
 		context->subkeys[i * 2] = G(keys[0] + keys[2] - KC[i]);
 		context->subkeys[i * 2 + 1] = G(keys[1] - keys[3] + KC[i]);
 
-		if (i % 2 != 0)
+		// i is zero based, so even i are the odd rounds of the specification
+		if (i % 2 == 0)
 		{
 			// odd rounds: Key0 || Key1 = (Key0 || Key1) >>> 8
-			temp = key[1] >> 8 | key[0] << 24;
-			key[0] = key[0] >> 8 | key[1] << 24;
-			key[1] = temp;
+			temp = keys[1] >> 8 | keys[0] << 24;
+			keys[0] = keys[0] >> 8 | keys[1] << 24;
+			keys[1] = temp;
 		}
 		else
 		{
 			// even rounds: Key2 || Key3 = (Key2 || Key3) <<< 8
-			temp = key[3] >> 8 | key[2] << 24;
-			key[2] = key[2] >> 8 | key[3] << 24;
-			key[3] = temp;
+			temp = keys[3] << 8 | keys[2] >> 24;
+			keys[2] = keys[2] << 8 | keys[3] >> 24;
+			keys[3] = temp;
 		}
 	}
 }
@@ -324,73 +329,227 @@ void SEED_decrypt(SeedContext* context, uint32_t* block, uint32_t* out)
 	out[3] = r1;
 }
 
+// tables of G, for the SIMD kernel
+static const uint32_t* const ss[4] = { ss0, ss1, ss2, ss3 };
+
+/*
+	Four blocks through the F function with the same subkeys, each G
+	lookup of one block is independent of the other blocks' lookups
+	so their table loads overlap instead of waiting on each other.
+*/
+static void F4(uint32_t* a, uint32_t* b, uint32_t* c, uint32_t* d, uint32_t Ki0, uint32_t Ki1)
+{
+	// a, b, c and d are { R0, R1 } on input and { out0, out1 } on output
+	uint32_t a0 = a[0] ^ Ki0;
+	uint32_t b0 = b[0] ^ Ki0;
+	uint32_t c0 = c[0] ^ Ki0;
+	uint32_t d0 = d[0] ^ Ki0;
+	uint32_t a1 = G(a0 ^ a[1] ^ Ki1);
+	uint32_t b1 = G(b0 ^ b[1] ^ Ki1);
+	uint32_t c1 = G(c0 ^ c[1] ^ Ki1);
+	uint32_t d1 = G(d0 ^ d[1] ^ Ki1);
+
+	a0 = G(a1 + a0);
+	b0 = G(b1 + b0);
+	c0 = G(c1 + c0);
+	d0 = G(d1 + d0);
+	a1 = G(a1 + a0);
+	b1 = G(b1 + b0);
+	c1 = G(c1 + c0);
+	d1 = G(d1 + d0);
+
+	a[0] = a0 + a1;
+	b[0] = b0 + b1;
+	c[0] = c0 + c1;
+	d[0] = d0 + d1;
+	a[1] = a1;
+	b[1] = b1;
+	c[1] = c1;
+	d[1] = d1;
+}
+
+/*
+	Bulk ECB processing of nrBlocks consecutive blocks, the step is
+	2 for encryption (ascending subkeys) and -2 for decryption.
+
+	The AVX2 kernel takes 16 blocks at a time, then 8, the portable
+	code interleaves 4 blocks and finishes the rest one by one.
+*/
+static void SEED_blocks(SeedContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks, int firstSubkey, int step)
+{
+	int i;
+	int j;
+	int subkey;
+	// the four blocks, { L0, L1, R0, R1 } each
+	uint32_t x[4][4];
+	// F of the right halves
+	uint32_t t[4][2];
+	size_t done;
+
+#ifdef SEED_AVX2
+	if (CPU_has(CPU_AVX2))
+	{
+		done = SEED_blocks_avx2(context->subkeys, firstSubkey, step, ss, blocks, out, nrBlocks);
+		nrBlocks -= done;
+		blocks += 4 * done;
+		out += 4 * done;
+	}
+#endif
+
+	for (; nrBlocks >= 4; nrBlocks -= 4, blocks += 16, out += 16)
+	{
+		memcpy(x, blocks, sizeof(x));
+		subkey = firstSubkey;
+
+		for (i = 0; i < NR_ROUNDS; i++, subkey += step)
+		{
+			for (j = 0; j < 4; j++)
+			{
+				t[j][0] = x[j][2];
+				t[j][1] = x[j][3];
+			}
+
+			F4(t[0], t[1], t[2], t[3], context->subkeys[subkey], context->subkeys[subkey + 1]);
+
+			for (j = 0; j < 4; j++)
+			{
+				t[j][0] ^= x[j][0];
+				t[j][1] ^= x[j][1];
+
+				// last round we update l instead of r
+				if (i == NR_ROUNDS - 1)
+				{
+					x[j][0] = t[j][0];
+					x[j][1] = t[j][1];
+				}
+				else
+				{
+					x[j][0] = x[j][2];
+					x[j][1] = x[j][3];
+					x[j][2] = t[j][0];
+					x[j][3] = t[j][1];
+				}
+			}
+		}
+
+		memcpy(out, x, sizeof(x));
+	}
+
+	for (; nrBlocks > 0; nrBlocks--, blocks += 4, out += 4)
+	{
+		if (step > 0)
+		{
+			SEED_encrypt(context, (uint32_t*)blocks, out);
+		}
+		else
+		{
+			SEED_decrypt(context, (uint32_t*)blocks, out);
+		}
+	}
+}
+
+void SEED_encrypt_blocks(SeedContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	SEED_blocks(context, blocks, out, nrBlocks, 0, 2);
+}
+
+void SEED_decrypt_blocks(SeedContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	SEED_blocks(context, blocks, out, nrBlocks, 30, -2);
+}
+
 void SEED_main(void)
 {
 	SeedContext context;
 	int i;
+	int j;
+	int ok;
 	uint32_t key[4];
 	uint32_t text[4];
 	uint32_t cipherText[4];
 	uint32_t expectedCipherText[4];
 	uint32_t decryptedText[4];
 
-	// key 00000000 00000000 00000000 00000000
-	key[0] = 0x00000000;
-	key[1] = 0x00000000;
-	key[2] = 0x00000000;
-	key[3] = 0x00000000;
+	// the 4 test vectors of RFC 4269 appendix B: key, text, expected encrypted text
+	static const uint32_t vectors[4][3][4] = {
+		{
+			{ 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+			{ 0x00010203, 0x04050607, 0x08090A0B, 0x0C0D0E0F },
+			{ 0x5EBAC6E0, 0x054E1668, 0x19AFF1CC, 0x6D346CDB }
+		},
+		{
+			{ 0x00010203, 0x04050607, 0x08090A0B, 0x0C0D0E0F },
+			{ 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+			{ 0xC11F22F2, 0x01405050, 0x84483597, 0xE4370F43 }
+		},
+		{
+			{ 0x47064808, 0x51E61BE8, 0x5D74BFB3, 0xFD956185 },
+			{ 0x83A2F8A2, 0x88641FB9, 0xA4E9A5CC, 0x2F131C7D },
+			{ 0xEE54D13E, 0xBCAE706D, 0x226BC314, 0x2CD40D4A }
+		},
+		{
+			{ 0x28DBC3BC, 0x49FFD87D, 0xCFA509B1, 0x1D422BE7 },
+			{ 0xB41E6BE2, 0xEBA84A14, 0x8E2EED84, 0x593C5EC7 },
+			{ 0x9B9B7BFC, 0xD1813CB9, 0x5D0B3618, 0xF40F5122 }
+		}
+	};
 
-	// text 00010203 04050607 08090A0B 0C0D0E0F
-	text[0] = 0x00010203;
-	text[1] = 0x04050607;
-	text[2] = 0x08090A0B;
-	text[3] = 0x0C0D0E0F;
+	for (j = 0; j < 4; j++)
+	{
+		for (i = 0; i < 4; i++)
+		{
+			key[i] = vectors[j][0][i];
+			text[i] = vectors[j][1][i];
+			expectedCipherText[i] = vectors[j][2][i];
+		}
 
-	// expected encryption text 5EBAC6E0 054E1668 19AFF1CC 6D346CDB
-	expectedCipherText[0] = 0x5EBAC6E0;
-	expectedCipherText[1] = 0x054E1668;
-	expectedCipherText[2] = 0x19AFF1CC;
-	expectedCipherText[3] = 0x6D346CDB;
+		SEED_init(&context, key);
 
-	SEED_init(&context, key);
+		SEED_encrypt(&context, text, cipherText);
+		SEED_decrypt(&context, cipherText, decryptedText);
 
-	SEED_encrypt(&context, text, cipherText);
-	SEED_decrypt(&context, cipherText, decryptedText);
+		printf("\nSEED 128-bits key, RFC 4269 vector %d \n\n", j + 1);
 
-	printf("\nSEED 128-bits key \n\n");
+		printf("key: \t\t\t\t");
+		for (i = 0; i < 4; i++)
+		{
+			printf("%08x ", key[i]);
+		}
+		printf("\n");
 
-	printf("key: \t\t\t\t");
-	for (i = 0; i < 4; i++)
-	{
-		printf("%08x ", key[i]);
-	}
-	printf("\n");
+		printf("text: \t\t\t\t");
+		for (i = 0; i < 4; i++)
+		{
+			printf("%08x ", text[i]);
+		}
+		printf("\n");
 
-	printf("text: \t\t\t\t");
-	for (i = 0; i < 4; i++)
-	{
-		printf("%08x ", text[i]);
-	}
-	printf("\n");
+		printf("encrypted text: \t\t");
+		for (i = 0; i < 4; i++)
+		{
+			printf("%08x ", cipherText[i]);
+		}
+		printf("\n");
 
-	printf("encrypted text: \t\t");
-	for (i = 0; i < 4; i++)
-	{
-		printf("%08x ", cipherText[i]);
-	}
-	printf("\n");
+		printf("expected encrypted text: \t");
+		for (i = 0; i < 4; i++)
+		{
+			printf("%08x ", expectedCipherText[i]);
+		}
+		printf("\n");
 
-	printf("expected encrypted text: \t");
-	for (i = 0; i < 4; i++)
-	{
-		printf("%08x ", expectedCipherText[i]);
-	}
-	printf("\n");
+		printf("decrypted text: \t\t");
+		for (i = 0; i < 4; i++)
+		{
+			printf("%08x ", decryptedText[i]);
+		}
+		printf("\n");
 
-	printf("decrypted text: \t\t");
-	for (i = 0; i < 4; i++)
-	{
-		printf("%08x ", decryptedText[i]);
+		ok = 1;
+		for (i = 0; i < 4; i++)
+		{
+			ok &= cipherText[i] == expectedCipherText[i] && decryptedText[i] == text[i];
+		}
+		printf("test vector: \t\t\t%s\n", ok ? "ok" : "FAILED");
 	}
-	printf("\n");
 }
@@ -18,5 +18,7 @@ typedef struct
 void SEED_init(SeedContext* context, uint32_t* key);
 void SEED_encrypt(SeedContext* context, uint32_t* block, uint32_t* out);
 void SEED_decrypt(SeedContext* context, uint32_t* block, uint32_t* out);
+void SEED_encrypt_blocks(SeedContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
+void SEED_decrypt_blocks(SeedContext* context, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
 
 void SEED_main(void);
\ No newline at end of file
@@ -0,0 +1,135 @@
+/* SEED_AVX2.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * SEED bulk encryption and decryption with AVX2.
+ *
+ * After a 4x4 transposition of the words in each 128 bits half,
+ * register i holds the word i of eight blocks. G is then four
+ * vpgatherdd lookups, one per table, for the eight blocks at once.
+ * Two groups of eight blocks run side by side, the gathers are
+ * long latency loads and one group alone leaves the CPU waiting.
+ *
+ */
+
+#include "SEED_AVX2.h"
+
+#ifdef SEED_AVX2
+
+#include <immintrin.h>
+
+#define NR_ROUNDS 16
+
+#define LOOKUP(table, x) _mm256_i32gather_epi32((const int*)(table), x, 4)
+
+#define G(x) _mm256_xor_si256( \
+	_mm256_xor_si256(LOOKUP(ss[0], _mm256_and_si256(x, byteMask)), LOOKUP(ss[1], _mm256_and_si256(_mm256_srli_epi32(x, 8), byteMask))), \
+	_mm256_xor_si256(LOOKUP(ss[2], _mm256_and_si256(_mm256_srli_epi32(x, 16), byteMask)), LOOKUP(ss[3], _mm256_srli_epi32(x, 24))))
+
+// word i of the blocks into ai, the transposition is its own inverse
+#define TRANSPOSE(a0, a1, a2, a3) \
+	t0 = _mm256_unpacklo_epi32(a0, a1); \
+	t1 = _mm256_unpacklo_epi32(a2, a3); \
+	t2 = _mm256_unpackhi_epi32(a0, a1); \
+	t3 = _mm256_unpackhi_epi32(a2, a3); \
+	a0 = _mm256_unpacklo_epi64(t0, t1); \
+	a1 = _mm256_unpackhi_epi64(t0, t1); \
+	a2 = _mm256_unpacklo_epi64(t2, t3); \
+	a3 = _mm256_unpackhi_epi64(t2, t3)
+
+// one round on the words a0..a3 of eight blocks, t0 and t1 are scratch
+#define ROUND(a0, a1, a2, a3, t0, t1, i) \
+	t0 = _mm256_xor_si256(a2, k[2 * (i)]); \
+	t1 = G(_mm256_xor_si256(_mm256_xor_si256(t0, a3), k[2 * (i) + 1])); \
+	t0 = G(_mm256_add_epi32(t1, t0)); \
+	t1 = G(_mm256_add_epi32(t1, t0)); \
+	t0 = _mm256_add_epi32(t0, t1); \
+	t0 = _mm256_xor_si256(t0, a0); \
+	t1 = _mm256_xor_si256(t1, a1); \
+	a0 = a2; \
+	a1 = a3; \
+	a2 = t0; \
+	a3 = t1
+
+// the last round updates l instead of r, undo the swap of ROUND
+#define UNSWAP(a0, a1, a2, a3, t0, t1) \
+	t0 = a0; \
+	t1 = a1; \
+	a0 = a2; \
+	a1 = a3; \
+	a2 = t0; \
+	a3 = t1
+
+#define LOAD(a0, a1, a2, a3, p) \
+	a0 = _mm256_loadu_si256((const __m256i*)(p)); \
+	a1 = _mm256_loadu_si256((const __m256i*)(p) + 1); \
+	a2 = _mm256_loadu_si256((const __m256i*)(p) + 2); \
+	a3 = _mm256_loadu_si256((const __m256i*)(p) + 3); \
+	TRANSPOSE(a0, a1, a2, a3)
+
+#define STORE(p, a0, a1, a2, a3) \
+	TRANSPOSE(a0, a1, a2, a3); \
+	_mm256_storeu_si256((__m256i*)(p), a0); \
+	_mm256_storeu_si256((__m256i*)(p) + 1, a1); \
+	_mm256_storeu_si256((__m256i*)(p) + 2, a2); \
+	_mm256_storeu_si256((__m256i*)(p) + 3, a3)
+
+size_t SEED_blocks_avx2(const uint32_t* subkeys, int firstSubkey, int step, const uint32_t* const* ss, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	const __m256i byteMask = _mm256_set1_epi32(0xff);
+	__m256i k[2 * NR_ROUNDS];
+	// l0, l1, r0 and r1 of two groups of eight blocks
+	__m256i a0, a1, a2, a3;
+	__m256i b0, b1, b2, b3;
+	__m256i t0, t1, t2, t3;
+	size_t done;
+	int subkey;
+	int i;
+
+	if (nrBlocks < 8)
+	{
+		return 0;
+	}
+
+	for (i = 0, subkey = firstSubkey; i < NR_ROUNDS; i++, subkey += step)
+	{
+		k[2 * i] = _mm256_set1_epi32((int)subkeys[subkey]);
+		k[2 * i + 1] = _mm256_set1_epi32((int)subkeys[subkey + 1]);
+	}
+
+	// two independent groups, so the gathers of one hide the latency of the other
+	for (done = 0; nrBlocks - done >= 16; done += 16, blocks += 64, out += 64)
+	{
+		LOAD(a0, a1, a2, a3, blocks);
+		LOAD(b0, b1, b2, b3, blocks + 32);
+
+		for (i = 0; i < NR_ROUNDS; i++)
+		{
+			ROUND(a0, a1, a2, a3, t0, t1, i);
+			ROUND(b0, b1, b2, b3, t2, t3, i);
+		}
+
+		UNSWAP(a0, a1, a2, a3, t0, t1);
+		UNSWAP(b0, b1, b2, b3, t2, t3);
+		STORE(out, a0, a1, a2, a3);
+		STORE(out + 32, b0, b1, b2, b3);
+	}
+
+	for (; nrBlocks - done >= 8; done += 8, blocks += 32, out += 32)
+	{
+		LOAD(a0, a1, a2, a3, blocks);
+
+		for (i = 0; i < NR_ROUNDS; i++)
+		{
+			ROUND(a0, a1, a2, a3, t0, t1, i);
+		}
+
+		UNSWAP(a0, a1, a2, a3, t0, t1);
+		STORE(out, a0, a1, a2, a3);
+	}
+
+	return done;
+}
+
+#endif
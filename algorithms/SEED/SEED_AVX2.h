@@ -0,0 +1,29 @@
+/* SEED_AVX2.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * SEED bulk kernel with AVX2 gathers, used by the bulk functions of
+ * SEED.c when the CPU supports it. Must be compiled with AVX2
+ * enabled.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SEED_AVX2
+#endif
+
+/*
+	Process the largest multiple of 8 blocks of nrBlocks and return
+	how many blocks were processed, the caller handles the rest.
+
+	ss holds the four 256 entries tables of G. The round i uses the
+	subkeys firstSubkey + i * step and the one after it, the step is
+	2 for encryption and -2 for decryption.
+*/
+size_t SEED_blocks_avx2(const uint32_t* subkeys, int firstSubkey, int step, const uint32_t* const* ss, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
@@ -15,6 +15,9 @@
  */
 
 #include "SIMON.h"
+#include "SIMON_SSE2.h"
+#include "SIMON_AVX2.h"
+#include "../../cpu/CPU.h"
 
 // Rotate Left circular shift 32 bits
 static uint64_t ROL_64(uint64_t x, uint32_t n)
@@ -41,6 +44,23 @@ static void R2(uint64_t* x, uint64_t* y, uint64_t k, uint64_t l)
 	*x ^= l;
 }
 
+// key schedule terms of the previous subkey, and of the two before for 256-bits keys
+static uint64_t g(uint64_t x)
+{
+	return ROR_64(x, 3) ^ ROR_64(x, 4);
+}
+
+static uint64_t h(uint64_t x, uint64_t y)
+{
+	return g(x) ^ y ^ ROR_64(y, 1);
+}
+
+// bit i of the z sequence, z holds the bits 0 to 63 and tail the following ones
+static uint64_t zBit(uint64_t z, uint64_t tail, int i)
+{
+	return (i < 64 ? z >> i : tail >> (i - 64)) & 1;
+}
+
 void SIMON_init(SimonContext* context, uint64_t* key, uint16_t keyLen)
 {
 	uint64_t c = 0xfffffffffffffffcLL;
@@ -172,15 +192,561 @@ void SIMON_decrypt(SimonContext* context, uint64_t* block, uint64_t* out)
 	out[1] = y;
 }
 
+/*
+	Run the widest SIMD kernel supported by the CPU and return how
+	many blocks it processed, the remaining blocks go to the
+	portable code.
+*/
+static size_t SIMON_blocks_simd(const SimonContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks, int decrypt)
+{
+#ifdef SIMON_AVX2
+	if (CPU_has(CPU_AVX2))
+	{
+		return decrypt
+			? SIMON_decrypt_blocks_avx2(context->subkeys, context->nrSubkeys, blocks, out, nrBlocks)
+			: SIMON_encrypt_blocks_avx2(context->subkeys, context->nrSubkeys, blocks, out, nrBlocks);
+	}
+#endif
+
+#ifdef SIMON_SSE2
+	if (CPU_has(CPU_SSE2))
+	{
+		return decrypt
+			? SIMON_decrypt_blocks_sse2(context->subkeys, context->nrSubkeys, blocks, out, nrBlocks)
+			: SIMON_encrypt_blocks_sse2(context->subkeys, context->nrSubkeys, blocks, out, nrBlocks);
+	}
+#endif
+
+	return 0;
+}
+
+/*
+	Bulk ECB encryption of nrBlocks consecutive blocks.
+
+	The SIMD kernels take the bulk of the blocks. In the portable
+	code four independent blocks share every pair of subkeys, the 69
+	subkeys schedule (192-bits key) ends with a single round and
+	a swap exactly as in SIMON_encrypt.
+*/
+void SIMON_encrypt_blocks(SimonContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	uint8_t i;
+	uint8_t nrPairs = context->nrSubkeys & ~1;
+	uint64_t k;
+	uint64_t l;
+	uint64_t t;
+	uint64_t x0, y0, x1, y1, x2, y2, x3, y3;
+	size_t done = SIMON_blocks_simd(context, blocks, out, nrBlocks, 0);
+
+	nrBlocks -= done;
+	blocks += 2 * done;
+	out += 2 * done;
+
+	for (; nrBlocks >= 4; nrBlocks -= 4, blocks += 8, out += 8)
+	{
+		x0 = blocks[0]; y0 = blocks[1];
+		x1 = blocks[2]; y1 = blocks[3];
+		x2 = blocks[4]; y2 = blocks[5];
+		x3 = blocks[6]; y3 = blocks[7];
+
+		for (i = 0; i < nrPairs; i += 2)
+		{
+			k = context->subkeys[i];
+			l = context->subkeys[i + 1];
+			R2(&x0, &y0, k, l);
+			R2(&x1, &y1, k, l);
+			R2(&x2, &y2, k, l);
+			R2(&x3, &y3, k, l);
+		}
+
+		if (context->nrSubkeys == 69)
+		{
+			k = context->subkeys[68];
+			y0 ^= f(x0) ^ k; t = x0; x0 = y0; y0 = t;
+			y1 ^= f(x1) ^ k; t = x1; x1 = y1; y1 = t;
+			y2 ^= f(x2) ^ k; t = x2; x2 = y2; y2 = t;
+			y3 ^= f(x3) ^ k; t = x3; x3 = y3; y3 = t;
+		}
+
+		out[0] = x0; out[1] = y0;
+		out[2] = x1; out[3] = y1;
+		out[4] = x2; out[5] = y2;
+		out[6] = x3; out[7] = y3;
+	}
+
+	for (; nrBlocks > 0; nrBlocks--, blocks += 2, out += 2)
+	{
+		SIMON_encrypt(context, (uint64_t*)blocks, out);
+	}
+}
+
+void SIMON_decrypt_blocks(SimonContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	int i;
+	uint64_t k;
+	uint64_t l;
+	uint64_t t;
+	uint64_t x0, y0, x1, y1, x2, y2, x3, y3;
+	size_t done = SIMON_blocks_simd(context, blocks, out, nrBlocks, 1);
+
+	nrBlocks -= done;
+	blocks += 2 * done;
+	out += 2 * done;
+
+	for (; nrBlocks >= 4; nrBlocks -= 4, blocks += 8, out += 8)
+	{
+		x0 = blocks[0]; y0 = blocks[1];
+		x1 = blocks[2]; y1 = blocks[3];
+		x2 = blocks[4]; y2 = blocks[5];
+		x3 = blocks[6]; y3 = blocks[7];
+
+		if (context->nrSubkeys == 69)
+		{
+			k = context->subkeys[68];
+			t = y0; y0 = x0; x0 = t; y0 ^= k ^ f(x0);
+			t = y1; y1 = x1; x1 = t; y1 ^= k ^ f(x1);
+			t = y2; y2 = x2; x2 = t; y2 ^= k ^ f(x2);
+			t = y3; y3 = x3; x3 = t; y3 ^= k ^ f(x3);
+		}
+
+		for (i = (context->nrSubkeys & ~1) - 1; i >= 0; i -= 2)
+		{
+			k = context->subkeys[i];
+			l = context->subkeys[i - 1];
+			R2(&y0, &x0, k, l);
+			R2(&y1, &x1, k, l);
+			R2(&y2, &x2, k, l);
+			R2(&y3, &x3, k, l);
+		}
+
+		out[0] = x0; out[1] = y0;
+		out[2] = x1; out[3] = y1;
+		out[4] = x2; out[5] = y2;
+		out[6] = x3; out[7] = y3;
+	}
+
+	for (; nrBlocks > 0; nrBlocks--, blocks += 2, out += 2)
+	{
+		SIMON_decrypt(context, (uint64_t*)blocks, out);
+	}
+}
+
+/*
+	Compact context: only the master key and the last subkeys are
+	kept (72 bytes instead of 584), the subkeys are generated by the
+	recurrence of the key schedule interleaved with the rounds. The
+	recurrence can be solved for its oldest term, so decryption
+	generates the subkeys backwards from the last ones.
+
+	Past the 64 bits of the z constant the schedule continues with
+	the bits written as constants in SIMON_init, they are 1 0 for
+	128-bits keys, 0 1 for 192-bits keys and 0 1 0 0 for 256-bits keys.
+*/
+void SIMON_compact_init(SimonCompactContext* context, uint64_t* key, uint16_t keyLen)
+{
+	SimonContext expanded;
+	uint8_t m = (uint8_t)(keyLen / 64);
+	uint8_t i;
+
+	SIMON_init(&expanded, key, keyLen);
+
+	context->keyLen = keyLen;
+
+	for (i = 0; i < 4; i++)
+	{
+		context->key[i] = i < m ? key[i] : 0;
+		context->last[i] = i < m ? expanded.subkeys[expanded.nrSubkeys - m + i] : 0;
+	}
+}
+
+// full key schedule, for the bulk functions that reuse every subkey
+void SIMON_compact_expand(SimonCompactContext* context, SimonContext* expanded)
+{
+	SIMON_init(expanded, context->key, context->keyLen);
+}
+
+/*
+	Encryption under a key whose subkeys are generated during the
+	rounds, shared by the compact context and the batch of keys.
+*/
+static void encryptKey(const uint64_t* key, uint16_t keyLen, const uint64_t* block, uint64_t* out)
+{
+	uint64_t c = 0xfffffffffffffffcLL;
+	uint64_t x = block[0];
+	uint64_t y = block[1];
+	uint64_t z;
+	uint64_t t;
+	uint64_t A;
+	uint64_t B;
+	uint64_t C;
+	uint64_t D;
+	uint8_t i;
+
+	if (keyLen == 128)
+	{
+		z = 0x7369f885192c0ef5LL;
+
+		// A and B are the pair of subkeys of the next two rounds
+		A = key[1];
+		B = key[0];
+
+		for (i = 0; i < 33; i++)
+		{
+			if (i == 32)
+			{
+				z = 0x1;
+			}
+
+			R2(&x, &y, A, B);
+			A ^= c ^ (z & 1) ^ g(B);
+			B ^= c ^ (z >> 1 & 1) ^ g(A);
+			z >>= 2;
+		}
+
+		R2(&x, &y, A, B);
+	}
+	else if (keyLen == 192)
+	{
+		z = 0xfc2ce51207a635dbLL;
+
+		// six subkeys per iteration, A B C hold three consecutive ones
+		A = key[2];
+		B = key[1];
+		C = key[0];
+
+		for (i = 0; i < 11; i++)
+		{
+			if (i == 10)
+			{
+				z |= (uint64_t)0x2 << 4;
+			}
+
+			R2(&x, &y, A, B);
+			A ^= c ^ (z & 1) ^ g(C);
+			R2(&x, &y, C, A);
+			B ^= c ^ (z >> 1 & 1) ^ g(A);
+			C ^= c ^ (z >> 2 & 1) ^ g(B);
+			R2(&x, &y, B, C);
+			A ^= c ^ (z >> 3 & 1) ^ g(C);
+			B ^= c ^ (z >> 4 & 1) ^ g(A);
+			C ^= c ^ (z >> 5 & 1) ^ g(B);
+			z >>= 6;
+		}
+
+		// 69 subkeys, the last round is single and followed by a swap
+		R2(&x, &y, A, B);
+		y ^= f(x);
+		y ^= C;
+		t = x;
+		x = y;
+		y = t;
+	}
+	else // 256
+	{
+		z = 0xfdc94c3a046d678bLL;
+
+		A = key[3];
+		B = key[2];
+		C = key[1];
+		D = key[0];
+
+		for (i = 0; i < 17; i++)
+		{
+			if (i == 16)
+			{
+				z = 0x2;
+			}
+
+			R2(&x, &y, A, B);
+			R2(&x, &y, C, D);
+			A ^= c ^ (z & 1) ^ h(D, B);
+			B ^= c ^ (z >> 1 & 1) ^ h(A, C);
+			C ^= c ^ (z >> 2 & 1) ^ h(B, D);
+			D ^= c ^ (z >> 3 & 1) ^ h(C, A);
+			z >>= 4;
+		}
+
+		R2(&x, &y, A, B);
+		R2(&x, &y, C, D);
+	}
+
+	out[0] = x;
+	out[1] = y;
+}
+
+void SIMON_compact_encrypt(SimonCompactContext* context, uint64_t* block, uint64_t* out)
+{
+	encryptKey(context->key, context->keyLen, block, out);
+}
+
+void SIMON_compact_decrypt(SimonCompactContext* context, uint64_t* block, uint64_t* out)
+{
+	uint64_t c = 0xfffffffffffffffcLL;
+	uint64_t x = block[0];
+	uint64_t y = block[1];
+	uint64_t z;
+	uint64_t t;
+	uint64_t A = context->last[0];
+	uint64_t B = context->last[1];
+	uint64_t C = context->last[2];
+	uint64_t D = context->last[3];
+	int j;
+
+	if (context->keyLen == 128)
+	{
+		z = 0x7369f885192c0ef5LL;
+
+		// A and B are the subkeys j and j + 1
+		for (j = 66; j > 0; j -= 2)
+		{
+			R2(&y, &x, B, A);
+			B ^= c ^ zBit(z, 0x1, j - 1) ^ g(A);
+			A ^= c ^ zBit(z, 0x1, j - 2) ^ g(B);
+		}
+
+		R2(&y, &x, B, A);
+	}
+	else if (context->keyLen == 192)
+	{
+		z = 0xfc2ce51207a635dbLL;
+
+		t = y;
+		y = x;
+		x = t;
+		y ^= C;
+		y ^= f(x);
+
+		// A B C are the subkeys j to j + 2
+		for (j = 66; j > 0; j -= 6)
+		{
+			R2(&y, &x, B, A);
+			C ^= c ^ zBit(z, 0x2, j - 1) ^ g(B);
+			B ^= c ^ zBit(z, 0x2, j - 2) ^ g(A);
+			R2(&y, &x, C, B);
+			A ^= c ^ zBit(z, 0x2, j - 3) ^ g(C);
+			C ^= c ^ zBit(z, 0x2, j - 4) ^ g(B);
+			R2(&y, &x, A, C);
+			B ^= c ^ zBit(z, 0x2, j - 5) ^ g(A);
+			A ^= c ^ zBit(z, 0x2, j - 6) ^ g(C);
+		}
+
+		R2(&y, &x, B, A);
+	}
+	else // 256
+	{
+		z = 0xfdc94c3a046d678bLL;
+
+		// A B C D are the subkeys j to j + 3
+		for (j = 68; j > 0; j -= 4)
+		{
+			R2(&y, &x, D, C);
+			R2(&y, &x, B, A);
+			D ^= c ^ zBit(z, 0x2, j - 1) ^ h(C, A);
+			C ^= c ^ zBit(z, 0x2, j - 2) ^ h(B, D);
+			B ^= c ^ zBit(z, 0x2, j - 3) ^ h(A, C);
+			A ^= c ^ zBit(z, 0x2, j - 4) ^ h(D, B);
+		}
+
+		R2(&y, &x, D, C);
+		R2(&y, &x, B, A);
+	}
+
+	out[0] = x;
+	out[1] = y;
+}
+
+/*
+	Transpose the subkeys of SIMON_BATCH_LANES contexts of the same
+	key length into a structure of arrays and encrypt their blocks
+	with one key per lane. Returns 0 when the kernel cannot be used.
+*/
+static int SIMON_batch_simd(SimonContext** contexts, const uint64_t* blocks, uint64_t* out)
+{
+#ifdef SIMON_AVX2
+	uint64_t subkeys[72 * SIMON_BATCH_LANES];
+	uint8_t nrSubkeys = contexts[0]->nrSubkeys;
+	int b;
+	int i;
+
+	if (!CPU_has(CPU_AVX2))
+	{
+		return 0;
+	}
+
+	for (b = 1; b < SIMON_BATCH_LANES; b++)
+	{
+		if (contexts[b]->nrSubkeys != nrSubkeys)
+		{
+			return 0;
+		}
+	}
+
+	for (i = 0; i < nrSubkeys; i++)
+	{
+		for (b = 0; b < SIMON_BATCH_LANES; b++)
+		{
+			subkeys[i * SIMON_BATCH_LANES + b] = contexts[b]->subkeys[i];
+		}
+	}
+
+	SIMON_encrypt_batch_avx2(subkeys, nrSubkeys, blocks, out);
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+// as SIMON_batch_simd with the key schedule run in the lanes
+static int SIMON_batch_keys_simd(const uint64_t* keys, uint16_t keyLen, const uint64_t* blocks, uint64_t* out)
+{
+#ifdef SIMON_AVX2
+	uint64_t words[4 * SIMON_BATCH_LANES];
+	int m = keyLen / 64;
+	int b;
+	int w;
+
+	if (!CPU_has(CPU_AVX2))
+	{
+		return 0;
+	}
+
+	for (w = 0; w < m; w++)
+	{
+		for (b = 0; b < SIMON_BATCH_LANES; b++)
+		{
+			words[w * SIMON_BATCH_LANES + b] = keys[b * m + w];
+		}
+	}
+
+	SIMON_encrypt_batch_keys_avx2(words, keyLen, blocks, out);
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+/*
+	Batch encryption of one block under each of nrBlocks keys, the
+	block b (words 2b and 2b + 1) is encrypted under contexts[b],
+	which may have different key lengths.
+
+	This is the shape of key derivation and attestation, where the
+	bulk functions do not help because every key encrypts a single
+	block. The SIMD kernels run one key per lane instead of one
+	block per lane, the remaining blocks go through SIMON_encrypt.
+*/
+void SIMON_encrypt_batch(SimonContext** contexts, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	int b;
+
+	for (; nrBlocks >= SIMON_BATCH_LANES; nrBlocks -= SIMON_BATCH_LANES,
+		contexts += SIMON_BATCH_LANES, blocks += 2 * SIMON_BATCH_LANES, out += 2 * SIMON_BATCH_LANES)
+	{
+		if (!SIMON_batch_simd(contexts, blocks, out))
+		{
+			for (b = 0; b < SIMON_BATCH_LANES; b++)
+			{
+				SIMON_encrypt(contexts[b], (uint64_t*)blocks + 2 * b, out + 2 * b);
+			}
+		}
+	}
+
+	for (; nrBlocks > 0; nrBlocks--, contexts++, blocks += 2, out += 2)
+	{
+		SIMON_encrypt(*contexts, (uint64_t*)blocks, out);
+	}
+}
+
+/*
+	Batch encryption under raw keys of keyLen bits, the key b takes
+	the keyLen / 64 words from keys[b * keyLen / 64] in the order of
+	SIMON_init. No context is built, the key schedule is fused with
+	the rounds as in the compact context.
+*/
+void SIMON_encrypt_batch_keys(const uint64_t* keys, uint16_t keyLen, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	int m = keyLen / 64;
+	int b;
+
+	for (; nrBlocks >= SIMON_BATCH_LANES; nrBlocks -= SIMON_BATCH_LANES,
+		keys += m * SIMON_BATCH_LANES, blocks += 2 * SIMON_BATCH_LANES, out += 2 * SIMON_BATCH_LANES)
+	{
+		if (!SIMON_batch_keys_simd(keys, keyLen, blocks, out))
+		{
+			for (b = 0; b < SIMON_BATCH_LANES; b++)
+			{
+				encryptKey(keys + m * b, keyLen, blocks + 2 * b, out + 2 * b);
+			}
+		}
+	}
+
+	for (; nrBlocks > 0; nrBlocks--, keys += m, blocks += 2, out += 2)
+	{
+		encryptKey(keys, keyLen, blocks, out);
+	}
+}
+
+/*
+	Batch functions against the compact contexts, which the test
+	vector was checked on just before. The keys are the vector key
+	with its first word counting up, every one encrypts the vector
+	text, and the batch of contexts is expanded from the compact ones.
+	Covers a full batch of SIMON_BATCH_LANES keys and a tail of 3.
+*/
+static int compactBatchCheck(const uint64_t* key, uint16_t keyLen, const uint64_t* text)
+{
+	SimonCompactContext compacts[SIMON_BATCH_LANES + 3];
+	SimonContext contexts[SIMON_BATCH_LANES + 3];
+	SimonContext* pointers[SIMON_BATCH_LANES + 3];
+	uint64_t keys[4 * (SIMON_BATCH_LANES + 3)];
+	uint64_t blocks[2 * (SIMON_BATCH_LANES + 3)];
+	uint64_t compactCipherText[2 * (SIMON_BATCH_LANES + 3)];
+	uint64_t batchCipherText[2 * (SIMON_BATCH_LANES + 3)];
+	uint64_t batchKeysCipherText[2 * (SIMON_BATCH_LANES + 3)];
+	int nrKeys = SIMON_BATCH_LANES + 3;
+	int m = keyLen / 64;
+	int ok = 1;
+	int i;
+
+	for (i = 0; i < m * nrKeys; i++)
+	{
+		keys[i] = i % m == 0 ? key[0] + i / m : key[i % m];
+	}
+
+	for (i = 0; i < nrKeys; i++)
+	{
+		blocks[2 * i] = text[0];
+		blocks[2 * i + 1] = text[1];
+
+		SIMON_compact_init(&compacts[i], keys + m * i, keyLen);
+		SIMON_compact_encrypt(&compacts[i], blocks + 2 * i, compactCipherText + 2 * i);
+		SIMON_compact_expand(&compacts[i], &contexts[i]);
+		pointers[i] = &contexts[i];
+	}
+
+	SIMON_encrypt_batch(pointers, blocks, batchCipherText, nrKeys);
+	SIMON_encrypt_batch_keys(keys, keyLen, blocks, batchKeysCipherText, nrKeys);
+
+	for (i = 0; i < 2 * nrKeys; i++)
+	{
+		ok &= batchCipherText[i] == compactCipherText[i] && batchKeysCipherText[i] == compactCipherText[i];
+	}
+
+	return ok;
+}
+
 void SIMON_main(void)
 {
 	SimonContext context;
+	SimonCompactContext compact;
 	int i;
 	uint64_t key[4];
 	uint64_t text[2];
 	uint64_t cipherText[2];
 	uint64_t expectedCipherText[2];
 	uint64_t decryptedText[2];
+	uint64_t compactCipherText[2];
+	uint64_t compactDecryptedText[2];
 
 	// test for 128-bits key
 
@@ -238,6 +804,17 @@ void SIMON_main(void)
 	}
 	printf("\n");
 
+	// same vector with the round keys generated during the rounds
+	SIMON_compact_init(&compact, key, 128);
+	SIMON_compact_encrypt(&compact, text, compactCipherText);
+	SIMON_compact_decrypt(&compact, compactCipherText, compactDecryptedText);
+
+	printf("compact context: \t\t%s\n",
+		compactCipherText[0] == expectedCipherText[0] && compactCipherText[1] == expectedCipherText[1]
+		&& compactDecryptedText[0] == text[0] && compactDecryptedText[1] == text[1] ? "ok" : "FAILED");
+
+	printf("batch against compact: \t\t%s\n", compactBatchCheck(key, 128, text) ? "ok" : "FAILED");
+
 	// *** 192-bits key test ***
 
 	// key 1716151413121110 0f0e0d0c0b0a0908 0706050403020100
@@ -295,6 +872,17 @@ void SIMON_main(void)
 	}
 	printf("\n");
 
+	// same vector with the round keys generated during the rounds
+	SIMON_compact_init(&compact, key, 192);
+	SIMON_compact_encrypt(&compact, text, compactCipherText);
+	SIMON_compact_decrypt(&compact, compactCipherText, compactDecryptedText);
+
+	printf("compact context: \t\t%s\n",
+		compactCipherText[0] == expectedCipherText[0] && compactCipherText[1] == expectedCipherText[1]
+		&& compactDecryptedText[0] == text[0] && compactDecryptedText[1] == text[1] ? "ok" : "FAILED");
+
+	printf("batch against compact: \t\t%s\n", compactBatchCheck(key, 192, text) ? "ok" : "FAILED");
+
 	// *** 256-bits key test ***
 
 	// key  1f1e1d1c1b1a1918 1716151413121110 0f0e0d0c0b0a0908 0706050403020100
@@ -352,4 +940,15 @@ void SIMON_main(void)
 		printf("%016llx ", decryptedText[i]);
 	}
 	printf("\n");
+
+	// same vector with the round keys generated during the rounds
+	SIMON_compact_init(&compact, key, 256);
+	SIMON_compact_encrypt(&compact, text, compactCipherText);
+	SIMON_compact_decrypt(&compact, compactCipherText, compactDecryptedText);
+
+	printf("compact context: \t\t%s\n",
+		compactCipherText[0] == expectedCipherText[0] && compactCipherText[1] == expectedCipherText[1]
+		&& compactDecryptedText[0] == text[0] && compactDecryptedText[1] == text[1] ? "ok" : "FAILED");
+
+	printf("batch against compact: \t\t%s\n", compactBatchCheck(key, 256, text) ? "ok" : "FAILED");
 }
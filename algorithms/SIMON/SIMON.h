@@ -16,8 +16,31 @@ typedef struct
 	uint64_t subkeys[72];
 } SimonContext;
 
+/*
+	Compact context, the round keys are generated during the rounds
+	instead of being stored. key is the master key and last holds
+	the last keyLen / 64 subkeys, from which decryption runs the
+	key schedule backwards.
+*/
+typedef struct
+{
+	uint16_t keyLen;
+	uint64_t key[4];
+	uint64_t last[4];
+} SimonCompactContext;
+
 void SIMON_init(SimonContext* context, uint64_t* key, uint16_t keyLen);
 void SIMON_encrypt(SimonContext* context, uint64_t* block, uint64_t* out);
 void SIMON_decrypt(SimonContext* context, uint64_t* block, uint64_t* out);
+void SIMON_encrypt_blocks(SimonContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
+void SIMON_decrypt_blocks(SimonContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
+
+void SIMON_compact_init(SimonCompactContext* context, uint64_t* key, uint16_t keyLen);
+void SIMON_compact_expand(SimonCompactContext* context, SimonContext* expanded);
+void SIMON_compact_encrypt(SimonCompactContext* context, uint64_t* block, uint64_t* out);
+void SIMON_compact_decrypt(SimonCompactContext* context, uint64_t* block, uint64_t* out);
+
+void SIMON_encrypt_batch(SimonContext** contexts, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
+void SIMON_encrypt_batch_keys(const uint64_t* keys, uint16_t keyLen, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
 
 void SIMON_main(void);
\ No newline at end of file
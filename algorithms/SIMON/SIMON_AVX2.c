@@ -0,0 +1,388 @@
+/* SIMON_AVX2.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * SIMON-128 bulk encryption and decryption with AVX2.
+ *
+ * A register holds the x (or y) words of four blocks and four pairs
+ * of registers are processed together, so up to 16 blocks share
+ * every subkey broadcast. Each of the 68, 69 and 72 subkeys
+ * schedules has its own fully unrolled round sequence, the 69
+ * subkeys one (192 bits key) ending with a single round and a swap.
+ *
+ * The batch kernels give each lane its own key, with the subkeys
+ * loaded as vectors from a structure of arrays or generated in the
+ * lanes by the recurrence of the key schedule, whose z bits are the
+ * same for all the keys.
+ *
+ */
+
+#include "SIMON_AVX2.h"
+
+#ifdef SIMON_AVX2
+
+#include <immintrin.h>
+
+// register pairs processed together
+#define LANES 4
+
+#define ROL(v, n) _mm256_or_si256(_mm256_slli_epi64(v, n), _mm256_srli_epi64(v, 64 - (n)))
+
+// rotation by 8 bits is a byte shuffle
+#define ROL8(v) _mm256_shuffle_epi8(v, rol8)
+
+// f(x) = ((x <<< 1) & (x <<< 8)) ^ (x <<< 2)
+#define F(v) _mm256_xor_si256(_mm256_and_si256(ROL(v, 1), ROL8(v)), ROL(v, 2))
+
+#define ROUND_1(x, y, n) y##n = _mm256_xor_si256(_mm256_xor_si256(y##n, F(x##n)), k)
+
+// y ^= f(x) ^ subkeys[i] on every register pair
+#define ROUND(x, y, i) \
+	k = _mm256_set1_epi64x((long long)subkeys[i]); \
+	ROUND_1(x, y, 0); ROUND_1(x, y, 1); ROUND_1(x, y, 2); ROUND_1(x, y, 3)
+
+#define ENCRYPT_2(i) ROUND(x, y, i); ROUND(y, x, (i) + 1)
+#define ENCRYPT_8(i) ENCRYPT_2(i); ENCRYPT_2((i) + 2); ENCRYPT_2((i) + 4); ENCRYPT_2((i) + 6)
+#define ENCRYPT_64 \
+	ENCRYPT_8(0); ENCRYPT_8(8); ENCRYPT_8(16); ENCRYPT_8(24); \
+	ENCRYPT_8(32); ENCRYPT_8(40); ENCRYPT_8(48); ENCRYPT_8(56)
+
+// inverse of ENCRYPT_2(i - 1)
+#define DECRYPT_2(i) ROUND(y, x, i); ROUND(x, y, (i) - 1)
+#define DECRYPT_8(i) DECRYPT_2(i); DECRYPT_2((i) - 2); DECRYPT_2((i) - 4); DECRYPT_2((i) - 6)
+#define DECRYPT_64 \
+	DECRYPT_8(63); DECRYPT_8(55); DECRYPT_8(47); DECRYPT_8(39); \
+	DECRYPT_8(31); DECRYPT_8(23); DECRYPT_8(15); DECRYPT_8(7)
+
+#define SWAP_1(n) t = x##n; x##n = y##n; y##n = t
+#define SWAP SWAP_1(0); SWAP_1(1); SWAP_1(2); SWAP_1(3)
+
+// the state lives in locals so it stays in registers
+#define BEGIN \
+	const __m256i rol8 = _mm256_set_epi8( \
+		14, 13, 12, 11, 10, 9, 8, 15, 6, 5, 4, 3, 2, 1, 0, 7, \
+		14, 13, 12, 11, 10, 9, 8, 15, 6, 5, 4, 3, 2, 1, 0, 7); \
+	__m256i k; \
+	__m256i x0 = x[0], x1 = x[1], x2 = x[2], x3 = x[3]; \
+	__m256i y0 = y[0], y1 = y[1], y2 = y[2], y3 = y[3]
+
+#define END \
+	x[0] = x0; x[1] = x1; x[2] = x2; x[3] = x3; \
+	y[0] = y0; y[1] = y1; y[2] = y2; y[3] = y3
+
+static void encrypt68(const uint64_t* subkeys, __m256i* x, __m256i* y)
+{
+	BEGIN;
+	ENCRYPT_64;
+	ENCRYPT_2(64);
+	ENCRYPT_2(66);
+	END;
+}
+
+static void encrypt69(const uint64_t* subkeys, __m256i* x, __m256i* y)
+{
+	__m256i t;
+	BEGIN;
+	ENCRYPT_64;
+	ENCRYPT_2(64);
+	ENCRYPT_2(66);
+	ROUND(x, y, 68);
+	SWAP;
+	END;
+}
+
+static void encrypt72(const uint64_t* subkeys, __m256i* x, __m256i* y)
+{
+	BEGIN;
+	ENCRYPT_64;
+	ENCRYPT_8(64);
+	END;
+}
+
+static void decrypt68(const uint64_t* subkeys, __m256i* x, __m256i* y)
+{
+	BEGIN;
+	DECRYPT_2(67);
+	DECRYPT_2(65);
+	DECRYPT_64;
+	END;
+}
+
+static void decrypt69(const uint64_t* subkeys, __m256i* x, __m256i* y)
+{
+	__m256i t;
+	BEGIN;
+	SWAP;
+	ROUND(x, y, 68);
+	DECRYPT_2(67);
+	DECRYPT_2(65);
+	DECRYPT_64;
+	END;
+}
+
+static void decrypt72(const uint64_t* subkeys, __m256i* x, __m256i* y)
+{
+	BEGIN;
+	DECRYPT_8(71);
+	DECRYPT_64;
+	END;
+}
+
+/*
+	Split groups of four blocks into their x and y words, up to LANES
+	groups per iteration. The unused register pairs of the last
+	iteration are zero and never stored. The words are in the block
+	order 0, 2, 1, 3 inside a register, which the store undoes.
+*/
+static size_t SIMON_blocks(const uint64_t* subkeys, int nrSubkeys, const uint64_t* blocks, uint64_t* out, size_t nrBlocks, int decrypt)
+{
+	__m256i x[LANES];
+	__m256i y[LANES];
+	__m256i a;
+	__m256i b;
+	size_t done;
+	size_t groups;
+	size_t j;
+
+	for (done = 0; nrBlocks - done >= 4; done += 4 * groups, blocks += 8 * groups, out += 8 * groups)
+	{
+		groups = (nrBlocks - done) / 4;
+		if (groups > LANES)
+		{
+			groups = LANES;
+		}
+
+		for (j = 0; j < LANES; j++)
+		{
+			if (j < groups)
+			{
+				a = _mm256_loadu_si256((const __m256i*)(blocks + 8 * j));
+				b = _mm256_loadu_si256((const __m256i*)(blocks + 8 * j) + 1);
+				x[j] = _mm256_unpacklo_epi64(a, b);
+				y[j] = _mm256_unpackhi_epi64(a, b);
+			}
+			else
+			{
+				x[j] = _mm256_setzero_si256();
+				y[j] = _mm256_setzero_si256();
+			}
+		}
+
+		if (nrSubkeys == 68)
+		{
+			(decrypt ? decrypt68 : encrypt68)(subkeys, x, y);
+		}
+		else if (nrSubkeys == 69)
+		{
+			(decrypt ? decrypt69 : encrypt69)(subkeys, x, y);
+		}
+		else
+		{
+			(decrypt ? decrypt72 : encrypt72)(subkeys, x, y);
+		}
+
+		for (j = 0; j < groups; j++)
+		{
+			_mm256_storeu_si256((__m256i*)(out + 8 * j), _mm256_unpacklo_epi64(x[j], y[j]));
+			_mm256_storeu_si256((__m256i*)(out + 8 * j) + 1, _mm256_unpackhi_epi64(x[j], y[j]));
+		}
+	}
+
+	return done;
+}
+
+size_t SIMON_encrypt_blocks_avx2(const uint64_t* subkeys, int nrSubkeys, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	return SIMON_blocks(subkeys, nrSubkeys, blocks, out, nrBlocks, 0);
+}
+
+size_t SIMON_decrypt_blocks_avx2(const uint64_t* subkeys, int nrSubkeys, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	return SIMON_blocks(subkeys, nrSubkeys, blocks, out, nrBlocks, 1);
+}
+
+#define ROR(v, n) _mm256_or_si256(_mm256_srli_epi64(v, n), _mm256_slli_epi64(v, 64 - (n)))
+
+/*
+	The words of four blocks in the natural order, unlike SIMON_blocks
+	the lanes have to match the lanes of the keys.
+*/
+#define BATCH_LOAD(x, y, blocks) \
+	a = _mm256_loadu_si256((const __m256i*)(blocks)); \
+	b = _mm256_loadu_si256((const __m256i*)(blocks) + 1); \
+	x = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), 0xd8); \
+	y = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), 0xd8)
+
+#define BATCH_STORE(out, x, y) \
+	x = _mm256_permute4x64_epi64(x, 0xd8); \
+	y = _mm256_permute4x64_epi64(y, 0xd8); \
+	_mm256_storeu_si256((__m256i*)(out), _mm256_unpacklo_epi64(x, y)); \
+	_mm256_storeu_si256((__m256i*)(out) + 1, _mm256_unpackhi_epi64(x, y))
+
+// y ^= f(x) ^ k on both halves of the batch, the subkeys of the halves in k0 and k1
+#define BATCH_ROUND(x, y, k) \
+	y##0 = _mm256_xor_si256(_mm256_xor_si256(y##0, F(x##0)), k##0); \
+	y##1 = _mm256_xor_si256(_mm256_xor_si256(y##1, F(x##1)), k##1)
+
+#define BATCH_R2(k, l) BATCH_ROUND(x, y, k); BATCH_ROUND(y, x, l)
+
+#define BATCH_SWAP t = x0; x0 = y0; y0 = t; t = x1; x1 = y1; y1 = t
+
+// word w of the keys of the lanes 4 * n to 4 * n + 3
+#define KEY(w, n) _mm256_loadu_si256((const __m256i*)(keys + (w) * SIMON_BATCH_LANES) + (n))
+
+// the terms of the previous subkeys in the key schedule
+#define G(v) _mm256_xor_si256(ROR(v, 3), ROR(v, 4))
+#define H(u, v) _mm256_xor_si256(G(u), _mm256_xor_si256(v, ROR(v, 1)))
+
+// next subkey of the lanes, a ^= c ^ (bit j of z) ^ g(u)
+#define NEXT_G(a, u, j) \
+	cz = _mm256_set1_epi64x((long long)(c ^ (z >> (j) & 1))); \
+	a##0 = _mm256_xor_si256(a##0, _mm256_xor_si256(cz, G(u##0))); \
+	a##1 = _mm256_xor_si256(a##1, _mm256_xor_si256(cz, G(u##1)))
+
+// next subkey of the lanes for 256-bits keys, a ^= c ^ (bit j of z) ^ h(u, v)
+#define NEXT_H(a, u, v, j) \
+	cz = _mm256_set1_epi64x((long long)(c ^ (z >> (j) & 1))); \
+	a##0 = _mm256_xor_si256(a##0, _mm256_xor_si256(cz, H(u##0, v##0))); \
+	a##1 = _mm256_xor_si256(a##1, _mm256_xor_si256(cz, H(u##1, v##1)))
+
+void SIMON_encrypt_batch_avx2(const uint64_t* subkeys, int nrSubkeys, const uint64_t* blocks, uint64_t* out)
+{
+	const __m256i rol8 = _mm256_set_epi8(
+		14, 13, 12, 11, 10, 9, 8, 15, 6, 5, 4, 3, 2, 1, 0, 7,
+		14, 13, 12, 11, 10, 9, 8, 15, 6, 5, 4, 3, 2, 1, 0, 7);
+	__m256i a, b, t;
+	__m256i x0, y0, x1, y1;
+	__m256i K0, K1, L0, L1;
+	int i;
+
+	BATCH_LOAD(x0, y0, blocks);
+	BATCH_LOAD(x1, y1, blocks + 8);
+
+	for (i = 0; i + 1 < nrSubkeys; i += 2, subkeys += 2 * SIMON_BATCH_LANES)
+	{
+		K0 = _mm256_loadu_si256((const __m256i*)subkeys);
+		K1 = _mm256_loadu_si256((const __m256i*)subkeys + 1);
+		L0 = _mm256_loadu_si256((const __m256i*)subkeys + 2);
+		L1 = _mm256_loadu_si256((const __m256i*)subkeys + 3);
+		BATCH_R2(K, L);
+	}
+
+	if (nrSubkeys == 69)
+	{
+		K0 = _mm256_loadu_si256((const __m256i*)subkeys);
+		K1 = _mm256_loadu_si256((const __m256i*)subkeys + 1);
+		BATCH_ROUND(x, y, K);
+		BATCH_SWAP;
+	}
+
+	BATCH_STORE(out, x0, y0);
+	BATCH_STORE(out + 8, x1, y1);
+}
+
+// the subkeys in the lanes follow SIMON_compact_encrypt
+void SIMON_encrypt_batch_keys_avx2(const uint64_t* keys, uint16_t keyLen, const uint64_t* blocks, uint64_t* out)
+{
+	const __m256i rol8 = _mm256_set_epi8(
+		14, 13, 12, 11, 10, 9, 8, 15, 6, 5, 4, 3, 2, 1, 0, 7,
+		14, 13, 12, 11, 10, 9, 8, 15, 6, 5, 4, 3, 2, 1, 0, 7);
+	const uint64_t c = 0xfffffffffffffffcLL;
+	uint64_t z;
+	__m256i a, b, t, cz;
+	__m256i x0, y0, x1, y1;
+	__m256i A0, B0, C0, D0;
+	__m256i A1, B1, C1, D1;
+	int i;
+
+	BATCH_LOAD(x0, y0, blocks);
+	BATCH_LOAD(x1, y1, blocks + 8);
+
+	if (keyLen == 128)
+	{
+		z = 0x7369f885192c0ef5LL;
+
+		A0 = KEY(1, 0); A1 = KEY(1, 1);
+		B0 = KEY(0, 0); B1 = KEY(0, 1);
+
+		for (i = 0; i < 33; i++)
+		{
+			if (i == 32)
+			{
+				z = 0x1;
+			}
+
+			BATCH_R2(A, B);
+			NEXT_G(A, B, 0);
+			NEXT_G(B, A, 1);
+			z >>= 2;
+		}
+
+		BATCH_R2(A, B);
+	}
+	else if (keyLen == 192)
+	{
+		z = 0xfc2ce51207a635dbLL;
+
+		A0 = KEY(2, 0); A1 = KEY(2, 1);
+		B0 = KEY(1, 0); B1 = KEY(1, 1);
+		C0 = KEY(0, 0); C1 = KEY(0, 1);
+
+		for (i = 0; i < 11; i++)
+		{
+			if (i == 10)
+			{
+				z |= (uint64_t)0x2 << 4;
+			}
+
+			BATCH_R2(A, B);
+			NEXT_G(A, C, 0);
+			BATCH_R2(C, A);
+			NEXT_G(B, A, 1);
+			NEXT_G(C, B, 2);
+			BATCH_R2(B, C);
+			NEXT_G(A, C, 3);
+			NEXT_G(B, A, 4);
+			NEXT_G(C, B, 5);
+			z >>= 6;
+		}
+
+		BATCH_R2(A, B);
+		BATCH_ROUND(x, y, C);
+		BATCH_SWAP;
+	}
+	else // 256
+	{
+		z = 0xfdc94c3a046d678bLL;
+
+		A0 = KEY(3, 0); A1 = KEY(3, 1);
+		B0 = KEY(2, 0); B1 = KEY(2, 1);
+		C0 = KEY(1, 0); C1 = KEY(1, 1);
+		D0 = KEY(0, 0); D1 = KEY(0, 1);
+
+		for (i = 0; i < 17; i++)
+		{
+			if (i == 16)
+			{
+				z = 0x2;
+			}
+
+			BATCH_R2(A, B);
+			BATCH_R2(C, D);
+			NEXT_H(A, D, B, 0);
+			NEXT_H(B, A, C, 1);
+			NEXT_H(C, B, D, 2);
+			NEXT_H(D, C, A, 3);
+			z >>= 4;
+		}
+
+		BATCH_R2(A, B);
+		BATCH_R2(C, D);
+	}
+
+	BATCH_STORE(out, x0, y0);
+	BATCH_STORE(out + 8, x1, y1);
+}
+
+#endif
@@ -15,6 +15,9 @@
  */
 
 #include "SPECK.h"
+#include "SPECK_SSE2.h"
+#include "SPECK_AVX2.h"
+#include "../../cpu/CPU.h"
 
 // Rotate Left circular shift 32 bits
 static uint64_t ROL_64(uint64_t x, uint32_t n)
@@ -136,15 +139,478 @@ void SPECK_decrypt(SpeckContext* context, uint64_t* block, uint64_t* out)
 	out[1] = y;
 }
 
+/*
+	Run the widest SIMD kernel supported by the CPU and return how
+	many blocks it processed, the remaining blocks go to the
+	portable code.
+*/
+static size_t SPECK_blocks_simd(const SpeckContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks, int decrypt)
+{
+#ifdef SPECK_AVX2
+	if (CPU_has(CPU_AVX2))
+	{
+		return decrypt
+			? SPECK_decrypt_blocks_avx2(context->subkeys, context->nrSubkeys, blocks, out, nrBlocks)
+			: SPECK_encrypt_blocks_avx2(context->subkeys, context->nrSubkeys, blocks, out, nrBlocks);
+	}
+#endif
+
+#ifdef SPECK_SSE2
+	if (CPU_has(CPU_SSE2))
+	{
+		return decrypt
+			? SPECK_decrypt_blocks_sse2(context->subkeys, context->nrSubkeys, blocks, out, nrBlocks)
+			: SPECK_encrypt_blocks_sse2(context->subkeys, context->nrSubkeys, blocks, out, nrBlocks);
+	}
+#endif
+
+	return 0;
+}
+
+/*
+	Bulk ECB encryption of nrBlocks consecutive blocks.
+
+	Four independent blocks are processed per iteration so each
+	subkey is loaded once for all of them and the add-rotate-xor
+	chains of the blocks can overlap in the pipeline.
+*/
+void SPECK_encrypt_blocks(SpeckContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	uint8_t i;
+	uint64_t k;
+	uint64_t x0, y0, x1, y1, x2, y2, x3, y3;
+	size_t done = SPECK_blocks_simd(context, blocks, out, nrBlocks, 0);
+
+	nrBlocks -= done;
+	blocks += 2 * done;
+	out += 2 * done;
+
+	for (; nrBlocks >= 4; nrBlocks -= 4, blocks += 8, out += 8)
+	{
+		x0 = blocks[0]; y0 = blocks[1];
+		x1 = blocks[2]; y1 = blocks[3];
+		x2 = blocks[4]; y2 = blocks[5];
+		x3 = blocks[6]; y3 = blocks[7];
+
+		for (i = 0; i < context->nrSubkeys; i++)
+		{
+			k = context->subkeys[i];
+			R(&x0, &y0, k);
+			R(&x1, &y1, k);
+			R(&x2, &y2, k);
+			R(&x3, &y3, k);
+		}
+
+		out[0] = x0; out[1] = y0;
+		out[2] = x1; out[3] = y1;
+		out[4] = x2; out[5] = y2;
+		out[6] = x3; out[7] = y3;
+	}
+
+	for (; nrBlocks > 0; nrBlocks--, blocks += 2, out += 2)
+	{
+		SPECK_encrypt(context, (uint64_t*)blocks, out);
+	}
+}
+
+void SPECK_decrypt_blocks(SpeckContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	int i;
+	uint64_t k;
+	uint64_t x0, y0, x1, y1, x2, y2, x3, y3;
+	size_t done = SPECK_blocks_simd(context, blocks, out, nrBlocks, 1);
+
+	nrBlocks -= done;
+	blocks += 2 * done;
+	out += 2 * done;
+
+	for (; nrBlocks >= 4; nrBlocks -= 4, blocks += 8, out += 8)
+	{
+		x0 = blocks[0]; y0 = blocks[1];
+		x1 = blocks[2]; y1 = blocks[3];
+		x2 = blocks[4]; y2 = blocks[5];
+		x3 = blocks[6]; y3 = blocks[7];
+
+		for (i = context->nrSubkeys - 1; i >= 0; i--)
+		{
+			k = context->subkeys[i];
+			RI(&x0, &y0, k);
+			RI(&x1, &y1, k);
+			RI(&x2, &y2, k);
+			RI(&x3, &y3, k);
+		}
+
+		out[0] = x0; out[1] = y0;
+		out[2] = x1; out[3] = y1;
+		out[4] = x2; out[5] = y2;
+		out[6] = x3; out[7] = y3;
+	}
+
+	for (; nrBlocks > 0; nrBlocks--, blocks += 2, out += 2)
+	{
+		SPECK_decrypt(context, (uint64_t*)blocks, out);
+	}
+}
+
+/*
+	Compact context: only the master key and the state of the key
+	schedule after the last round are kept (72 bytes instead of 280),
+	the round keys are generated by R() interleaved with the rounds.
+	Decryption runs the key schedule backwards with RI() from the
+	last state.
+*/
+void SPECK_compact_init(SpeckCompactContext* context, uint64_t* key, uint16_t keyLen)
+{
+	uint8_t m = (uint8_t)(keyLen / 64);
+	uint8_t nrSubkeys = 30 + m;
+	uint64_t A;
+	uint64_t L[3];
+	uint64_t i;
+
+	context->keyLen = keyLen;
+
+	for (i = 0; i < 4; i++)
+	{
+		context->key[i] = i < m ? key[i] : 0;
+		context->last[i] = 0;
+	}
+
+	A = key[m - 1];
+	for (i = 0; i < m - 1u; i++)
+	{
+		L[i] = key[m - 2 - i];
+	}
+
+	// as SPECK_init, the words of the key take turns with A
+	for (i = 0; i < nrSubkeys - 1u; i++)
+	{
+		R(&L[i % (m - 1)], &A, i);
+	}
+
+	context->last[0] = A;
+	for (i = 0; i < m - 1u; i++)
+	{
+		context->last[i + 1] = L[i];
+	}
+}
+
+// full key schedule, for the bulk functions that reuse every subkey
+void SPECK_compact_expand(SpeckCompactContext* context, SpeckContext* expanded)
+{
+	SPECK_init(expanded, context->key, context->keyLen);
+}
+
+/*
+	Encryption under a key whose subkeys are generated during the
+	rounds, shared by the compact context and the batch of keys.
+*/
+static void encryptKey(const uint64_t* key, uint16_t keyLen, const uint64_t* block, uint64_t* out)
+{
+	uint64_t x = block[0];
+	uint64_t y = block[1];
+	uint64_t A;
+	uint64_t B;
+	uint64_t C;
+	uint64_t D;
+	uint64_t i;
+
+	if (keyLen == 128)
+	{
+		A = key[1];
+		B = key[0];
+
+		for (i = 0; i < 31; i++)
+		{
+			R(&x, &y, A);
+			R(&B, &A, i);
+		}
+	}
+	else if (keyLen == 192)
+	{
+		A = key[2];
+		B = key[1];
+		C = key[0];
+
+		for (i = 0; i < 32; i += 2)
+		{
+			R(&x, &y, A);
+			R(&B, &A, i);
+			R(&x, &y, A);
+			R(&C, &A, i + 1);
+		}
+	}
+	else // 256
+	{
+		A = key[3];
+		B = key[2];
+		C = key[1];
+		D = key[0];
+
+		for (i = 0; i < 33; i += 3)
+		{
+			R(&x, &y, A);
+			R(&B, &A, i);
+			R(&x, &y, A);
+			R(&C, &A, i + 1);
+			R(&x, &y, A);
+			R(&D, &A, i + 2);
+		}
+	}
+
+	R(&x, &y, A);
+
+	out[0] = x;
+	out[1] = y;
+}
+
+void SPECK_compact_encrypt(SpeckCompactContext* context, uint64_t* block, uint64_t* out)
+{
+	encryptKey(context->key, context->keyLen, block, out);
+}
+
+void SPECK_compact_decrypt(SpeckCompactContext* context, uint64_t* block, uint64_t* out)
+{
+	uint64_t x = block[0];
+	uint64_t y = block[1];
+	uint64_t A = context->last[0];
+	uint64_t B = context->last[1];
+	uint64_t C = context->last[2];
+	uint64_t D = context->last[3];
+	int i;
+
+	RI(&x, &y, A);
+
+	if (context->keyLen == 128)
+	{
+		for (i = 30; i >= 0; i--)
+		{
+			RI(&B, &A, i);
+			RI(&x, &y, A);
+		}
+	}
+	else if (context->keyLen == 192)
+	{
+		for (i = 30; i >= 0; i -= 2)
+		{
+			RI(&C, &A, i + 1);
+			RI(&x, &y, A);
+			RI(&B, &A, i);
+			RI(&x, &y, A);
+		}
+	}
+	else // 256
+	{
+		for (i = 30; i >= 0; i -= 3)
+		{
+			RI(&D, &A, i + 2);
+			RI(&x, &y, A);
+			RI(&C, &A, i + 1);
+			RI(&x, &y, A);
+			RI(&B, &A, i);
+			RI(&x, &y, A);
+		}
+	}
+
+	out[0] = x;
+	out[1] = y;
+}
+
+/*
+	Transpose the subkeys of SPECK_BATCH_LANES contexts of the same
+	key length into a structure of arrays and encrypt their blocks
+	with one key per lane. Returns 0 when the kernel cannot be used.
+*/
+static int SPECK_batch_simd(SpeckContext** contexts, const uint64_t* blocks, uint64_t* out)
+{
+#ifdef SPECK_AVX2
+	uint64_t subkeys[34 * SPECK_BATCH_LANES];
+	uint8_t nrSubkeys = contexts[0]->nrSubkeys;
+	int b;
+	int i;
+
+	if (!CPU_has(CPU_AVX2))
+	{
+		return 0;
+	}
+
+	for (b = 1; b < SPECK_BATCH_LANES; b++)
+	{
+		if (contexts[b]->nrSubkeys != nrSubkeys)
+		{
+			return 0;
+		}
+	}
+
+	for (i = 0; i < nrSubkeys; i++)
+	{
+		for (b = 0; b < SPECK_BATCH_LANES; b++)
+		{
+			subkeys[i * SPECK_BATCH_LANES + b] = contexts[b]->subkeys[i];
+		}
+	}
+
+	SPECK_encrypt_batch_avx2(subkeys, nrSubkeys, blocks, out);
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+// as SPECK_batch_simd with the key schedule run in the lanes
+static int SPECK_batch_keys_simd(const uint64_t* keys, uint16_t keyLen, const uint64_t* blocks, uint64_t* out)
+{
+#ifdef SPECK_AVX2
+	uint64_t words[4 * SPECK_BATCH_LANES];
+	int m = keyLen / 64;
+	int b;
+	int w;
+
+	if (!CPU_has(CPU_AVX2))
+	{
+		return 0;
+	}
+
+	for (w = 0; w < m; w++)
+	{
+		for (b = 0; b < SPECK_BATCH_LANES; b++)
+		{
+			words[w * SPECK_BATCH_LANES + b] = keys[b * m + w];
+		}
+	}
+
+	SPECK_encrypt_batch_keys_avx2(words, keyLen, blocks, out);
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+/*
+	Batch encryption of one block under each of nrBlocks keys, the
+	block b (words 2b and 2b + 1) is encrypted under contexts[b],
+	which may have different key lengths.
+
+	This is the shape of key derivation and attestation, where the
+	bulk functions do not help because every key encrypts a single
+	block. The SIMD kernels run one key per lane instead of one
+	block per lane, the remaining blocks go through SPECK_encrypt.
+*/
+void SPECK_encrypt_batch(SpeckContext** contexts, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	int b;
+
+	for (; nrBlocks >= SPECK_BATCH_LANES; nrBlocks -= SPECK_BATCH_LANES,
+		contexts += SPECK_BATCH_LANES, blocks += 2 * SPECK_BATCH_LANES, out += 2 * SPECK_BATCH_LANES)
+	{
+		if (!SPECK_batch_simd(contexts, blocks, out))
+		{
+			for (b = 0; b < SPECK_BATCH_LANES; b++)
+			{
+				SPECK_encrypt(contexts[b], (uint64_t*)blocks + 2 * b, out + 2 * b);
+			}
+		}
+	}
+
+	for (; nrBlocks > 0; nrBlocks--, contexts++, blocks += 2, out += 2)
+	{
+		SPECK_encrypt(*contexts, (uint64_t*)blocks, out);
+	}
+}
+
+/*
+	Batch encryption under raw keys of keyLen bits, the key b takes
+	the keyLen / 64 words from keys[b * keyLen / 64] in the order of
+	SPECK_init. No context is built, the key schedule is fused with
+	the rounds as in the compact context.
+*/
+void SPECK_encrypt_batch_keys(const uint64_t* keys, uint16_t keyLen, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	int m = keyLen / 64;
+	int b;
+
+	for (; nrBlocks >= SPECK_BATCH_LANES; nrBlocks -= SPECK_BATCH_LANES,
+		keys += m * SPECK_BATCH_LANES, blocks += 2 * SPECK_BATCH_LANES, out += 2 * SPECK_BATCH_LANES)
+	{
+		if (!SPECK_batch_keys_simd(keys, keyLen, blocks, out))
+		{
+			for (b = 0; b < SPECK_BATCH_LANES; b++)
+			{
+				encryptKey(keys + m * b, keyLen, blocks + 2 * b, out + 2 * b);
+			}
+		}
+	}
+
+	for (; nrBlocks > 0; nrBlocks--, keys += m, blocks += 2, out += 2)
+	{
+		encryptKey(keys, keyLen, blocks, out);
+	}
+}
+
+/*
+	Encrypt the text of a test vector under SPECK_BATCH_LANES + 3 keys
+	with both batch functions and decrypt every block back with
+	SPECK_decrypt. The key b differs from the vector key by b in its
+	last word and the block b from the text by b in its second word,
+	so the block 0 must give the expected encrypted text.
+*/
+static int batchRoundTrip(const uint64_t* key, uint16_t keyLen, const uint64_t* text, const uint64_t* expectedCipherText)
+{
+	SpeckContext contexts[SPECK_BATCH_LANES + 3];
+	SpeckContext* pointers[SPECK_BATCH_LANES + 3];
+	uint64_t keys[4 * (SPECK_BATCH_LANES + 3)];
+	uint64_t blocks[2 * (SPECK_BATCH_LANES + 3)];
+	uint64_t cipherText[2 * (SPECK_BATCH_LANES + 3)];
+	uint64_t keysCipherText[2 * (SPECK_BATCH_LANES + 3)];
+	uint64_t decryptedText[2];
+	int nrKeys = SPECK_BATCH_LANES + 3;
+	int m = keyLen / 64;
+	int ok;
+	int b;
+	int w;
+
+	for (b = 0; b < nrKeys; b++)
+	{
+		for (w = 0; w < m; w++)
+		{
+			keys[m * b + w] = key[w];
+		}
+		keys[m * b + m - 1] += b;
+
+		blocks[2 * b] = text[0];
+		blocks[2 * b + 1] = text[1] ^ b;
+
+		SPECK_init(&contexts[b], keys + m * b, keyLen);
+		pointers[b] = &contexts[b];
+	}
+
+	SPECK_encrypt_batch(pointers, blocks, cipherText, nrKeys);
+	SPECK_encrypt_batch_keys(keys, keyLen, blocks, keysCipherText, nrKeys);
+
+	ok = cipherText[0] == expectedCipherText[0] && cipherText[1] == expectedCipherText[1];
+
+	for (b = 0; b < nrKeys; b++)
+	{
+		SPECK_decrypt(&contexts[b], cipherText + 2 * b, decryptedText);
+
+		ok &= decryptedText[0] == blocks[2 * b] && decryptedText[1] == blocks[2 * b + 1]
+			&& keysCipherText[2 * b] == cipherText[2 * b] && keysCipherText[2 * b + 1] == cipherText[2 * b + 1];
+	}
+
+	return ok;
+}
+
 void SPECK_main(void)
 {
 	SpeckContext context;
+	SpeckCompactContext compact;
 	int i;
 	uint64_t key[4];
 	uint64_t text[2];
 	uint64_t cipherText[2];
 	uint64_t expectedCipherText[2];
 	uint64_t decryptedText[2];
+	uint64_t compactCipherText[2];
+	uint64_t compactDecryptedText[2];
 
 	// test for 128-bits key
 
@@ -202,6 +668,18 @@ void SPECK_main(void)
 	}
 	printf("\n");
 
+	// same vector with the round keys generated during the rounds
+	SPECK_compact_init(&compact, key, 128);
+	SPECK_compact_encrypt(&compact, text, compactCipherText);
+	SPECK_compact_decrypt(&compact, compactCipherText, compactDecryptedText);
+
+	printf("compact context: \t\t%s\n",
+		compactCipherText[0] == expectedCipherText[0] && compactCipherText[1] == expectedCipherText[1]
+		&& compactDecryptedText[0] == text[0] && compactDecryptedText[1] == text[1] ? "ok" : "FAILED");
+
+	// the vector as the first block of a batch of related keys
+	printf("batch encryption: \t\t%s\n", batchRoundTrip(key, 128, text, expectedCipherText) ? "ok" : "FAILED");
+
 	// *** 192-bits key test ***
 
 	// key 1716151413121110 0f0e0d0c0b0a0908 0706050403020100
@@ -259,6 +737,18 @@ void SPECK_main(void)
 	}
 	printf("\n");
 
+	// same vector with the round keys generated during the rounds
+	SPECK_compact_init(&compact, key, 192);
+	SPECK_compact_encrypt(&compact, text, compactCipherText);
+	SPECK_compact_decrypt(&compact, compactCipherText, compactDecryptedText);
+
+	printf("compact context: \t\t%s\n",
+		compactCipherText[0] == expectedCipherText[0] && compactCipherText[1] == expectedCipherText[1]
+		&& compactDecryptedText[0] == text[0] && compactDecryptedText[1] == text[1] ? "ok" : "FAILED");
+
+	// the vector as the first block of a batch of related keys
+	printf("batch encryption: \t\t%s\n", batchRoundTrip(key, 192, text, expectedCipherText) ? "ok" : "FAILED");
+
 	// *** 256-bits key test ***
 
 	// key  1f1e1d1c1b1a1918 1716151413121110 0f0e0d0c0b0a0908 0706050403020100
@@ -316,4 +806,16 @@ void SPECK_main(void)
 		printf("%016llx ", decryptedText[i]);
 	}
 	printf("\n");
+
+	// same vector with the round keys generated during the rounds
+	SPECK_compact_init(&compact, key, 256);
+	SPECK_compact_encrypt(&compact, text, compactCipherText);
+	SPECK_compact_decrypt(&compact, compactCipherText, compactDecryptedText);
+
+	printf("compact context: \t\t%s\n",
+		compactCipherText[0] == expectedCipherText[0] && compactCipherText[1] == expectedCipherText[1]
+		&& compactDecryptedText[0] == text[0] && compactDecryptedText[1] == text[1] ? "ok" : "FAILED");
+
+	// the vector as the first block of a batch of related keys
+	printf("batch encryption: \t\t%s\n", batchRoundTrip(key, 256, text, expectedCipherText) ? "ok" : "FAILED");
 }
@@ -16,8 +16,32 @@ typedef struct
 	uint64_t subkeys[34];
 } SpeckContext;
 
+/*
+	Compact context, the round keys are generated during the rounds
+	instead of being stored. key is the master key and last holds
+	the words of the key schedule after the last round (the subkey
+	first, then the words it is mixed with), where decryption starts
+	running the schedule backwards.
+*/
+typedef struct
+{
+	uint16_t keyLen;
+	uint64_t key[4];
+	uint64_t last[4];
+} SpeckCompactContext;
+
 void SPECK_init(SpeckContext* context, uint64_t* key, uint16_t keyLen);
 void SPECK_encrypt(SpeckContext* context, uint64_t* block, uint64_t* out);
 void SPECK_decrypt(SpeckContext* context, uint64_t* block, uint64_t* out);
+void SPECK_encrypt_blocks(SpeckContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
+void SPECK_decrypt_blocks(SpeckContext* context, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
+
+void SPECK_compact_init(SpeckCompactContext* context, uint64_t* key, uint16_t keyLen);
+void SPECK_compact_expand(SpeckCompactContext* context, SpeckContext* expanded);
+void SPECK_compact_encrypt(SpeckCompactContext* context, uint64_t* block, uint64_t* out);
+void SPECK_compact_decrypt(SpeckCompactContext* context, uint64_t* block, uint64_t* out);
+
+void SPECK_encrypt_batch(SpeckContext** contexts, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
+void SPECK_encrypt_batch_keys(const uint64_t* keys, uint16_t keyLen, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
 
 void SPECK_main(void);
\ No newline at end of file
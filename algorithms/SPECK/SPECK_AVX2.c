@@ -0,0 +1,262 @@
+/* SPECK_AVX2.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * SPECK-128 bulk encryption and decryption with AVX2.
+ *
+ * A register holds the x (or y) words of four blocks, four pairs of
+ * registers are processed per iteration so the add-rotate-xor
+ * chains of 16 blocks overlap. The rotations by 8 bits are byte
+ * shuffles, the ones by 3 bits two shifts and an or.
+ *
+ * The batch kernels give each lane its own key: the subkeys are
+ * loaded as vectors from a structure of arrays, or generated in the
+ * lanes by the key schedule, which is the round function itself.
+ *
+ */
+
+#include "SPECK_AVX2.h"
+
+#ifdef SPECK_AVX2
+
+#include <immintrin.h>
+
+#define ROL(v, n) _mm256_or_si256(_mm256_slli_epi64(v, n), _mm256_srli_epi64(v, 64 - (n)))
+#define ROR(v, n) _mm256_or_si256(_mm256_srli_epi64(v, n), _mm256_slli_epi64(v, 64 - (n)))
+#define ROR8(v) _mm256_shuffle_epi8(v, ror8)
+#define ROL8(v) _mm256_shuffle_epi8(v, rol8)
+
+// x = ((x >>> 8) + y) ^ k, y = (y <<< 3) ^ x
+#define R(x, y, k) \
+	x = _mm256_xor_si256(_mm256_add_epi64(ROR8(x), y), k); \
+	y = _mm256_xor_si256(ROL(y, 3), x)
+
+// y = (y ^ x) >>> 3, x = ((x ^ k) - y) <<< 8
+#define RI(x, y, k) \
+	y = ROR(_mm256_xor_si256(y, x), 3); \
+	x = ROL8(_mm256_sub_epi64(_mm256_xor_si256(x, k), y))
+
+/*
+	Split four blocks into their x and y words. The words end up in
+	the block order 0, 2, 1, 3, which STORE undoes.
+*/
+#define LOAD(x, y, blocks) \
+	a = _mm256_loadu_si256((const __m256i*)(blocks)); \
+	b = _mm256_loadu_si256((const __m256i*)(blocks) + 1); \
+	x = _mm256_unpacklo_epi64(a, b); \
+	y = _mm256_unpackhi_epi64(a, b)
+
+#define STORE(out, x, y) \
+	_mm256_storeu_si256((__m256i*)(out), _mm256_unpacklo_epi64(x, y)); \
+	_mm256_storeu_si256((__m256i*)(out) + 1, _mm256_unpackhi_epi64(x, y))
+
+size_t SPECK_encrypt_blocks_avx2(const uint64_t* subkeys, int nrSubkeys, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	const __m256i ror8 = _mm256_set_epi8(
+		8, 15, 14, 13, 12, 11, 10, 9, 0, 7, 6, 5, 4, 3, 2, 1,
+		8, 15, 14, 13, 12, 11, 10, 9, 0, 7, 6, 5, 4, 3, 2, 1);
+	__m256i a, b, k;
+	__m256i x0, y0, x1, y1, x2, y2, x3, y3;
+	size_t done = 0;
+	int i;
+
+	for (; nrBlocks - done >= 16; done += 16, blocks += 32, out += 32)
+	{
+		LOAD(x0, y0, blocks);
+		LOAD(x1, y1, blocks + 8);
+		LOAD(x2, y2, blocks + 16);
+		LOAD(x3, y3, blocks + 24);
+
+		for (i = 0; i < nrSubkeys; i++)
+		{
+			k = _mm256_set1_epi64x((long long)subkeys[i]);
+			R(x0, y0, k);
+			R(x1, y1, k);
+			R(x2, y2, k);
+			R(x3, y3, k);
+		}
+
+		STORE(out, x0, y0);
+		STORE(out + 8, x1, y1);
+		STORE(out + 16, x2, y2);
+		STORE(out + 24, x3, y3);
+	}
+
+	for (; nrBlocks - done >= 4; done += 4, blocks += 8, out += 8)
+	{
+		LOAD(x0, y0, blocks);
+
+		for (i = 0; i < nrSubkeys; i++)
+		{
+			k = _mm256_set1_epi64x((long long)subkeys[i]);
+			R(x0, y0, k);
+		}
+
+		STORE(out, x0, y0);
+	}
+
+	return done;
+}
+
+size_t SPECK_decrypt_blocks_avx2(const uint64_t* subkeys, int nrSubkeys, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	const __m256i rol8 = _mm256_set_epi8(
+		14, 13, 12, 11, 10, 9, 8, 15, 6, 5, 4, 3, 2, 1, 0, 7,
+		14, 13, 12, 11, 10, 9, 8, 15, 6, 5, 4, 3, 2, 1, 0, 7);
+	__m256i a, b, k;
+	__m256i x0, y0, x1, y1, x2, y2, x3, y3;
+	size_t done = 0;
+	int i;
+
+	for (; nrBlocks - done >= 16; done += 16, blocks += 32, out += 32)
+	{
+		LOAD(x0, y0, blocks);
+		LOAD(x1, y1, blocks + 8);
+		LOAD(x2, y2, blocks + 16);
+		LOAD(x3, y3, blocks + 24);
+
+		for (i = nrSubkeys - 1; i >= 0; i--)
+		{
+			k = _mm256_set1_epi64x((long long)subkeys[i]);
+			RI(x0, y0, k);
+			RI(x1, y1, k);
+			RI(x2, y2, k);
+			RI(x3, y3, k);
+		}
+
+		STORE(out, x0, y0);
+		STORE(out + 8, x1, y1);
+		STORE(out + 16, x2, y2);
+		STORE(out + 24, x3, y3);
+	}
+
+	for (; nrBlocks - done >= 4; done += 4, blocks += 8, out += 8)
+	{
+		LOAD(x0, y0, blocks);
+
+		for (i = nrSubkeys - 1; i >= 0; i--)
+		{
+			k = _mm256_set1_epi64x((long long)subkeys[i]);
+			RI(x0, y0, k);
+		}
+
+		STORE(out, x0, y0);
+	}
+
+	return done;
+}
+
+/*
+	LOAD leaves the blocks in the order 0, 2, 1, 3 and the lanes of
+	the keys are in the natural order, exchanging the middle lanes
+	matches them and is its own inverse.
+*/
+#define BATCH_LOAD(x, y, blocks) \
+	LOAD(x, y, blocks); \
+	x = _mm256_permute4x64_epi64(x, 0xd8); \
+	y = _mm256_permute4x64_epi64(y, 0xd8)
+
+#define BATCH_STORE(out, x, y) \
+	x = _mm256_permute4x64_epi64(x, 0xd8); \
+	y = _mm256_permute4x64_epi64(y, 0xd8); \
+	STORE(out, x, y)
+
+// word w of the keys of the lanes 4 * n to 4 * n + 3
+#define KEY(w, n) _mm256_loadu_si256((const __m256i*)(keys + (w) * SPECK_BATCH_LANES) + (n))
+
+// a round of both halves of the batch under the subkeys in A0 and A1
+#define BATCH_R R(x0, y0, A0); R(x1, y1, A1)
+
+// a step of the key schedule, the word l is mixed into A with the counter i
+#define KEY_R(l, i) \
+	k = _mm256_set1_epi64x((long long)(i)); \
+	R(l##0, A0, k); \
+	R(l##1, A1, k)
+
+void SPECK_encrypt_batch_avx2(const uint64_t* subkeys, int nrSubkeys, const uint64_t* blocks, uint64_t* out)
+{
+	const __m256i ror8 = _mm256_set_epi8(
+		8, 15, 14, 13, 12, 11, 10, 9, 0, 7, 6, 5, 4, 3, 2, 1,
+		8, 15, 14, 13, 12, 11, 10, 9, 0, 7, 6, 5, 4, 3, 2, 1);
+	__m256i a, b;
+	__m256i x0, y0, x1, y1;
+	int i;
+
+	BATCH_LOAD(x0, y0, blocks);
+	BATCH_LOAD(x1, y1, blocks + 8);
+
+	for (i = 0; i < nrSubkeys; i++, subkeys += SPECK_BATCH_LANES)
+	{
+		R(x0, y0, _mm256_loadu_si256((const __m256i*)subkeys));
+		R(x1, y1, _mm256_loadu_si256((const __m256i*)subkeys + 1));
+	}
+
+	BATCH_STORE(out, x0, y0);
+	BATCH_STORE(out + 8, x1, y1);
+}
+
+void SPECK_encrypt_batch_keys_avx2(const uint64_t* keys, uint16_t keyLen, const uint64_t* blocks, uint64_t* out)
+{
+	const __m256i ror8 = _mm256_set_epi8(
+		8, 15, 14, 13, 12, 11, 10, 9, 0, 7, 6, 5, 4, 3, 2, 1,
+		8, 15, 14, 13, 12, 11, 10, 9, 0, 7, 6, 5, 4, 3, 2, 1);
+	__m256i a, b, k;
+	__m256i x0, y0, x1, y1;
+	__m256i A0, B0, C0, D0;
+	__m256i A1, B1, C1, D1;
+	int i;
+
+	BATCH_LOAD(x0, y0, blocks);
+	BATCH_LOAD(x1, y1, blocks + 8);
+
+	if (keyLen == 128)
+	{
+		A0 = KEY(1, 0); A1 = KEY(1, 1);
+		B0 = KEY(0, 0); B1 = KEY(0, 1);
+
+		for (i = 0; i < 31; i++)
+		{
+			BATCH_R;
+			KEY_R(B, i);
+		}
+	}
+	else if (keyLen == 192)
+	{
+		A0 = KEY(2, 0); A1 = KEY(2, 1);
+		B0 = KEY(1, 0); B1 = KEY(1, 1);
+		C0 = KEY(0, 0); C1 = KEY(0, 1);
+
+		for (i = 0; i < 32; i += 2)
+		{
+			BATCH_R;
+			KEY_R(B, i);
+			BATCH_R;
+			KEY_R(C, i + 1);
+		}
+	}
+	else // 256
+	{
+		A0 = KEY(3, 0); A1 = KEY(3, 1);
+		B0 = KEY(2, 0); B1 = KEY(2, 1);
+		C0 = KEY(1, 0); C1 = KEY(1, 1);
+		D0 = KEY(0, 0); D1 = KEY(0, 1);
+
+		for (i = 0; i < 33; i += 3)
+		{
+			BATCH_R;
+			KEY_R(B, i);
+			BATCH_R;
+			KEY_R(C, i + 1);
+			BATCH_R;
+			KEY_R(D, i + 2);
+		}
+	}
+
+	BATCH_R;
+
+	BATCH_STORE(out, x0, y0);
+	BATCH_STORE(out + 8, x1, y1);
+}
+
+#endif
@@ -0,0 +1,40 @@
+/* SPECK_AVX2.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * SPECK-128 bulk and batch kernels with AVX2, used by the bulk and
+ * batch functions of SPECK.c when the CPU supports it. Must be
+ * compiled with AVX2 enabled.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// blocks of a batch kernel, each one under its own key
+#define SPECK_BATCH_LANES 8
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SPECK_AVX2
+#endif
+
+/*
+	Process the largest multiple of 4 blocks of nrBlocks and return
+	how many blocks were processed, the caller handles the rest.
+*/
+size_t SPECK_encrypt_blocks_avx2(const uint64_t* subkeys, int nrSubkeys, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
+size_t SPECK_decrypt_blocks_avx2(const uint64_t* subkeys, int nrSubkeys, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
+
+/*
+	Encrypt SPECK_BATCH_LANES blocks, the block b under the key b.
+	The subkeys are in structure of arrays layout, the subkey i of
+	the key b is subkeys[i * SPECK_BATCH_LANES + b]. The keys variant
+	runs the key schedule in the lanes along with the rounds, the
+	word w of the key b (as given to SPECK_init) is
+	keys[w * SPECK_BATCH_LANES + b].
+*/
+void SPECK_encrypt_batch_avx2(const uint64_t* subkeys, int nrSubkeys, const uint64_t* blocks, uint64_t* out);
+void SPECK_encrypt_batch_keys_avx2(const uint64_t* keys, uint16_t keyLen, const uint64_t* blocks, uint64_t* out);
@@ -0,0 +1,135 @@
+/* SPECK_SSE2.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * SPECK-128 bulk encryption and decryption with SSE2.
+ *
+ * A register holds the x (or y) words of two blocks, four pairs of
+ * registers are processed per iteration so the add-rotate-xor
+ * chains of 8 blocks overlap. SSE2 has no rotation, so rotations
+ * are two shifts and an or.
+ *
+ */
+
+#include "SPECK_SSE2.h"
+
+#ifdef SPECK_SSE2
+
+#include <emmintrin.h>
+
+#define ROL(v, n) _mm_or_si128(_mm_slli_epi64(v, n), _mm_srli_epi64(v, 64 - (n)))
+#define ROR(v, n) _mm_or_si128(_mm_srli_epi64(v, n), _mm_slli_epi64(v, 64 - (n)))
+
+// x = ((x >>> 8) + y) ^ k, y = (y <<< 3) ^ x
+#define R(x, y, k) \
+	x = _mm_xor_si128(_mm_add_epi64(ROR(x, 8), y), k); \
+	y = _mm_xor_si128(ROL(y, 3), x)
+
+// y = (y ^ x) >>> 3, x = ((x ^ k) - y) <<< 8
+#define RI(x, y, k) \
+	y = ROR(_mm_xor_si128(y, x), 3); \
+	x = ROL(_mm_sub_epi64(_mm_xor_si128(x, k), y), 8)
+
+// split two blocks into their x and y words
+#define LOAD(x, y, blocks) \
+	a = _mm_loadu_si128((const __m128i*)(blocks)); \
+	b = _mm_loadu_si128((const __m128i*)(blocks) + 1); \
+	x = _mm_unpacklo_epi64(a, b); \
+	y = _mm_unpackhi_epi64(a, b)
+
+#define STORE(out, x, y) \
+	_mm_storeu_si128((__m128i*)(out), _mm_unpacklo_epi64(x, y)); \
+	_mm_storeu_si128((__m128i*)(out) + 1, _mm_unpackhi_epi64(x, y))
+
+size_t SPECK_encrypt_blocks_sse2(const uint64_t* subkeys, int nrSubkeys, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	__m128i a, b, k;
+	__m128i x0, y0, x1, y1, x2, y2, x3, y3;
+	size_t done = 0;
+	int i;
+
+	for (; nrBlocks - done >= 8; done += 8, blocks += 16, out += 16)
+	{
+		LOAD(x0, y0, blocks);
+		LOAD(x1, y1, blocks + 4);
+		LOAD(x2, y2, blocks + 8);
+		LOAD(x3, y3, blocks + 12);
+
+		for (i = 0; i < nrSubkeys; i++)
+		{
+			k = _mm_set1_epi64x((long long)subkeys[i]);
+			R(x0, y0, k);
+			R(x1, y1, k);
+			R(x2, y2, k);
+			R(x3, y3, k);
+		}
+
+		STORE(out, x0, y0);
+		STORE(out + 4, x1, y1);
+		STORE(out + 8, x2, y2);
+		STORE(out + 12, x3, y3);
+	}
+
+	for (; nrBlocks - done >= 2; done += 2, blocks += 4, out += 4)
+	{
+		LOAD(x0, y0, blocks);
+
+		for (i = 0; i < nrSubkeys; i++)
+		{
+			k = _mm_set1_epi64x((long long)subkeys[i]);
+			R(x0, y0, k);
+		}
+
+		STORE(out, x0, y0);
+	}
+
+	return done;
+}
+
+size_t SPECK_decrypt_blocks_sse2(const uint64_t* subkeys, int nrSubkeys, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	__m128i a, b, k;
+	__m128i x0, y0, x1, y1, x2, y2, x3, y3;
+	size_t done = 0;
+	int i;
+
+	for (; nrBlocks - done >= 8; done += 8, blocks += 16, out += 16)
+	{
+		LOAD(x0, y0, blocks);
+		LOAD(x1, y1, blocks + 4);
+		LOAD(x2, y2, blocks + 8);
+		LOAD(x3, y3, blocks + 12);
+
+		for (i = nrSubkeys - 1; i >= 0; i--)
+		{
+			k = _mm_set1_epi64x((long long)subkeys[i]);
+			RI(x0, y0, k);
+			RI(x1, y1, k);
+			RI(x2, y2, k);
+			RI(x3, y3, k);
+		}
+
+		STORE(out, x0, y0);
+		STORE(out + 4, x1, y1);
+		STORE(out + 8, x2, y2);
+		STORE(out + 12, x3, y3);
+	}
+
+	for (; nrBlocks - done >= 2; done += 2, blocks += 4, out += 4)
+	{
+		LOAD(x0, y0, blocks);
+
+		for (i = nrSubkeys - 1; i >= 0; i--)
+		{
+			k = _mm_set1_epi64x((long long)subkeys[i]);
+			RI(x0, y0, k);
+		}
+
+		STORE(out, x0, y0);
+	}
+
+	return done;
+}
+
+#endif
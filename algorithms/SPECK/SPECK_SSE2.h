@@ -0,0 +1,26 @@
+/* SPECK_SSE2.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * SPECK-128 bulk kernels with SSE2, used by the bulk functions of
+ * SPECK.c when the CPU supports it. Must be compiled with SSE2
+ * enabled.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SPECK_SSE2
+#endif
+
+/*
+	Process the largest multiple of 2 blocks of nrBlocks and return
+	how many blocks were processed, the caller handles the rest.
+*/
+size_t SPECK_encrypt_blocks_sse2(const uint64_t* subkeys, int nrSubkeys, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
+size_t SPECK_decrypt_blocks_sse2(const uint64_t* subkeys, int nrSubkeys, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
@@ -0,0 +1,151 @@
+/* bench.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Command line of the throughput, key setup and key pressure
+ * benchmarks, the validation of the ciphers stays in main.c.
+ *
+ * usage: bench [--key-setup | --key-pressure] [--format text|csv|json] [--cipher NAME]
+ *              [--mode MODE] [--min-size BYTES] [--max-size BYTES]
+ *              [--repetitions N] [--min-time SECONDS] [--output FILE]
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "benchmark/BENCHMARK.h"
+#include "cpu/CPU.h"
+
+static int usage(void)
+{
+	fprintf(stderr, "usage: bench [--key-setup | --key-pressure] [--format text|csv|json] [--cipher NAME] [--mode ecb-encrypt|ecb-decrypt|ctr|ctr-parallel]\n"
+		"             [--min-size BYTES] [--max-size BYTES] [--repetitions N] [--min-time SECONDS] [--output FILE]\n");
+	return 1;
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options;
+	const char* output = NULL;
+	const char* value;
+	int keySetup = 0;
+	int keyPressure = 0;
+	int result;
+	int i;
+
+	CPU_init();
+	BENCHMARK_defaults(&options);
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--key-setup") == 0)
+		{
+			keySetup = 1;
+			continue;
+		}
+
+		if (strcmp(argv[i], "--key-pressure") == 0)
+		{
+			keyPressure = 1;
+			continue;
+		}
+
+		if (i + 1 == argc)
+		{
+			return usage();
+		}
+
+		value = argv[++i];
+
+		if (strcmp(argv[i - 1], "--format") == 0)
+		{
+			if (strcmp(value, "text") == 0)
+			{
+				options.format = BENCHMARK_TEXT;
+			}
+			else if (strcmp(value, "csv") == 0)
+			{
+				options.format = BENCHMARK_CSV;
+			}
+			else if (strcmp(value, "json") == 0)
+			{
+				options.format = BENCHMARK_JSON;
+			}
+			else
+			{
+				return usage();
+			}
+		}
+		else if (strcmp(argv[i - 1], "--cipher") == 0)
+		{
+			options.cipher = value;
+		}
+		else if (strcmp(argv[i - 1], "--mode") == 0)
+		{
+			options.mode = value;
+		}
+		else if (strcmp(argv[i - 1], "--min-size") == 0)
+		{
+			options.minSize = (size_t)strtoull(value, NULL, 10);
+		}
+		else if (strcmp(argv[i - 1], "--max-size") == 0)
+		{
+			options.maxSize = (size_t)strtoull(value, NULL, 10);
+		}
+		else if (strcmp(argv[i - 1], "--repetitions") == 0)
+		{
+			options.repetitions = (unsigned)strtoul(value, NULL, 10);
+		}
+		else if (strcmp(argv[i - 1], "--min-time") == 0)
+		{
+			options.minTime = strtod(value, NULL);
+		}
+		else if (strcmp(argv[i - 1], "--output") == 0)
+		{
+			output = value;
+		}
+		else
+		{
+			return usage();
+		}
+	}
+
+	if (output != NULL)
+	{
+		options.output = fopen(output, "w");
+
+		if (options.output == NULL)
+		{
+			perror(output);
+			return 1;
+		}
+	}
+
+	if (keySetup)
+	{
+		result = BENCHMARK_keySetup(&options);
+	}
+	else if (keyPressure)
+	{
+		result = BENCHMARK_keyPressure(&options);
+	}
+	else
+	{
+		result = BENCHMARK_throughput(&options);
+	}
+
+	if (output != NULL)
+	{
+		fclose(options.output);
+	}
+
+	if (result <= 0)
+	{
+		fprintf(stderr, "bench: invalid options or nothing to measure\n");
+		return 1;
+	}
+
+	return 0;
+}
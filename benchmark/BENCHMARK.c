@@ -0,0 +1,661 @@
+/* BENCHMARK.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Throughput and key setup measurements of the ciphers of the
+ * registry, with the results written as a text table, CSV or JSON.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define BENCHMARK_TSC
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define BENCHMARK_TSC
+#endif
+
+#include "BENCHMARK.h"
+#include "../registry/REGISTRY.h"
+#include "../modes/CTR/CTR.h"
+#include "../modes/CTR64/CTR64.h"
+#include "../threads/THREADPOOL.h"
+#include "../cpu/CPU.h"
+
+#define MAX_REPETITIONS 1001
+
+#define ECB_ENCRYPT 0
+#define ECB_DECRYPT 1
+#define CTR 2
+#define CTR_PARALLEL 3
+#define NR_MODES 4
+
+// init, then encryption of nrBlocks blocks
+#define KEY_SETUP 4
+// one block under one of nrKeys contexts taken at random
+#define KEY_PRESSURE 5
+
+#define KEY_PRESSURE_MIN_KEYS 16
+#define KEY_PRESSURE_MAX_KEYS ((size_t)1 << 20)
+
+static const size_t keySetupBlocks[] = { 0, 1, 4, 16, 64 };
+
+static const char* modeNames[NR_MODES] = { "ecb-encrypt", "ecb-decrypt", "ctr", "ctr-parallel" };
+
+typedef struct
+{
+	const CipherDescriptor* cipher;
+	void* context;
+	int mode;
+	uint8_t* key;
+	uint16_t keyLen;
+	size_t nrBlocks;
+	uint8_t* contexts;
+	size_t nrKeys;
+	uint64_t state;
+	CtrContext ctr;
+	Ctr64Context ctr64;
+	ThreadPool* pool;
+	const uint8_t* in;
+	uint8_t* out;
+	size_t length;
+} BenchmarkJob;
+
+typedef struct
+{
+	const char* cipher;
+	uint16_t keyLen;
+	const char* mode;
+	size_t length;
+	unsigned repetitions;
+	unsigned long iterations;
+	// per run of the job
+	double cyclesMedian;
+	double cyclesMin;
+	double secondsMedian;
+	double secondsMin;
+} BenchmarkResult;
+
+// monotonic time in seconds
+double BENCHMARK_now(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+#endif
+}
+
+// time stamp counter, 0 where there is none
+uint64_t BENCHMARK_cycles(void)
+{
+#ifdef BENCHMARK_TSC
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+void BENCHMARK_defaults(BenchmarkOptions* options)
+{
+	options->cipher = NULL;
+	options->mode = NULL;
+	options->minSize = 16;
+	options->maxSize = (size_t)64 << 20;
+	options->repetitions = 7;
+	options->minTime = 0.01;
+	options->format = BENCHMARK_TEXT;
+	options->output = stdout;
+}
+
+static void run(BenchmarkJob* job)
+{
+	size_t nrBlocks = job->length / job->cipher->blockSize;
+
+	if (job->mode == KEY_SETUP)
+	{
+		// a new key every time, as a session would
+		job->key[0]++;
+		REGISTRY_init(job->cipher, job->context, job->key, job->keyLen);
+
+		if (job->nrBlocks > 0)
+		{
+			job->cipher->encryptBlocks(job->context, job->in, job->out, job->nrBlocks);
+		}
+	}
+	else if (job->mode == KEY_PRESSURE)
+	{
+		// the keys come in random order, as the requests of many devices would
+		job->state = job->state * 6364136223846793005ULL + 1442695040888963407ULL;
+		job->cipher->encrypt(job->contexts + (size_t)(job->state >> 32 & (job->nrKeys - 1)) * job->cipher->contextSize,
+			job->in, job->out);
+	}
+	else if (job->mode == ECB_ENCRYPT)
+	{
+		job->cipher->encryptBlocks(job->context, job->in, job->out, nrBlocks);
+	}
+	else if (job->mode == ECB_DECRYPT)
+	{
+		job->cipher->decryptBlocks(job->context, job->in, job->out, nrBlocks);
+	}
+	else if (job->mode == CTR_PARALLEL)
+	{
+		CTR_crypt_parallel(&job->ctr, job->pool, 0, job->in, job->out, job->length);
+	}
+	else if (job->cipher->blockSize == CTR_BLOCK_SIZE)
+	{
+		CTR_crypt(&job->ctr, 0, job->in, job->out, job->length);
+	}
+	else
+	{
+		// the stream goes on, seeking back would reuse the buffered keystream
+		CTR64_crypt(&job->ctr64, job->in, job->out, job->length);
+	}
+}
+
+static int compareDoubles(const void* a, const void* b)
+{
+	double x = *(const double*)a;
+	double y = *(const double*)b;
+
+	return x < y ? -1 : x > y;
+}
+
+static double median(double* values, unsigned n)
+{
+	qsort(values, n, sizeof(double), compareDoubles);
+
+	return n % 2 == 1 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+/*
+	Warm up for at least minTime, which also estimates the duration
+	of one run, then time the repetitions, each running the job as
+	many times as needed to last minTime.
+*/
+static void measure(BenchmarkJob* job, const BenchmarkOptions* options, BenchmarkResult* result)
+{
+	double seconds[MAX_REPETITIONS];
+	double cycles[MAX_REPETITIONS];
+	double start = BENCHMARK_now();
+	double elapsed;
+	uint64_t startCycles;
+	unsigned long runs = 0;
+	unsigned long i;
+	unsigned r;
+
+	do
+	{
+		run(job);
+		runs++;
+		elapsed = BENCHMARK_now() - start;
+	} while (elapsed < options->minTime);
+
+	result->iterations = (unsigned long)(options->minTime * runs / elapsed) + 1;
+	result->repetitions = options->repetitions;
+
+	for (r = 0; r < result->repetitions; r++)
+	{
+		start = BENCHMARK_now();
+		startCycles = BENCHMARK_cycles();
+
+		for (i = 0; i < result->iterations; i++)
+		{
+			run(job);
+		}
+
+		cycles[r] = (double)(BENCHMARK_cycles() - startCycles) / result->iterations;
+		seconds[r] = (BENCHMARK_now() - start) / result->iterations;
+	}
+
+	result->cyclesMedian = median(cycles, result->repetitions);
+	result->cyclesMin = cycles[0];
+	result->secondsMedian = median(seconds, result->repetitions);
+	result->secondsMin = seconds[0];
+}
+
+// columns is the CSV header and text the header of the table
+static void printHeader(const BenchmarkOptions* options, const char* columns, const char* text)
+{
+	char features[64];
+
+	CPU_describe(CPU_features(), features, sizeof(features));
+
+	if (options->format == BENCHMARK_JSON)
+	{
+		fprintf(options->output, "{\n  \"cpu\": \"%s\",\n  \"results\": [", features);
+	}
+	else if (options->format == BENCHMARK_CSV)
+	{
+		fprintf(options->output, "%s\n", columns);
+	}
+	else
+	{
+		fprintf(options->output, "kernels: %s\n\n%s\n", features, text);
+	}
+}
+
+static void printResult(const BenchmarkOptions* options, const BenchmarkResult* result, int first)
+{
+	// GB/s of the median and of the fastest repetition
+	double median = 1e-9 * result->length / result->secondsMedian;
+	double max = 1e-9 * result->length / result->secondsMin;
+	double cyclesMedian = result->cyclesMedian / result->length;
+	double cyclesMin = result->cyclesMin / result->length;
+
+	if (options->format == BENCHMARK_JSON)
+	{
+		fprintf(options->output, "%s\n    { \"cipher\": \"%s\", \"keyBits\": %u, \"mode\": \"%s\", \"bytes\": %lu, "
+			"\"repetitions\": %u, \"iterations\": %lu, \"cyclesPerByteMedian\": %.4f, \"cyclesPerByteMin\": %.4f, "
+			"\"gbPerSecondMedian\": %.4f, \"gbPerSecondMax\": %.4f }",
+			first ? "" : ",", result->cipher, result->keyLen, result->mode, (unsigned long)result->length,
+			result->repetitions, result->iterations, cyclesMedian, cyclesMin, median, max);
+	}
+	else if (options->format == BENCHMARK_CSV)
+	{
+		fprintf(options->output, "%s,%u,%s,%lu,%u,%lu,%.4f,%.4f,%.4f,%.4f\n",
+			result->cipher, result->keyLen, result->mode, (unsigned long)result->length,
+			result->repetitions, result->iterations, cyclesMedian, cyclesMin, median, max);
+	}
+	else
+	{
+		fprintf(options->output, "%-13s %4u %-12s %10lu %12.2f %12.2f %10.3f %10.3f\n",
+			result->cipher, result->keyLen, result->mode, (unsigned long)result->length,
+			cyclesMedian, cyclesMin, median, max);
+	}
+
+	fflush(options->output);
+}
+
+static void printKeySetup(const BenchmarkOptions* options, const BenchmarkResult* result, int first)
+{
+	// nanoseconds of the median and of the fastest repetition
+	double median = 1e9 * result->secondsMedian;
+	double min = 1e9 * result->secondsMin;
+	double perSecond = 1 / result->secondsMedian;
+
+	if (options->format == BENCHMARK_JSON)
+	{
+		fprintf(options->output, "%s\n    { \"cipher\": \"%s\", \"keyBits\": %u, \"blocks\": %lu, "
+			"\"repetitions\": %u, \"iterations\": %lu, \"nsMedian\": %.1f, \"nsMin\": %.1f, "
+			"\"cyclesMedian\": %.1f, \"cyclesMin\": %.1f, \"perSecondMedian\": %.0f }",
+			first ? "" : ",", result->cipher, result->keyLen, (unsigned long)result->length,
+			result->repetitions, result->iterations, median, min, result->cyclesMedian, result->cyclesMin, perSecond);
+	}
+	else if (options->format == BENCHMARK_CSV)
+	{
+		fprintf(options->output, "%s,%u,%lu,%u,%lu,%.1f,%.1f,%.1f,%.1f,%.0f\n",
+			result->cipher, result->keyLen, (unsigned long)result->length,
+			result->repetitions, result->iterations, median, min, result->cyclesMedian, result->cyclesMin, perSecond);
+	}
+	else
+	{
+		fprintf(options->output, "%-13s %4u %6lu %10.1f %10.1f %12.0f %12.0f %12.0f\n",
+			result->cipher, result->keyLen, (unsigned long)result->length,
+			median, min, result->cyclesMedian, result->cyclesMin, perSecond);
+	}
+
+	fflush(options->output);
+}
+
+static void printKeyPressure(const BenchmarkOptions* options, const BenchmarkResult* result, size_t contextSize, int first)
+{
+	// nanoseconds per block of the median and of the fastest repetition
+	double median = 1e9 * result->secondsMedian;
+	double min = 1e9 * result->secondsMin;
+	double kib = (double)(result->length * contextSize) / 1024;
+
+	if (options->format == BENCHMARK_JSON)
+	{
+		fprintf(options->output, "%s\n    { \"cipher\": \"%s\", \"keyBits\": %u, \"keys\": %lu, \"contextBytes\": %lu, "
+			"\"repetitions\": %u, \"iterations\": %lu, \"nsMedian\": %.1f, \"nsMin\": %.1f, "
+			"\"cyclesMedian\": %.1f, \"cyclesMin\": %.1f }",
+			first ? "" : ",", result->cipher, result->keyLen, (unsigned long)result->length, (unsigned long)contextSize,
+			result->repetitions, result->iterations, median, min, result->cyclesMedian, result->cyclesMin);
+	}
+	else if (options->format == BENCHMARK_CSV)
+	{
+		fprintf(options->output, "%s,%u,%lu,%lu,%u,%lu,%.1f,%.1f,%.1f,%.1f\n",
+			result->cipher, result->keyLen, (unsigned long)result->length, (unsigned long)contextSize,
+			result->repetitions, result->iterations, median, min, result->cyclesMedian, result->cyclesMin);
+	}
+	else
+	{
+		fprintf(options->output, "%-13s %4u %8lu %12.0f %10.1f %10.1f %12.0f %12.0f\n",
+			result->cipher, result->keyLen, (unsigned long)result->length, kib,
+			median, min, result->cyclesMedian, result->cyclesMin);
+	}
+
+	fflush(options->output);
+}
+
+static void printFooter(const BenchmarkOptions* options)
+{
+	if (options->format == BENCHMARK_JSON)
+	{
+		fprintf(options->output, "\n  ]\n}\n");
+	}
+}
+
+/*
+	Measure every combination selected by the options. Returns the
+	number of results, or -1 if the options are invalid or memory
+	cannot be allocated.
+*/
+int BENCHMARK_throughput(const BenchmarkOptions* options)
+{
+	uint64_t context[REGISTRY_MAX_CONTEXT_SIZE / sizeof(uint64_t)];
+	uint8_t key[32];
+	uint8_t counter[CTR_BLOCK_SIZE];
+	uint8_t* in;
+	uint8_t* out;
+	BenchmarkJob job;
+	BenchmarkResult result;
+	size_t c;
+	size_t size;
+	uint8_t k;
+	int m;
+	int nrResults = 0;
+
+	if (options->repetitions == 0 || options->repetitions > MAX_REPETITIONS
+		|| options->minSize == 0 || options->minSize > options->maxSize)
+	{
+		return -1;
+	}
+
+	in = (uint8_t*)malloc(options->maxSize);
+	out = (uint8_t*)malloc(options->maxSize);
+	job.pool = THREADPOOL_create(0);
+
+	if (in == NULL || out == NULL || job.pool == NULL)
+	{
+		free(in);
+		free(out);
+		THREADPOOL_destroy(job.pool);
+		return -1;
+	}
+
+	for (size = 0; size < options->maxSize; size++)
+	{
+		in[size] = (uint8_t)(size * 31 + 7);
+	}
+
+	memset(out, 0, options->maxSize);
+
+	for (size = 0; size < sizeof(key); size++)
+	{
+		key[size] = (uint8_t)size;
+	}
+
+	memset(counter, 0, sizeof(counter));
+
+	printHeader(options, "cipher,key_bits,mode,bytes,repetitions,iterations,"
+		"cycles_per_byte_median,cycles_per_byte_min,gb_per_s_median,gb_per_s_max",
+		"cipher         key mode              bytes   cpb median      cpb min   GB/s med   GB/s max");
+
+	for (c = 0; c < REGISTRY_count(); c++)
+	{
+		job.cipher = REGISTRY_get(c);
+		job.context = context;
+		job.key = key;
+		job.in = in;
+		job.out = out;
+
+		if (options->cipher != NULL && strcmp(options->cipher, job.cipher->name) != 0)
+		{
+			continue;
+		}
+
+		for (k = 0; k < job.cipher->nrKeyLengths; k++)
+		{
+			REGISTRY_init(job.cipher, context, key, job.cipher->keyLengths[k]);
+
+			if (job.cipher->blockSize == CTR_BLOCK_SIZE)
+			{
+				CTR_init(&job.ctr, job.cipher, context, counter);
+			}
+			else if (CTR64_init(&job.ctr64, job.cipher, key, job.cipher->keyLengths[k], counter, CTR64_DEFAULT_BLOCK_LIMIT) != 0)
+			{
+				continue;
+			}
+
+			for (m = 0; m < NR_MODES; m++)
+			{
+				if ((options->mode != NULL && strcmp(options->mode, modeNames[m]) != 0)
+					|| (m == CTR_PARALLEL && job.cipher->blockSize != CTR_BLOCK_SIZE))
+				{
+					continue;
+				}
+
+				job.mode = m;
+
+				for (size = options->minSize; size <= options->maxSize; size *= 4)
+				{
+					// whole blocks only
+					job.length = size - size % job.cipher->blockSize;
+					if (job.length == 0)
+					{
+						continue;
+					}
+
+					measure(&job, options, &result);
+
+					result.cipher = job.cipher->name;
+					result.keyLen = job.cipher->keyLengths[k];
+					result.mode = modeNames[m];
+					result.length = job.length;
+					printResult(options, &result, nrResults == 0);
+					nrResults++;
+
+					if (size > options->maxSize / 4)
+					{
+						break;
+					}
+				}
+			}
+
+			if (job.cipher->blockSize != CTR_BLOCK_SIZE)
+			{
+				CTR64_free(&job.ctr64);
+			}
+		}
+	}
+
+	printFooter(options);
+
+	free(in);
+	free(out);
+	THREADPOOL_destroy(job.pool);
+
+	return nrResults;
+}
+
+/*
+	Measure REGISTRY_init alone and followed by the encryption of a
+	few blocks, the cost of a short session, for every key length of
+	the selected ciphers. The blocks are reported in the length of
+	the results. Returns the number of results, or -1 if the options
+	are invalid.
+*/
+int BENCHMARK_keySetup(const BenchmarkOptions* options)
+{
+	uint64_t context[REGISTRY_MAX_CONTEXT_SIZE / sizeof(uint64_t)];
+	uint8_t key[32];
+	// the largest block count of keySetupBlocks
+	uint8_t in[64 * 16];
+	uint8_t out[64 * 16];
+	BenchmarkJob job;
+	BenchmarkResult result;
+	size_t c;
+	size_t i;
+	uint8_t k;
+	int nrResults = 0;
+
+	if (options->repetitions == 0 || options->repetitions > MAX_REPETITIONS)
+	{
+		return -1;
+	}
+
+	for (i = 0; i < sizeof(in); i++)
+	{
+		in[i] = (uint8_t)(i * 31 + 7);
+	}
+
+	for (i = 0; i < sizeof(key); i++)
+	{
+		key[i] = (uint8_t)i;
+	}
+
+	printHeader(options, "cipher,key_bits,blocks,repetitions,iterations,"
+		"ns_median,ns_min,cycles_median,cycles_min,per_second_median",
+		"cipher         key blocks  ns median     ns min   cyc median      cyc min   per second");
+
+	job.mode = KEY_SETUP;
+	job.context = context;
+	job.key = key;
+	job.in = in;
+	job.out = out;
+	job.length = 0;
+
+	for (c = 0; c < REGISTRY_count(); c++)
+	{
+		job.cipher = REGISTRY_get(c);
+
+		if (options->cipher != NULL && strcmp(options->cipher, job.cipher->name) != 0)
+		{
+			continue;
+		}
+
+		for (k = 0; k < job.cipher->nrKeyLengths; k++)
+		{
+			job.keyLen = job.cipher->keyLengths[k];
+
+			for (i = 0; i < sizeof(keySetupBlocks) / sizeof(keySetupBlocks[0]); i++)
+			{
+				job.nrBlocks = keySetupBlocks[i];
+				measure(&job, options, &result);
+
+				result.cipher = job.cipher->name;
+				result.keyLen = job.keyLen;
+				result.mode = NULL;
+				result.length = job.nrBlocks;
+				printKeySetup(options, &result, nrResults == 0);
+				nrResults++;
+			}
+		}
+	}
+
+	printFooter(options);
+
+	return nrResults;
+}
+
+/*
+	Measure the encryption of one block under a context taken at
+	random among 16 to 2^20 contexts, by factors of 4, for every
+	key length of the selected ciphers. This is the cost of serving
+	many keys at once, where the contexts stop fitting in the caches
+	and their size matters as much as the rounds. The contexts of
+	each measurement take at most maxSize bytes, the number of keys
+	is reported in the length of the results. Returns the number of
+	results, or -1 if the options are invalid.
+*/
+int BENCHMARK_keyPressure(const BenchmarkOptions* options)
+{
+	uint8_t key[32];
+	uint8_t in[16];
+	uint8_t out[16];
+	BenchmarkJob job;
+	BenchmarkResult result;
+	size_t c;
+	size_t i;
+	uint8_t k;
+	int nrResults = 0;
+
+	if (options->repetitions == 0 || options->repetitions > MAX_REPETITIONS)
+	{
+		return -1;
+	}
+
+	for (i = 0; i < sizeof(in); i++)
+	{
+		in[i] = (uint8_t)(i * 31 + 7);
+	}
+
+	printHeader(options, "cipher,key_bits,keys,context_bytes,repetitions,iterations,"
+		"ns_median,ns_min,cycles_median,cycles_min",
+		"cipher         key     keys contexts KiB  ns median     ns min   cyc median      cyc min");
+
+	job.mode = KEY_PRESSURE;
+	job.in = in;
+	job.out = out;
+	job.length = 0;
+	job.state = 1;
+
+	for (c = 0; c < REGISTRY_count(); c++)
+	{
+		job.cipher = REGISTRY_get(c);
+
+		if (options->cipher != NULL && strcmp(options->cipher, job.cipher->name) != 0)
+		{
+			continue;
+		}
+
+		for (k = 0; k < job.cipher->nrKeyLengths; k++)
+		{
+			for (job.nrKeys = KEY_PRESSURE_MIN_KEYS; job.nrKeys <= KEY_PRESSURE_MAX_KEYS; job.nrKeys *= 4)
+			{
+				if (job.nrKeys * job.cipher->contextSize > options->maxSize)
+				{
+					break;
+				}
+
+				job.contexts = (uint8_t*)malloc(job.nrKeys * job.cipher->contextSize);
+				if (job.contexts == NULL)
+				{
+					break;
+				}
+
+				// a different key for every context
+				for (i = 0; i < job.nrKeys; i++)
+				{
+					memset(key, 0, sizeof(key));
+					memcpy(key, &i, sizeof(i));
+					REGISTRY_init(job.cipher, job.contexts + i * job.cipher->contextSize, key, job.cipher->keyLengths[k]);
+				}
+
+				measure(&job, options, &result);
+				free(job.contexts);
+
+				result.cipher = job.cipher->name;
+				result.keyLen = job.cipher->keyLengths[k];
+				result.mode = NULL;
+				result.length = job.nrKeys;
+				printKeyPressure(options, &result, job.cipher->contextSize, nrResults == 0);
+				nrResults++;
+			}
+		}
+	}
+
+	printFooter(options);
+
+	return nrResults;
+}
@@ -0,0 +1,63 @@
+/* BENCHMARK.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Throughput benchmark of the ciphers of the registry, for every
+ * key length, mode and message size.
+ *
+ * The modes are ecb-encrypt and ecb-decrypt (the bulk functions),
+ * ctr (CTR for the 128 bits block ciphers and CTR64, with its
+ * rekeying, for the 64 bits ones) and ctr-parallel (CTR on a thread
+ * pool with one thread per CPU, 128 bits block ciphers only).
+ *
+ * The key setup benchmark measures the init of every key length
+ * alone, then followed by the encryption of 1 to 64 blocks, which is
+ * the cost of the short sessions where the key schedule dominates.
+ *
+ * The key pressure benchmark encrypts one block under a context
+ * taken at random among many, from 16 up to the number whose
+ * contexts fill maxSize bytes, which compares the stored round keys
+ * with the compact contexts generating them during the rounds.
+ *
+ * Each measurement is warmed up, then repeated and reported as the
+ * median and the best repetition. Cycles come from the time stamp
+ * counter, which runs at the nominal frequency and not at the
+ * current one, so cycles/byte is only comparable on the same machine.
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// output formats
+#define BENCHMARK_TEXT 0
+#define BENCHMARK_CSV 1
+#define BENCHMARK_JSON 2
+
+typedef struct
+{
+	// cipher and mode to measure, NULL for all of them, the key setup uses no mode nor size
+	const char* cipher;
+	const char* mode;
+	// message sizes in bytes, from minSize to maxSize by factors of 4,
+	// the key pressure benchmark keeps its contexts under maxSize
+	size_t minSize;
+	size_t maxSize;
+	unsigned repetitions;
+	// minimum duration of the warm-up and of each repetition, in seconds
+	double minTime;
+	int format;
+	FILE* output;
+} BenchmarkOptions;
+
+void BENCHMARK_defaults(BenchmarkOptions* options);
+int BENCHMARK_throughput(const BenchmarkOptions* options);
+int BENCHMARK_keySetup(const BenchmarkOptions* options);
+int BENCHMARK_keyPressure(const BenchmarkOptions* options);
+
+double BENCHMARK_now(void);
+uint64_t BENCHMARK_cycles(void);
@@ -0,0 +1,773 @@
+/* KEYCACHE.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Sharded LRU cache of expanded keys on top of POSIX threads, or of
+ * the native threads when built with Visual Studio.
+ *
+ * This code follows a specification:
+ *		- https://cr.yp.to/siphash/siphash-20120918.pdf
+ *
+ */
+
+#ifdef _WIN32
+// rand_s
+#define _CRT_RAND_S
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "KEYCACHE.h"
+#include "../threads/THREADPOOL.h"
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+typedef CRITICAL_SECTION Mutex;
+
+#define MUTEX_INIT(m) InitializeCriticalSection(m)
+#define MUTEX_DESTROY(m) DeleteCriticalSection(m)
+#define MUTEX_LOCK(m) EnterCriticalSection(m)
+#define MUTEX_UNLOCK(m) LeaveCriticalSection(m)
+
+#else
+
+#include <pthread.h>
+
+typedef pthread_mutex_t Mutex;
+
+#define MUTEX_INIT(m) pthread_mutex_init(m, NULL)
+#define MUTEX_DESTROY(m) pthread_mutex_destroy(m)
+#define MUTEX_LOCK(m) pthread_mutex_lock(m)
+#define MUTEX_UNLOCK(m) pthread_mutex_unlock(m)
+
+#endif
+
+#define MAX_KEY_SIZE 32
+#define INITIAL_BUCKETS 16
+
+typedef struct KeyCacheEntry KeyCacheEntry;
+
+struct KeyCacheEntry
+{
+	// chain of the hash table bucket
+	KeyCacheEntry* next;
+	// least recently used list, most recent first
+	KeyCacheEntry* newer;
+	KeyCacheEntry* older;
+
+	const CipherDescriptor* cipher;
+	uint16_t keyLen;
+	uint64_t hash;
+	uint8_t key[MAX_KEY_SIZE];
+
+	// size of the allocation and the context inside it
+	size_t size;
+	void* context;
+};
+
+typedef struct
+{
+	Mutex lock;
+
+	KeyCacheEntry** buckets;
+	size_t nrBuckets;
+	KeyCacheEntry* newest;
+	KeyCacheEntry* oldest;
+
+	size_t entries;
+	size_t bytes;
+	size_t maxBytes;
+
+	uint64_t hits;
+	uint64_t misses;
+	uint64_t evictions;
+} KeyCacheShard;
+
+struct KeyCache
+{
+	uint64_t secret[2];
+	unsigned nrShards;
+	// log2(nrShards), the shard takes the low bits of the hash
+	unsigned shardBits;
+	KeyCacheShard* shards;
+};
+
+// memset that the compiler cannot drop because the memory is freed afterwards
+static void WIPE(void* x, size_t n)
+{
+	volatile uint8_t* p = (volatile uint8_t*)x;
+
+	while (n--)
+	{
+		*p++ = 0;
+	}
+}
+
+// memcmp without early exit, the time does not depend on where the keys differ
+static int EQUAL(const uint8_t* x, const uint8_t* y, size_t n)
+{
+	uint8_t difference = 0;
+	size_t i;
+
+	for (i = 0; i < n; i++)
+	{
+		difference |= x[i] ^ y[i];
+	}
+
+	return difference == 0;
+}
+
+static uint64_t ROL_64(uint64_t x, uint32_t n)
+{
+	return x << n | x >> (64 - n);
+}
+
+static uint64_t LOAD_64_LE(const uint8_t* x)
+{
+	return (uint64_t)x[7] << 56 | (uint64_t)x[6] << 48
+		| (uint64_t)x[5] << 40 | (uint64_t)x[4] << 32
+		| (uint64_t)x[3] << 24 | (uint64_t)x[2] << 16
+		| (uint64_t)x[1] << 8 | x[0];
+}
+
+static void SIPROUND(uint64_t* v)
+{
+	v[0] += v[1];
+	v[1] = ROL_64(v[1], 13);
+	v[1] ^= v[0];
+	v[0] = ROL_64(v[0], 32);
+	v[2] += v[3];
+	v[3] = ROL_64(v[3], 16);
+	v[3] ^= v[2];
+	v[0] += v[3];
+	v[3] = ROL_64(v[3], 21);
+	v[3] ^= v[0];
+	v[2] += v[1];
+	v[1] = ROL_64(v[1], 17);
+	v[1] ^= v[2];
+	v[2] = ROL_64(v[2], 32);
+}
+
+// SipHash-2-4 of the n bytes of x under the 128 bits key k
+static uint64_t SIPHASH(const uint64_t* k, const uint8_t* x, size_t n)
+{
+	uint64_t v[4];
+	uint64_t m;
+	uint8_t last[8];
+	size_t i;
+
+	v[0] = k[0] ^ 0x736f6d6570736575ULL;
+	v[1] = k[1] ^ 0x646f72616e646f6dULL;
+	v[2] = k[0] ^ 0x6c7967656e657261ULL;
+	v[3] = k[1] ^ 0x7465646279746573ULL;
+
+	for (i = 0; i + 8 <= n; i += 8)
+	{
+		m = LOAD_64_LE(x + i);
+		v[3] ^= m;
+		SIPROUND(v);
+		SIPROUND(v);
+		v[0] ^= m;
+	}
+
+	// the remaining bytes and the length in the most significant byte
+	memset(last, 0, sizeof(last));
+	memcpy(last, x + i, n - i);
+	last[7] = (uint8_t)n;
+	m = LOAD_64_LE(last);
+
+	v[3] ^= m;
+	SIPROUND(v);
+	SIPROUND(v);
+	v[0] ^= m;
+
+	v[2] ^= 0xff;
+	SIPROUND(v);
+	SIPROUND(v);
+	SIPROUND(v);
+	SIPROUND(v);
+
+	WIPE(last, sizeof(last));
+
+	return v[0] ^ v[1] ^ v[2] ^ v[3];
+}
+
+// Returns -1 if the operating system gives no random bytes
+static int randomSecret(uint64_t* secret)
+{
+#ifdef _WIN32
+	unsigned int r;
+	int i;
+
+	secret[0] = 0;
+	secret[1] = 0;
+
+	for (i = 0; i < 4; i++)
+	{
+		if (rand_s(&r) != 0)
+		{
+			return -1;
+		}
+
+		secret[i / 2] = secret[i / 2] << 32 | r;
+	}
+
+	return 0;
+#else
+	FILE* random = fopen("/dev/urandom", "rb");
+	size_t n;
+
+	if (random == NULL)
+	{
+		return -1;
+	}
+
+	n = fread(secret, sizeof(uint64_t), 2, random);
+	fclose(random);
+
+	return n == 2 ? 0 : -1;
+#endif
+}
+
+static KeyCacheShard* shardOf(KeyCache* cache, uint64_t hash)
+{
+	return &cache->shards[hash & (cache->nrShards - 1)];
+}
+
+static KeyCacheEntry** bucketOf(KeyCache* cache, KeyCacheShard* shard, uint64_t hash)
+{
+	return &shard->buckets[(hash >> cache->shardBits) & (shard->nrBuckets - 1)];
+}
+
+static KeyCacheEntry* find(KeyCache* cache, KeyCacheShard* shard, const CipherDescriptor* cipher, const uint8_t* key, uint16_t keyLen, uint64_t hash)
+{
+	KeyCacheEntry* entry;
+
+	for (entry = *bucketOf(cache, shard, hash); entry != NULL; entry = entry->next)
+	{
+		if (entry->hash == hash && entry->cipher == cipher && entry->keyLen == keyLen
+			&& EQUAL(entry->key, key, (keyLen + 7) / 8))
+		{
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static void unlinkLru(KeyCacheShard* shard, KeyCacheEntry* entry)
+{
+	if (entry->newer != NULL)
+	{
+		entry->newer->older = entry->older;
+	}
+	else
+	{
+		shard->newest = entry->older;
+	}
+
+	if (entry->older != NULL)
+	{
+		entry->older->newer = entry->newer;
+	}
+	else
+	{
+		shard->oldest = entry->newer;
+	}
+}
+
+static void pushLru(KeyCacheShard* shard, KeyCacheEntry* entry)
+{
+	entry->newer = NULL;
+	entry->older = shard->newest;
+
+	if (shard->newest != NULL)
+	{
+		shard->newest->newer = entry;
+	}
+	else
+	{
+		shard->oldest = entry;
+	}
+
+	shard->newest = entry;
+}
+
+static void freeEntry(KeyCacheEntry* entry)
+{
+	WIPE(entry, entry->size);
+	free(entry);
+}
+
+static void removeEntry(KeyCache* cache, KeyCacheShard* shard, KeyCacheEntry* entry)
+{
+	KeyCacheEntry** link = bucketOf(cache, shard, entry->hash);
+
+	while (*link != entry)
+	{
+		link = &(*link)->next;
+	}
+
+	*link = entry->next;
+	unlinkLru(shard, entry);
+
+	shard->entries--;
+	shard->bytes -= entry->size;
+	freeEntry(entry);
+}
+
+// twice as many buckets, nothing changes if there is no memory for them
+static void grow(KeyCache* cache, KeyCacheShard* shard)
+{
+	KeyCacheEntry** old = shard->buckets;
+	size_t nrOld = shard->nrBuckets;
+	KeyCacheEntry* entry;
+	KeyCacheEntry** bucket;
+	size_t i;
+
+	shard->buckets = (KeyCacheEntry**)calloc(2 * nrOld, sizeof(KeyCacheEntry*));
+	if (shard->buckets == NULL)
+	{
+		shard->buckets = old;
+		return;
+	}
+
+	shard->nrBuckets = 2 * nrOld;
+
+	for (i = 0; i < nrOld; i++)
+	{
+		while (old[i] != NULL)
+		{
+			entry = old[i];
+			old[i] = entry->next;
+
+			bucket = bucketOf(cache, shard, entry->hash);
+			entry->next = *bucket;
+			*bucket = entry;
+		}
+	}
+
+	free(old);
+}
+
+static void insert(KeyCache* cache, KeyCacheShard* shard, KeyCacheEntry* entry)
+{
+	KeyCacheEntry** bucket;
+
+	while (shard->bytes + entry->size > shard->maxBytes)
+	{
+		removeEntry(cache, shard, shard->oldest);
+		shard->evictions++;
+	}
+
+	if (shard->entries >= shard->nrBuckets)
+	{
+		grow(cache, shard);
+	}
+
+	bucket = bucketOf(cache, shard, entry->hash);
+	entry->next = *bucket;
+	*bucket = entry;
+	pushLru(shard, entry);
+
+	shard->entries++;
+	shard->bytes += entry->size;
+}
+
+/*
+	maxBytes is shared evenly by the shards, nrShards is rounded up
+	to a power of two and 0 selects KEYCACHE_DEFAULT_SHARDS. Returns
+	NULL if the memory or the random secret cannot be obtained.
+*/
+KeyCache* KEYCACHE_create(size_t maxBytes, unsigned nrShards)
+{
+	KeyCache* cache;
+	unsigned i;
+
+	if (nrShards == 0)
+	{
+		nrShards = KEYCACHE_DEFAULT_SHARDS;
+	}
+
+	cache = (KeyCache*)malloc(sizeof(KeyCache));
+	if (cache == NULL)
+	{
+		return NULL;
+	}
+
+	cache->nrShards = 1;
+	cache->shardBits = 0;
+	while (cache->nrShards < nrShards)
+	{
+		cache->nrShards *= 2;
+		cache->shardBits++;
+	}
+
+	cache->shards = (KeyCacheShard*)calloc(cache->nrShards, sizeof(KeyCacheShard));
+	if (cache->shards == NULL || randomSecret(cache->secret) != 0)
+	{
+		free(cache->shards);
+		free(cache);
+		return NULL;
+	}
+
+	for (i = 0; i < cache->nrShards; i++)
+	{
+		KeyCacheShard* shard = &cache->shards[i];
+
+		shard->buckets = (KeyCacheEntry**)calloc(INITIAL_BUCKETS, sizeof(KeyCacheEntry*));
+		if (shard->buckets == NULL)
+		{
+			cache->nrShards = i;
+			KEYCACHE_destroy(cache);
+			return NULL;
+		}
+
+		shard->nrBuckets = INITIAL_BUCKETS;
+		shard->maxBytes = maxBytes / cache->nrShards;
+		MUTEX_INIT(&shard->lock);
+	}
+
+	return cache;
+}
+
+void KEYCACHE_destroy(KeyCache* cache)
+{
+	unsigned i;
+
+	if (cache == NULL)
+	{
+		return;
+	}
+
+	KEYCACHE_clear(cache);
+
+	for (i = 0; i < cache->nrShards; i++)
+	{
+		free(cache->shards[i].buckets);
+		MUTEX_DESTROY(&cache->shards[i].lock);
+	}
+
+	WIPE(cache->secret, sizeof(cache->secret));
+	free(cache->shards);
+	free(cache);
+}
+
+/*
+	Same as REGISTRY_init, with the context copied from the cache when
+	the key was expanded before. Returns -1 if the key length is not
+	supported, 1 if the context comes from the cache and 0 if the key
+	was expanded, in which case the context is added to the cache.
+	The key is expanded outside of the lock, two threads missing the
+	same key at the same time both expand it and one copy is kept.
+*/
+int KEYCACHE_init(KeyCache* cache, const CipherDescriptor* cipher, void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint8_t message[2 + MAX_KEY_SIZE];
+	size_t keySize = (keyLen + 7) / 8;
+	size_t offset;
+	uint64_t hash;
+	KeyCacheShard* shard;
+	KeyCacheEntry* entry;
+
+	if (!REGISTRY_supportsKeyLength(cipher, keyLen) || keySize > MAX_KEY_SIZE)
+	{
+		return -1;
+	}
+
+	// key length and key, the cipher is compared in the entries
+	message[0] = (uint8_t)(keyLen >> 8);
+	message[1] = (uint8_t)keyLen;
+	memcpy(message + 2, key, keySize);
+	hash = SIPHASH(cache->secret, message, 2 + keySize);
+	WIPE(message, sizeof(message));
+
+	shard = shardOf(cache, hash);
+
+	MUTEX_LOCK(&shard->lock);
+
+	entry = find(cache, shard, cipher, key, keyLen, hash);
+	if (entry != NULL)
+	{
+		memcpy(context, entry->context, cipher->contextSize);
+		unlinkLru(shard, entry);
+		pushLru(shard, entry);
+		shard->hits++;
+
+		MUTEX_UNLOCK(&shard->lock);
+		return 1;
+	}
+
+	shard->misses++;
+
+	MUTEX_UNLOCK(&shard->lock);
+
+	cipher->init(context, key, keyLen);
+
+	// the context follows the entry at its alignment
+	offset = (sizeof(KeyCacheEntry) + cipher->contextAlignment - 1) / cipher->contextAlignment * cipher->contextAlignment;
+	if (offset + cipher->contextSize > shard->maxBytes)
+	{
+		return 0;
+	}
+
+	entry = (KeyCacheEntry*)malloc(offset + cipher->contextSize);
+	if (entry == NULL)
+	{
+		return 0;
+	}
+
+	entry->cipher = cipher;
+	entry->keyLen = keyLen;
+	entry->hash = hash;
+	memset(entry->key, 0, sizeof(entry->key));
+	memcpy(entry->key, key, keySize);
+	entry->size = offset + cipher->contextSize;
+	entry->context = (uint8_t*)entry + offset;
+	memcpy(entry->context, context, cipher->contextSize);
+
+	MUTEX_LOCK(&shard->lock);
+
+	if (find(cache, shard, cipher, key, keyLen, hash) == NULL)
+	{
+		insert(cache, shard, entry);
+		entry = NULL;
+	}
+
+	MUTEX_UNLOCK(&shard->lock);
+
+	// another thread added the same key in the meantime
+	if (entry != NULL)
+	{
+		freeEntry(entry);
+	}
+
+	return 0;
+}
+
+// remove and wipe every entry, the counters are kept
+void KEYCACHE_clear(KeyCache* cache)
+{
+	unsigned i;
+
+	for (i = 0; i < cache->nrShards; i++)
+	{
+		KeyCacheShard* shard = &cache->shards[i];
+
+		MUTEX_LOCK(&shard->lock);
+
+		while (shard->oldest != NULL)
+		{
+			removeEntry(cache, shard, shard->oldest);
+		}
+
+		MUTEX_UNLOCK(&shard->lock);
+	}
+}
+
+void KEYCACHE_stats(KeyCache* cache, KeyCacheStats* stats)
+{
+	unsigned i;
+
+	memset(stats, 0, sizeof(KeyCacheStats));
+
+	for (i = 0; i < cache->nrShards; i++)
+	{
+		KeyCacheShard* shard = &cache->shards[i];
+
+		MUTEX_LOCK(&shard->lock);
+
+		stats->hits += shard->hits;
+		stats->misses += shard->misses;
+		stats->evictions += shard->evictions;
+		stats->entries += shard->entries;
+		stats->bytes += shard->bytes;
+
+		MUTEX_UNLOCK(&shard->lock);
+	}
+}
+
+#define MAIN_KEYS 32
+#define MAIN_ITERATIONS 2000
+
+typedef struct
+{
+	KeyCache* cache;
+	const CipherDescriptor* cipher;
+	uint8_t (*keys)[MAX_KEY_SIZE];
+	// encryption of the block under each key, without the cache
+	uint8_t (*expected)[16];
+	int* failures;
+} KeyCacheTest;
+
+// random keys of a small set through the cache from every thread
+static void concurrentTask(void* argument, size_t index)
+{
+	KeyCacheTest* test = (KeyCacheTest*)argument;
+	uint64_t context[REGISTRY_MAX_CONTEXT_SIZE / sizeof(uint64_t)];
+	uint8_t block[16];
+	uint8_t out[16];
+	uint32_t state = (uint32_t)index * 2654435761u + 1;
+	size_t k;
+	int i;
+
+	memset(block, 0x5a, sizeof(block));
+
+	for (i = 0; i < MAIN_ITERATIONS; i++)
+	{
+		state = state * 1664525u + 1013904223u;
+		k = (state >> 16) % MAIN_KEYS;
+
+		KEYCACHE_init(test->cache, test->cipher, context, test->keys[k], test->cipher->keyLengths[0]);
+		test->cipher->encrypt(context, block, out);
+
+		if (memcmp(out, test->expected[k], test->cipher->blockSize) != 0)
+		{
+			test->failures[index]++;
+		}
+	}
+}
+
+void KEYCACHE_main(void)
+{
+	uint64_t context[REGISTRY_MAX_CONTEXT_SIZE / sizeof(uint64_t)];
+	uint64_t cached[REGISTRY_MAX_CONTEXT_SIZE / sizeof(uint64_t)];
+	uint8_t keys[MAIN_KEYS][MAX_KEY_SIZE];
+	uint8_t expected[MAIN_KEYS][16];
+	uint8_t block[32];
+	uint8_t out[32];
+	uint8_t cachedOut[32];
+	int failures[8];
+	KeyCacheTest test;
+	KeyCacheStats stats;
+	KeyCache* cache;
+	ThreadPool* pool;
+	const CipherDescriptor* cipher;
+	size_t c;
+	size_t i;
+	uint8_t k;
+	int ok;
+
+	printf("\nKEYCACHE \n\n");
+
+	// the first byte numbers the keys, all of them are different
+	for (i = 0; i < sizeof(keys); i++)
+	{
+		keys[i / MAX_KEY_SIZE][i % MAX_KEY_SIZE] = (uint8_t)(i * 131 + 17);
+	}
+
+	for (i = 0; i < MAIN_KEYS; i++)
+	{
+		keys[i][0] = (uint8_t)i;
+	}
+
+	for (i = 0; i < sizeof(block); i++)
+	{
+		block[i] = (uint8_t)(i * 0x11);
+	}
+
+	// a miss, then a hit giving the same encryption as the key schedule
+	cache = KEYCACHE_create((size_t)1 << 20, 0);
+	if (cache == NULL)
+	{
+		printf("cannot create the cache\n");
+		return;
+	}
+
+	for (c = 0; c < REGISTRY_count(); c++)
+	{
+		cipher = REGISTRY_get(c);
+		ok = 1;
+
+		for (k = 0; k < cipher->nrKeyLengths; k++)
+		{
+			REGISTRY_init(cipher, context, keys[k], cipher->keyLengths[k]);
+			cipher->encryptBlocks(context, block, out, 2);
+
+			ok &= KEYCACHE_init(cache, cipher, cached, keys[k], cipher->keyLengths[k]) == 0;
+			ok &= KEYCACHE_init(cache, cipher, cached, keys[k], cipher->keyLengths[k]) == 1;
+			cipher->encryptBlocks(cached, block, cachedOut, 2);
+			ok &= memcmp(out, cachedOut, 2 * cipher->blockSize) == 0;
+
+			// another key is another entry
+			ok &= KEYCACHE_init(cache, cipher, cached, keys[k + 1], cipher->keyLengths[k]) == 0;
+		}
+
+		printf("%-13s miss then hit: %s\n", cipher->name, ok ? "ok" : "FAILED");
+	}
+
+	KEYCACHE_stats(cache, &stats);
+	printf("hits %u, misses %u, entries %u, %u bytes\n",
+		(unsigned)stats.hits, (unsigned)stats.misses, (unsigned)stats.entries, (unsigned)stats.bytes);
+	KEYCACHE_destroy(cache);
+
+	// GOST contexts are above 4 KiB, 9 of them fill one shard of 40 KiB
+	cipher = REGISTRY_find("GOST");
+	cache = KEYCACHE_create(40 * 1024, 1);
+	if (cache == NULL)
+	{
+		printf("cannot create the cache\n");
+		return;
+	}
+
+	for (i = 0; i < MAIN_KEYS; i++)
+	{
+		KEYCACHE_init(cache, cipher, context, keys[i], cipher->keyLengths[0]);
+	}
+
+	KEYCACHE_stats(cache, &stats);
+	ok = stats.bytes <= 40 * 1024 && stats.evictions == MAIN_KEYS - stats.entries;
+	// the most recent key is still there, the oldest was evicted
+	ok &= KEYCACHE_init(cache, cipher, context, keys[MAIN_KEYS - 1], cipher->keyLengths[0]) == 1;
+	ok &= KEYCACHE_init(cache, cipher, context, keys[0], cipher->keyLengths[0]) == 0;
+	KEYCACHE_clear(cache);
+	KEYCACHE_stats(cache, &stats);
+	ok &= stats.entries == 0 && stats.bytes == 0;
+	printf("eviction under %u bytes: %s\n", 40 * 1024, ok ? "ok" : "FAILED");
+	KEYCACHE_destroy(cache);
+
+	// small cache shared by the threads, evictions and hits interleave
+	cipher = REGISTRY_find("ARIA");
+	cache = KEYCACHE_create(4 * 1024, 4);
+	pool = THREADPOOL_create(8);
+	if (cache == NULL || pool == NULL)
+	{
+		printf("cannot create the cache\n");
+		KEYCACHE_destroy(cache);
+		THREADPOOL_destroy(pool);
+		return;
+	}
+
+	for (i = 0; i < MAIN_KEYS; i++)
+	{
+		REGISTRY_init(cipher, context, keys[i], cipher->keyLengths[0]);
+		memset(out, 0x5a, sizeof(out));
+		cipher->encrypt(context, out, expected[i]);
+	}
+
+	memset(failures, 0, sizeof(failures));
+	test.cache = cache;
+	test.cipher = cipher;
+	test.keys = keys;
+	test.expected = expected;
+	test.failures = failures;
+	THREADPOOL_run(pool, concurrentTask, &test, 8);
+
+	ok = 1;
+	for (i = 0; i < 8; i++)
+	{
+		ok &= failures[i] == 0;
+	}
+
+	KEYCACHE_stats(cache, &stats);
+	ok &= stats.hits + stats.misses == 8 * MAIN_ITERATIONS && stats.bytes <= 4 * 1024;
+	printf("8 threads, %u hits, %u misses, %u evictions: %s\n",
+		(unsigned)stats.hits, (unsigned)stats.misses, (unsigned)stats.evictions, ok ? "ok" : "FAILED");
+
+	THREADPOOL_destroy(pool);
+	KEYCACHE_destroy(cache);
+}
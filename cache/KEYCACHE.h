@@ -0,0 +1,50 @@
+/* KEYCACHE.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Cache of expanded keys for the ciphers of the registry, so the
+ * same keys seen again and again are expanded only once.
+ *
+ * Entries are keyed by (cipher, key length, SipHash of the key under
+ * a random secret of the cache) and hold a copy of the context
+ * filled by the cipher init. A hit copies it into the context of the
+ * caller and skips the key schedule. The contexts of the registry
+ * hold no pointers, so the copy is a complete context.
+ *
+ * The cache is divided in shards, each with its own lock, hash table
+ * and least recently used list, and a share of the byte budget. The
+ * entries evicted or removed are wiped before they are freed.
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../registry/REGISTRY.h"
+
+#define KEYCACHE_DEFAULT_SHARDS 16
+
+typedef struct KeyCache KeyCache;
+
+typedef struct
+{
+	uint64_t hits;
+	uint64_t misses;
+	uint64_t evictions;
+	size_t entries;
+	// memory of the entries, keys and contexts included
+	size_t bytes;
+} KeyCacheStats;
+
+KeyCache* KEYCACHE_create(size_t maxBytes, unsigned nrShards);
+void KEYCACHE_destroy(KeyCache* cache);
+
+int KEYCACHE_init(KeyCache* cache, const CipherDescriptor* cipher, void* context, const uint8_t* key, uint16_t keyLen);
+void KEYCACHE_clear(KeyCache* cache);
+void KEYCACHE_stats(KeyCache* cache, KeyCacheStats* stats);
+
+void KEYCACHE_main(void);
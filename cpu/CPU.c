@@ -0,0 +1,368 @@
+/* CPU.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Detection of the instruction set extensions with cpuid. AVX and
+ * AVX-512 also need the operating system to save the wider registers,
+ * which is checked in XCR0.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "CPU.h"
+#include "../registry/REGISTRY.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define CPU_X86
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define CPU_X86
+#endif
+
+// every extension a kernel uses, AVX-512 is detected but has no kernel yet
+#define CPU_ALL (CPU_SSE2 | CPU_SSSE3 | CPU_AVX | CPU_AVX2 | CPU_AESNI)
+
+typedef struct
+{
+	const char* name;
+	// the extension and the ones its kernels rely on
+	unsigned features;
+} CpuKernel;
+
+static const CpuKernel kernels[] =
+{
+	{ "portable", 0 },
+	{ "sse2", CPU_SSE2 },
+	{ "ssse3", CPU_SSE2 | CPU_SSSE3 },
+	{ "avx2", CPU_SSE2 | CPU_SSSE3 | CPU_AVX | CPU_AVX2 },
+	{ "aesni", CPU_SSE2 | CPU_SSSE3 | CPU_AVX | CPU_AESNI },
+	{ "auto", CPU_ALL }
+};
+
+#define NR_KERNELS (sizeof(kernels) / sizeof(kernels[0]))
+
+static const CpuKernel extensions[] =
+{
+	{ "sse2", CPU_SSE2 },
+	{ "ssse3", CPU_SSSE3 },
+	{ "avx", CPU_AVX },
+	{ "avx2", CPU_AVX2 },
+	{ "avx512", CPU_AVX512 },
+	{ "aesni", CPU_AESNI }
+};
+
+/*
+	CPU_force may run while the threads of a pool query CPU_has, so
+	the state is only read and written with atomic loads and stores.
+	On x86 they are plain moves, CPU_has stays as cheap as before.
+*/
+#ifdef _MSC_VER
+#include <intrin.h>
+// volatile accesses have acquire and release semantics with /volatile:ms, the default
+#define ATOMIC_LOAD(x) (*(volatile unsigned*)&(x))
+#define ATOMIC_STORE(x, v) _InterlockedExchange((volatile long*)&(x), (long)(v))
+#else
+#define ATOMIC_LOAD(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#endif
+
+static unsigned initialized = 0;
+static unsigned detected = 0;
+static unsigned allowed = CPU_ALL;
+
+#ifdef CPU_X86
+
+// eax, ebx, ecx and edx of the given leaf
+static void cpuid(unsigned leaf, unsigned subleaf, unsigned* regs)
+{
+#ifdef _MSC_VER
+	int r[4];
+
+	__cpuidex(r, (int)leaf, (int)subleaf);
+	regs[0] = (unsigned)r[0];
+	regs[1] = (unsigned)r[1];
+	regs[2] = (unsigned)r[2];
+	regs[3] = (unsigned)r[3];
+#else
+	__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// register states enabled by the operating system
+static unsigned xcr0(void)
+{
+#ifdef _MSC_VER
+	return (unsigned)_xgetbv(0);
+#else
+	unsigned eax;
+	unsigned edx;
+
+	__asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return eax;
+#endif
+}
+
+static unsigned detect(void)
+{
+	unsigned regs[4];
+	unsigned maxLeaf;
+	unsigned xcr = 0;
+	unsigned features = 0;
+
+	cpuid(0, 0, regs);
+	maxLeaf = regs[0];
+
+	if (maxLeaf < 1)
+	{
+		return 0;
+	}
+
+	cpuid(1, 0, regs);
+
+	if (regs[3] & (1u << 26))
+	{
+		features |= CPU_SSE2;
+	}
+
+	if (regs[2] & (1u << 9))
+	{
+		features |= CPU_SSSE3;
+	}
+
+	if (regs[2] & (1u << 25))
+	{
+		features |= CPU_AESNI;
+	}
+
+	// OSXSAVE, xgetbv is available
+	if (regs[2] & (1u << 27))
+	{
+		xcr = xcr0();
+	}
+
+	// XMM and YMM states
+	if ((regs[2] & (1u << 28)) && (xcr & 0x06) == 0x06)
+	{
+		features |= CPU_AVX;
+	}
+
+	if (maxLeaf >= 7 && (features & CPU_AVX))
+	{
+		cpuid(7, 0, regs);
+
+		if (regs[1] & (1u << 5))
+		{
+			features |= CPU_AVX2;
+		}
+
+		// AVX-512 foundation, with the opmask and ZMM states
+		if ((regs[1] & (1u << 16)) && (xcr & 0xe0) == 0xe0)
+		{
+			features |= CPU_AVX512;
+		}
+	}
+
+	return features;
+}
+
+#else
+
+static unsigned detect(void)
+{
+	return 0;
+}
+
+#endif
+
+/*
+	Detect the CPU and apply CRYPTO_KERNEL. Called by the first query
+	otherwise, concurrent first queries only detect the same features
+	twice, but calling it at startup avoids it.
+*/
+void CPU_init(void)
+{
+	const char* names = getenv("CRYPTO_KERNEL");
+
+	ATOMIC_STORE(detected, detect());
+	ATOMIC_STORE(initialized, 1);
+
+	if (names != NULL && CPU_force(names) != 0)
+	{
+		fprintf(stderr, "CRYPTO_KERNEL: unknown kernel in \"%s\", using auto\n", names);
+	}
+}
+
+// extensions supported by the CPU, whether forced off or not
+unsigned CPU_detected(void)
+{
+	if (!ATOMIC_LOAD(initialized))
+	{
+		CPU_init();
+	}
+
+	return ATOMIC_LOAD(detected);
+}
+
+// extensions the kernels may use
+unsigned CPU_features(void)
+{
+	return CPU_detected() & ATOMIC_LOAD(allowed);
+}
+
+// non zero if every extension of features may be used
+int CPU_has(unsigned features)
+{
+	return (CPU_features() & features) == features;
+}
+
+/*
+	Restrict the kernels to the comma separated list, NULL is the
+	same as "auto". Returns -1 and changes nothing if a name is not
+	known. Safe while other threads run ciphers: a call running
+	across the change may use kernels from before and after it,
+	which give the same results.
+*/
+int CPU_force(const char* names)
+{
+	unsigned mask = 0;
+	size_t length;
+	size_t i;
+
+	if (names == NULL)
+	{
+		ATOMIC_STORE(allowed, CPU_ALL);
+		return 0;
+	}
+
+	while (*names != '\0')
+	{
+		length = strcspn(names, ",");
+
+		for (i = 0; i < NR_KERNELS; i++)
+		{
+			if (strlen(kernels[i].name) == length && strncmp(kernels[i].name, names, length) == 0)
+			{
+				mask |= kernels[i].features;
+				break;
+			}
+		}
+
+		if (i == NR_KERNELS)
+		{
+			return -1;
+		}
+
+		names += length;
+		if (*names == ',')
+		{
+			names++;
+		}
+	}
+
+	ATOMIC_STORE(allowed, mask);
+	return 0;
+}
+
+// names of the extensions in features separated by spaces
+void CPU_describe(unsigned features, char* buffer, size_t size)
+{
+	size_t length = 0;
+	size_t i;
+
+	if (size == 0)
+	{
+		return;
+	}
+
+	buffer[0] = '\0';
+
+	for (i = 0; i < sizeof(extensions) / sizeof(extensions[0]); i++)
+	{
+		if ((features & extensions[i].features) && length + strlen(extensions[i].name) + 2 <= size)
+		{
+			length += sprintf(buffer + length, length == 0 ? "%s" : " %s", extensions[i].name);
+		}
+	}
+}
+
+/*
+	Every kernel allowed by CRYPTO_KERNEL must give the same result
+	as the portable code, for all the ciphers of the registry.
+*/
+void CPU_main(void)
+{
+	const size_t nrBlocks = 1000;
+	unsigned saved = ATOMIC_LOAD(allowed);
+	uint64_t context[REGISTRY_MAX_CONTEXT_SIZE / sizeof(uint64_t)];
+	uint8_t key[32];
+	uint8_t* text = (uint8_t*)malloc(16 * nrBlocks);
+	uint8_t* expected = (uint8_t*)malloc(16 * nrBlocks);
+	uint8_t* cipherText = (uint8_t*)malloc(16 * nrBlocks);
+	uint8_t* decrypted = (uint8_t*)malloc(16 * nrBlocks);
+	size_t c;
+	size_t k;
+	size_t i;
+	size_t length;
+	char features[64];
+	int ok;
+
+	printf("\nCPU \n\n");
+
+	CPU_describe(CPU_detected(), features, sizeof(features));
+	printf("detected: \t%s\n", features);
+	CPU_describe(CPU_features(), features, sizeof(features));
+	printf("enabled: \t%s\n", features);
+
+	if (text == NULL || expected == NULL || cipherText == NULL || decrypted == NULL)
+	{
+		printf("out of memory\n");
+		free(text);
+		free(expected);
+		free(cipherText);
+		free(decrypted);
+		return;
+	}
+
+	for (i = 0; i < sizeof(key); i++)
+	{
+		key[i] = (uint8_t)(i * 7 + 1);
+	}
+
+	for (i = 0; i < 16 * nrBlocks; i++)
+	{
+		text[i] = (uint8_t)(i * 31 + 7);
+	}
+
+	for (c = 0; c < REGISTRY_count(); c++)
+	{
+		const CipherDescriptor* cipher = REGISTRY_get(c);
+
+		length = cipher->blockSize * nrBlocks;
+		REGISTRY_init(cipher, context, key, cipher->keyLengths[0]);
+
+		ATOMIC_STORE(allowed, 0);
+		cipher->encryptBlocks(context, text, expected, nrBlocks);
+		ok = 1;
+
+		for (k = 1; k < NR_KERNELS; k++)
+		{
+			ATOMIC_STORE(allowed, saved & kernels[k].features);
+			cipher->encryptBlocks(context, text, cipherText, nrBlocks);
+			cipher->decryptBlocks(context, cipherText, decrypted, nrBlocks);
+			ok &= memcmp(cipherText, expected, length) == 0 && memcmp(decrypted, text, length) == 0;
+		}
+
+		printf("%-13s kernels match the portable code: %s\n", cipher->name, ok ? "ok" : "FAILED");
+	}
+
+	ATOMIC_STORE(allowed, saved);
+
+	free(text);
+	free(expected);
+	free(cipherText);
+	free(decrypted);
+}
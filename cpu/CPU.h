@@ -0,0 +1,39 @@
+/* CPU.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Detection of the instruction set extensions used by the SIMD
+ * kernels of the block ciphers. The bulk functions of every cipher
+ * ask CPU_has before calling a kernel, so the same binary runs the
+ * widest kernel each machine supports and the portable code on the
+ * others.
+ *
+ * The environment variable CRYPTO_KERNEL, read by CPU_init, or
+ * CPU_force restricts the kernels that can be used, which is meant
+ * for benchmarking and bisecting. Both take a comma separated list
+ * of the names below, "portable" to disable every kernel or "auto"
+ * to use everything the CPU supports.
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+
+#define CPU_SSE2 0x01
+#define CPU_SSSE3 0x02
+#define CPU_AVX 0x04
+#define CPU_AVX2 0x08
+#define CPU_AVX512 0x10
+#define CPU_AESNI 0x20
+
+void CPU_init(void);
+unsigned CPU_detected(void);
+unsigned CPU_features(void);
+int CPU_has(unsigned features);
+int CPU_force(const char* kernels);
+void CPU_describe(unsigned features, char* buffer, size_t size);
+
+void CPU_main(void);
@@ -20,9 +20,16 @@
 #include "algorithms/SIMON/SIMON.h"
 #include "algorithms/HIGHT/HIGHT.h"
 #include "algorithms/SEED/SEED.h"
+#include "registry/REGISTRY.h"
+#include "cpu/CPU.h"
+#include "modes/CTR/CTR.h"
+#include "modes/CTR64/CTR64.h"
+#include "cache/KEYCACHE.h"
 
 int main()
 {
+	CPU_init();
+
 	GOST_main();
 	ARIA_main();
 	NOEKEON_main();
@@ -33,6 +40,11 @@ int main()
 	SIMON_main();
 	HIGHT_main();
 	SEED_main();
+	REGISTRY_main();
+	CPU_main();
+	CTR_main();
+	CTR64_main();
+	KEYCACHE_main();
 
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,263 @@
+/* CTR.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Implementation of the counter (CTR) mode of operation for the
+ * 128 bits block ciphers, with a multi-threaded variant that
+ * splits the buffer in counter-aligned shards.
+ *
+ * This code follows a specification:
+ *		- https://nvlpubs.nist.gov/nistpubs/Legacy/SP/nistspecialpublication800-38a.pdf
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "CTR.h"
+
+// counter blocks encrypted per call of the bulk function
+#define CHUNK_BLOCKS 64
+
+// smallest amount of bytes worth handing to another thread
+#define MIN_SHARD_SIZE (64 * 1024)
+
+// shards per thread, so faster threads can pick up the remaining work
+#define SHARDS_PER_THREAD 4
+
+typedef struct
+{
+	const CtrContext* ctr;
+	uint64_t offset;
+	const uint8_t* in;
+	uint8_t* out;
+	size_t length;
+	// bytes before the first block boundary of the stream
+	size_t head;
+	size_t shardSize;
+} CtrJob;
+
+static uint64_t LOAD_64(const uint8_t* x)
+{
+	return (uint64_t)x[0] << 56 | (uint64_t)x[1] << 48
+		| (uint64_t)x[2] << 40 | (uint64_t)x[3] << 32
+		| (uint64_t)x[4] << 24 | (uint64_t)x[5] << 16
+		| (uint64_t)x[6] << 8 | x[7];
+}
+
+static void STORE_64(uint8_t* y, uint64_t x)
+{
+	y[0] = (uint8_t)(x >> 56);
+	y[1] = (uint8_t)(x >> 48);
+	y[2] = (uint8_t)(x >> 40);
+	y[3] = (uint8_t)(x >> 32);
+	y[4] = (uint8_t)(x >> 24);
+	y[5] = (uint8_t)(x >> 16);
+	y[6] = (uint8_t)(x >> 8);
+	y[7] = (uint8_t)x;
+}
+
+/*
+	Returns 0 on success and -1 if the cipher block is not 128 bits,
+	64 bits block ciphers use the CTR64 mode instead.
+*/
+int CTR_init(CtrContext* ctr, const CipherDescriptor* cipher, const void* context, const uint8_t* counter)
+{
+	if (cipher->blockSize != CTR_BLOCK_SIZE)
+	{
+		return -1;
+	}
+
+	ctr->cipher = cipher;
+	ctr->context = context;
+	memcpy(ctr->counter, counter, CTR_BLOCK_SIZE);
+
+	return 0;
+}
+
+/*
+	Encrypt or decrypt length bytes located at the given byte offset
+	of the stream. Only reads the CtrContext, so any number of
+	threads can process different ranges of the same stream.
+*/
+void CTR_crypt(const CtrContext* ctr, uint64_t offset, const uint8_t* in, uint8_t* out, size_t length)
+{
+	uint8_t counters[CTR_BLOCK_SIZE * CHUNK_BLOCKS];
+	uint8_t keystream[CTR_BLOCK_SIZE * CHUNK_BLOCKS];
+	uint64_t index = offset / CTR_BLOCK_SIZE;
+	size_t skip = offset % CTR_BLOCK_SIZE;
+	size_t nrBlocks;
+	size_t bytes;
+	size_t i;
+
+	// counter of the first block, 128 bits addition of the block index
+	uint64_t high = LOAD_64(ctr->counter);
+	uint64_t low = LOAD_64(ctr->counter + 8);
+
+	low += index;
+	if (low < index)
+	{
+		high++;
+	}
+
+	while (length > 0)
+	{
+		nrBlocks = (skip + length + CTR_BLOCK_SIZE - 1) / CTR_BLOCK_SIZE;
+		if (nrBlocks > CHUNK_BLOCKS)
+		{
+			nrBlocks = CHUNK_BLOCKS;
+		}
+
+		for (i = 0; i < nrBlocks; i++)
+		{
+			STORE_64(counters + CTR_BLOCK_SIZE * i, high);
+			STORE_64(counters + CTR_BLOCK_SIZE * i + 8, low);
+
+			if (++low == 0)
+			{
+				high++;
+			}
+		}
+
+		ctr->cipher->encryptBlocks(ctr->context, counters, keystream, nrBlocks);
+
+		bytes = CTR_BLOCK_SIZE * nrBlocks - skip;
+		if (bytes > length)
+		{
+			bytes = length;
+		}
+
+		for (i = 0; i < bytes; i++)
+		{
+			out[i] = in[i] ^ keystream[skip + i];
+		}
+
+		in += bytes;
+		out += bytes;
+		length -= bytes;
+		skip = 0;
+	}
+}
+
+static void CTR_shard(void* argument, size_t index)
+{
+	CtrJob* job = (CtrJob*)argument;
+	size_t start = index == 0 ? 0 : job->head + index * job->shardSize;
+	size_t end = job->head + (index + 1) * job->shardSize;
+
+	if (end > job->length)
+	{
+		end = job->length;
+	}
+
+	CTR_crypt(job->ctr, job->offset + start, job->in + start, job->out + start, end - start);
+}
+
+/*
+	Same as CTR_crypt, but the buffer is split in shards that start
+	on block boundaries and are spread over the threads of the pool.
+*/
+void CTR_crypt_parallel(const CtrContext* ctr, ThreadPool* pool, uint64_t offset, const uint8_t* in, uint8_t* out, size_t length)
+{
+	CtrJob job;
+	size_t nrShards;
+	unsigned nrThreads = pool == NULL ? 1 : THREADPOOL_size(pool);
+
+	if (nrThreads == 1 || length < 2 * MIN_SHARD_SIZE)
+	{
+		CTR_crypt(ctr, offset, in, out, length);
+		return;
+	}
+
+	job.ctr = ctr;
+	job.offset = offset;
+	job.in = in;
+	job.out = out;
+	job.length = length;
+	job.head = (CTR_BLOCK_SIZE - offset % CTR_BLOCK_SIZE) % CTR_BLOCK_SIZE;
+
+	// whole blocks per shard
+	job.shardSize = length / (nrThreads * SHARDS_PER_THREAD);
+	job.shardSize = (job.shardSize + CTR_BLOCK_SIZE - 1) & ~(size_t)(CTR_BLOCK_SIZE - 1);
+	if (job.shardSize < MIN_SHARD_SIZE)
+	{
+		job.shardSize = MIN_SHARD_SIZE;
+	}
+
+	nrShards = (length - job.head + job.shardSize - 1) / job.shardSize;
+
+	THREADPOOL_run(pool, CTR_shard, &job, nrShards);
+}
+
+void CTR_main(void)
+{
+	const char* names[] = { "ARIA", "CAMELLIA", "NOEKEON", "SEED", "SIMON", "SPECK" };
+	const size_t length = 1000003;
+	const uint64_t offset = 12345;
+	uint64_t context[REGISTRY_MAX_CONTEXT_SIZE / sizeof(uint64_t)];
+	uint8_t key[16];
+	uint8_t counter[CTR_BLOCK_SIZE];
+	uint8_t* text = (uint8_t*)malloc(length);
+	uint8_t* cipherText = (uint8_t*)malloc(length);
+	uint8_t* parallelText = (uint8_t*)malloc(length);
+	uint8_t* decryptedText = (uint8_t*)malloc(length);
+	ThreadPool* pool = THREADPOOL_create(4);
+	CtrContext ctr;
+	size_t i;
+	int ok;
+
+	printf("\nCTR \n\n");
+
+	if (text == NULL || cipherText == NULL || parallelText == NULL || decryptedText == NULL || pool == NULL)
+	{
+		printf("out of memory\n");
+		free(text);
+		free(cipherText);
+		free(parallelText);
+		free(decryptedText);
+		THREADPOOL_destroy(pool);
+		return;
+	}
+
+	for (i = 0; i < sizeof(key); i++)
+	{
+		key[i] = (uint8_t)i;
+	}
+
+	// counter close to the 64 bits boundary to exercise the carry
+	for (i = 0; i < CTR_BLOCK_SIZE; i++)
+	{
+		counter[i] = i < 8 ? (uint8_t)i : 0xff;
+	}
+
+	for (i = 0; i < length; i++)
+	{
+		text[i] = (uint8_t)(i * 31 + 7);
+	}
+
+	for (i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+	{
+		const CipherDescriptor* cipher = REGISTRY_find(names[i]);
+
+		REGISTRY_init(cipher, context, key, 128);
+		CTR_init(&ctr, cipher, context, counter);
+
+		// single thread reference, then all threads of the pool
+		CTR_crypt(&ctr, 0, text, cipherText, length);
+		CTR_crypt_parallel(&ctr, pool, 0, text, parallelText, length);
+		ok = memcmp(cipherText, parallelText, length) == 0;
+
+		// decrypt starting in the middle of a block
+		CTR_crypt_parallel(&ctr, pool, offset, cipherText + offset, decryptedText, length - offset);
+		ok &= memcmp(text + offset, decryptedText, length - offset) == 0;
+
+		printf("%-8s %u bytes, %u threads: %s\n", names[i], (unsigned)length, THREADPOOL_size(pool), ok ? "ok" : "FAILED");
+	}
+
+	free(text);
+	free(cipherText);
+	free(parallelText);
+	free(decryptedText);
+	THREADPOOL_destroy(pool);
+}
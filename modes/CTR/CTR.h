@@ -0,0 +1,40 @@
+/* CTR.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Counter mode of operation for the 128 bits block ciphers of the
+ * registry (ARIA, CAMELLIA, NOEKEON, SEED, SIMON and SPECK).
+ *
+ * The counter block is a 128 bits big-endian integer incremented
+ * once per block, starting from the initial counter given to
+ * CTR_init. Encryption and decryption are the same operation and
+ * can start at any byte offset of the stream, so a large buffer
+ * can be split in shards that are processed independently.
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../../registry/REGISTRY.h"
+#include "../../threads/THREADPOOL.h"
+
+#define CTR_BLOCK_SIZE 16
+
+typedef struct
+{
+	const CipherDescriptor* cipher;
+	// expanded key, owned by the caller and shared by all threads
+	const void* context;
+	uint8_t counter[CTR_BLOCK_SIZE];
+} CtrContext;
+
+int CTR_init(CtrContext* ctr, const CipherDescriptor* cipher, const void* context, const uint8_t* counter);
+void CTR_crypt(const CtrContext* ctr, uint64_t offset, const uint8_t* in, uint8_t* out, size_t length);
+void CTR_crypt_parallel(const CtrContext* ctr, ThreadPool* pool, uint64_t offset, const uint8_t* in, uint8_t* out, size_t length);
+
+void CTR_main(void);
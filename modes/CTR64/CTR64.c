@@ -0,0 +1,338 @@
+/* CTR64.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Implementation of the counter (CTR) mode of operation for the
+ * 64 bits block ciphers, rekeying the stream before the per-key
+ * block budget is exhausted.
+ *
+ * This code follows a specification:
+ *		- https://nvlpubs.nist.gov/nistpubs/Legacy/SP/nistspecialpublication800-38a.pdf
+ *
+ * and uses other references:
+ *		- https://sweet32.info/
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "CTR64.h"
+
+#define MAX_KEY_SIZE 32
+
+static uint64_t LOAD_64(const uint8_t* x)
+{
+	return (uint64_t)x[0] << 56 | (uint64_t)x[1] << 48
+		| (uint64_t)x[2] << 40 | (uint64_t)x[3] << 32
+		| (uint64_t)x[4] << 24 | (uint64_t)x[5] << 16
+		| (uint64_t)x[6] << 8 | x[7];
+}
+
+static void STORE_64(uint8_t* y, uint64_t x)
+{
+	y[0] = (uint8_t)(x >> 56);
+	y[1] = (uint8_t)(x >> 48);
+	y[2] = (uint8_t)(x >> 40);
+	y[3] = (uint8_t)(x >> 32);
+	y[4] = (uint8_t)(x >> 24);
+	y[5] = (uint8_t)(x >> 16);
+	y[6] = (uint8_t)(x >> 8);
+	y[7] = (uint8_t)x;
+}
+
+// memset that the compiler cannot drop because the memory is freed afterwards
+static void WIPE(void* x, size_t n)
+{
+	volatile uint8_t* p = (volatile uint8_t*)x;
+
+	while (n--)
+	{
+		*p++ = 0;
+	}
+}
+
+/*
+	Key of an epoch: E_master(i || epoch) for i = 0, 1, ... truncated
+	to the key length, with i in the top 3 bits of the block and the
+	epoch in the 61 bits below. The position counts bytes in 64 bits,
+	so an epoch is always below 2^61 and no two (i, epoch) pairs share
+	a block.
+*/
+static void deriveKey(Ctr64Context* ctr, uint64_t epoch, void* context)
+{
+	uint8_t blocks[MAX_KEY_SIZE];
+	uint8_t key[MAX_KEY_SIZE];
+	size_t keySize = (ctr->keyLen + 7) / 8;
+	size_t nrBlocks = (keySize + CTR64_BLOCK_SIZE - 1) / CTR64_BLOCK_SIZE;
+	size_t i;
+
+	for (i = 0; i < nrBlocks; i++)
+	{
+		STORE_64(blocks + CTR64_BLOCK_SIZE * i, (uint64_t)i << 61 | epoch);
+	}
+
+	ctr->cipher->encryptBlocks(ctr->master, blocks, key, nrBlocks);
+	ctr->cipher->init(context, key, ctr->keyLen);
+
+	WIPE(key, sizeof(key));
+}
+
+/*
+	Make the given epoch current. Moving to the following epoch only
+	swaps in the key derived in advance by prepareNextEpoch, any other
+	move derives the key of the epoch now.
+*/
+static void installEpoch(Ctr64Context* ctr, uint64_t epoch)
+{
+	void* temp;
+
+	if (ctr->nextReady && epoch == ctr->epoch + 1)
+	{
+		temp = ctr->current;
+		ctr->current = ctr->next;
+		ctr->next = temp;
+	}
+	else
+	{
+		deriveKey(ctr, epoch, ctr->current);
+	}
+
+	ctr->epoch = epoch;
+	ctr->nextReady = 0;
+	ctr->nrRekeys++;
+}
+
+/*
+	Derive the key of the following epoch once the stream is halfway
+	through the current one, so the refill that crosses the boundary
+	only swaps keys instead of paying for a derivation and an init.
+*/
+static void prepareNextEpoch(Ctr64Context* ctr, uint64_t block)
+{
+	if (!ctr->nextReady && block >= ctr->blockLimit / 2)
+	{
+		deriveKey(ctr, ctr->epoch + 1, ctr->next);
+		ctr->nextReady = 1;
+	}
+}
+
+/*
+	Generate the keystream of up to CTR64_CHUNK_BLOCKS blocks starting
+	at the block of the current position, without crossing an epoch.
+*/
+static void refill(Ctr64Context* ctr)
+{
+	uint8_t counters[CTR64_BLOCK_SIZE * CTR64_CHUNK_BLOCKS];
+	uint64_t index = ctr->position / CTR64_BLOCK_SIZE;
+	uint64_t epoch = index / ctr->blockLimit;
+	uint64_t block = index % ctr->blockLimit;
+	size_t nrBlocks = CTR64_CHUNK_BLOCKS;
+	size_t i;
+
+	if (ctr->blockLimit - block < nrBlocks)
+	{
+		nrBlocks = (size_t)(ctr->blockLimit - block);
+	}
+
+	if (epoch != ctr->epoch)
+	{
+		installEpoch(ctr, epoch);
+	}
+
+	prepareNextEpoch(ctr, block);
+
+	for (i = 0; i < nrBlocks; i++)
+	{
+		STORE_64(counters + CTR64_BLOCK_SIZE * i, ctr->counter + block + i);
+	}
+
+	ctr->cipher->encryptBlocks(ctr->current, counters, ctr->keystream, nrBlocks);
+
+	ctr->bufferStart = index * CTR64_BLOCK_SIZE;
+	ctr->bufferEnd = ctr->bufferStart + CTR64_BLOCK_SIZE * nrBlocks;
+}
+
+/*
+	Returns 0 on success and -1 if the cipher block is not 64 bits,
+	the key length is not supported, blockLimit is above
+	CTR64_MAX_BLOCK_LIMIT (2^28) or the contexts cannot be
+	allocated. A blockLimit of zero selects CTR64_DEFAULT_BLOCK_LIMIT.
+*/
+int CTR64_init(Ctr64Context* ctr, const CipherDescriptor* cipher, const uint8_t* key, uint16_t keyLen, const uint8_t* counter, uint64_t blockLimit)
+{
+	uint8_t* contexts;
+
+	if (cipher->blockSize != CTR64_BLOCK_SIZE
+		|| !REGISTRY_supportsKeyLength(cipher, keyLen)
+		|| blockLimit > CTR64_MAX_BLOCK_LIMIT)
+	{
+		return -1;
+	}
+
+	// master, current and next contexts in one allocation
+	contexts = (uint8_t*)malloc(3 * cipher->contextSize);
+	if (contexts == NULL)
+	{
+		return -1;
+	}
+
+	ctr->cipher = cipher;
+	ctr->keyLen = keyLen;
+	ctr->blockLimit = blockLimit == 0 ? CTR64_DEFAULT_BLOCK_LIMIT : blockLimit;
+	ctr->counter = LOAD_64(counter);
+	ctr->position = 0;
+	ctr->master = contexts;
+	ctr->current = contexts + cipher->contextSize;
+	ctr->next = contexts + 2 * cipher->contextSize;
+	ctr->bufferStart = 0;
+	ctr->bufferEnd = 0;
+
+	cipher->init(ctr->master, key, keyLen);
+
+	ctr->nextReady = 0;
+	installEpoch(ctr, 0);
+	ctr->nrRekeys = 0;
+
+	return 0;
+}
+
+void CTR64_free(Ctr64Context* ctr)
+{
+	// master is never swapped, it is the start of the allocation
+	void* contexts = ctr->master;
+
+	WIPE(contexts, 3 * ctr->cipher->contextSize);
+	WIPE(ctr->keystream, sizeof(ctr->keystream));
+	free(contexts);
+
+	ctr->master = NULL;
+	ctr->current = NULL;
+	ctr->next = NULL;
+}
+
+// move to any byte offset of the stream, for decryption or random access
+void CTR64_seek(Ctr64Context* ctr, uint64_t offset)
+{
+	ctr->position = offset;
+}
+
+/*
+	Encrypt or decrypt the next length bytes of the stream, switching
+	to a fresh key every blockLimit blocks.
+*/
+void CTR64_crypt(Ctr64Context* ctr, const uint8_t* in, uint8_t* out, size_t length)
+{
+	size_t skip;
+	size_t bytes;
+	size_t i;
+
+	while (length > 0)
+	{
+		if (ctr->position < ctr->bufferStart || ctr->position >= ctr->bufferEnd)
+		{
+			refill(ctr);
+		}
+
+		skip = (size_t)(ctr->position - ctr->bufferStart);
+		bytes = (size_t)(ctr->bufferEnd - ctr->position);
+		if (bytes > length)
+		{
+			bytes = length;
+		}
+
+		for (i = 0; i < bytes; i++)
+		{
+			out[i] = in[i] ^ ctr->keystream[skip + i];
+		}
+
+		in += bytes;
+		out += bytes;
+		length -= bytes;
+		ctr->position += bytes;
+	}
+}
+
+void CTR64_main(void)
+{
+	const char* names[] = { "GOST", "HIGHT", "IDEA", "PRESENT" };
+	const size_t length = 100003;
+	const uint64_t offset = 54321;
+	// small budget so the demo crosses several epochs
+	const uint64_t blockLimit = 1000;
+	uint8_t key[32];
+	uint8_t counter[CTR64_BLOCK_SIZE];
+	uint8_t* text = (uint8_t*)malloc(length);
+	uint8_t* cipherText = (uint8_t*)malloc(length);
+	uint8_t* decryptedText = (uint8_t*)malloc(length);
+	Ctr64Context ctr;
+	size_t i;
+	size_t done;
+	size_t piece;
+	int ok;
+
+	printf("\nCTR64 \n\n");
+
+	if (text == NULL || cipherText == NULL || decryptedText == NULL)
+	{
+		printf("out of memory\n");
+		free(text);
+		free(cipherText);
+		free(decryptedText);
+		return;
+	}
+
+	for (i = 0; i < sizeof(key); i++)
+	{
+		key[i] = (uint8_t)i;
+	}
+
+	for (i = 0; i < CTR64_BLOCK_SIZE; i++)
+	{
+		counter[i] = (uint8_t)(0xf0 + i);
+	}
+
+	for (i = 0; i < length; i++)
+	{
+		text[i] = (uint8_t)(i * 31 + 7);
+	}
+
+	for (i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+	{
+		const CipherDescriptor* cipher = REGISTRY_find(names[i]);
+
+		// encrypt the stream in pieces of irregular size
+		CTR64_init(&ctr, cipher, key, cipher->keyLengths[0], counter, blockLimit);
+		for (done = 0, piece = 1; done < length; done += piece, piece = piece * 3 + 1)
+		{
+			if (piece > length - done)
+			{
+				piece = length - done;
+			}
+
+			CTR64_crypt(&ctr, text + done, cipherText + done, piece);
+		}
+
+		printf("%-8s %u bytes, %u blocks per key, %u rekeys: ",
+			names[i], (unsigned)length, (unsigned)blockLimit, (unsigned)ctr.nrRekeys);
+		CTR64_free(&ctr);
+
+		// decrypt from the middle of the stream with a new context
+		CTR64_init(&ctr, cipher, key, cipher->keyLengths[0], counter, blockLimit);
+		CTR64_seek(&ctr, offset);
+		CTR64_crypt(&ctr, cipherText + offset, decryptedText, length - offset);
+		CTR64_free(&ctr);
+
+		ok = memcmp(text + offset, decryptedText, length - offset) == 0;
+		printf("%s\n", ok ? "ok" : "FAILED");
+	}
+
+	// a budget beyond CTR64_MAX_BLOCK_LIMIT is refused
+	ok = CTR64_init(&ctr, REGISTRY_find("IDEA"), key, 128, counter, CTR64_MAX_BLOCK_LIMIT + 1) == -1;
+	printf("block limit above 2^28 refused: %s\n", ok ? "ok" : "FAILED");
+
+	free(text);
+	free(cipherText);
+	free(decryptedText);
+}
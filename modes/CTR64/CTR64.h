@@ -0,0 +1,69 @@
+/* CTR64.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Counter mode of operation for the 64 bits block ciphers of the
+ * registry (GOST, HIGHT, IDEA and PRESENT) with automatic rekeying.
+ *
+ * A 64 bits block cipher leaks information once about 2^32 blocks
+ * are encrypted under the same key (birthday bound), so the stream
+ * is divided in epochs of at most blockLimit blocks and every epoch
+ * uses its own key. Epoch keys are derived from the master key by
+ * encrypting (chunk index || epoch) blocks under it, so the master
+ * key never encrypts data and any position of the stream can be
+ * reached again with CTR64_seek.
+ *
+ * Within an epoch the counter block is the 64 bits big-endian
+ * initial counter plus the index of the block in the epoch.
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../../registry/REGISTRY.h"
+
+#define CTR64_BLOCK_SIZE 8
+#define CTR64_CHUNK_BLOCKS 64
+
+// 2^23 blocks (64 MiB) per key keeps the distinguishing advantage below 2^-19
+#define CTR64_DEFAULT_BLOCK_LIMIT ((uint64_t)1 << 23)
+// 2^28 blocks (2 GiB) per key, the advantage reaches 2^-9, far from 2^32
+// which would be the birthday bound itself
+#define CTR64_MAX_BLOCK_LIMIT ((uint64_t)1 << 28)
+
+typedef struct
+{
+	const CipherDescriptor* cipher;
+	uint16_t keyLen;
+	uint64_t blockLimit;
+	uint64_t counter;
+
+	// stream position in bytes
+	uint64_t position;
+
+	// expanded master key and keys of the current and next epochs
+	void* master;
+	void* current;
+	void* next;
+	uint64_t epoch;
+	int nextReady;
+	uint64_t nrRekeys;
+
+	// keystream already generated for positions [bufferStart, bufferEnd)
+	uint64_t bufferStart;
+	uint64_t bufferEnd;
+	uint8_t keystream[CTR64_BLOCK_SIZE * CTR64_CHUNK_BLOCKS];
+} Ctr64Context;
+
+int CTR64_init(Ctr64Context* ctr, const CipherDescriptor* cipher, const uint8_t* key, uint16_t keyLen, const uint8_t* counter, uint64_t blockLimit);
+void CTR64_free(Ctr64Context* ctr);
+
+void CTR64_seek(Ctr64Context* ctr, uint64_t offset);
+void CTR64_crypt(Ctr64Context* ctr, const uint8_t* in, uint8_t* out, size_t length);
+
+void CTR64_main(void);
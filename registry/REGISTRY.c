@@ -0,0 +1,1076 @@
+/* REGISTRY.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Descriptors for all block ciphers in algorithms/ and the
+ * adapters that translate the uniform byte interface of the
+ * registry to the native word interface of each cipher.
+ *
+ */
+
+#include <string.h>
+
+#include "REGISTRY.h"
+#include "../algorithms/ARIA/ARIA.h"
+#include "../algorithms/CAMELLIA/CAMELLIA.h"
+#include "../algorithms/GOST/GOST.h"
+#include "../algorithms/HIGHT/HIGHT.h"
+#include "../algorithms/IDEA/IDEA.h"
+#include "../algorithms/NOEKEON/NOEKEON.h"
+#include "../algorithms/PRESENT/PRESENT.h"
+#include "../algorithms/SEED/SEED.h"
+#include "../algorithms/SIMON/SIMON.h"
+#include "../algorithms/SPECK/SPECK.h"
+
+// alignment of a type without relying on C11 _Alignof
+#define ALIGNMENT_OF(type) offsetof(struct { char c; type t; }, t)
+
+// blocks converted to native words per call of the bulk functions
+#define CHUNK_BLOCKS 64
+
+// PRESENT needs more than 128 blocks per call for its AVX2 slices of 256
+#define PRESENT_CHUNK_BLOCKS 256
+
+/*
+	Big-endian load and store of 16, 32 and 64 bits words
+*/
+static void LOAD_16(uint16_t* y, const uint8_t* x, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++, x += 2)
+	{
+		y[i] = (uint16_t)(x[0] << 8 | x[1]);
+	}
+}
+
+static void STORE_16(uint8_t* y, const uint16_t* x, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++, y += 2)
+	{
+		y[0] = (uint8_t)(x[i] >> 8);
+		y[1] = (uint8_t)x[i];
+	}
+}
+
+static void LOAD_32(uint32_t* y, const uint8_t* x, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++, x += 4)
+	{
+		y[i] = (uint32_t)x[0] << 24
+			| (uint32_t)x[1] << 16
+			| (uint32_t)x[2] << 8
+			| x[3];
+	}
+}
+
+static void STORE_32(uint8_t* y, const uint32_t* x, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++, y += 4)
+	{
+		y[0] = (uint8_t)(x[i] >> 24);
+		y[1] = (uint8_t)(x[i] >> 16);
+		y[2] = (uint8_t)(x[i] >> 8);
+		y[3] = (uint8_t)x[i];
+	}
+}
+
+static void LOAD_64(uint64_t* y, const uint8_t* x, size_t n)
+{
+	size_t i;
+	uint32_t words[2];
+
+	for (i = 0; i < n; i++, x += 8)
+	{
+		LOAD_32(words, x, 2);
+		y[i] = (uint64_t)words[0] << 32 | words[1];
+	}
+}
+
+static void STORE_64(uint8_t* y, const uint64_t* x, size_t n)
+{
+	size_t i;
+	uint32_t words[2];
+
+	for (i = 0; i < n; i++, y += 8)
+	{
+		words[0] = (uint32_t)(x[i] >> 32);
+		words[1] = (uint32_t)x[i];
+		STORE_32(y, words, 2);
+	}
+}
+
+/*
+	ARIA
+*/
+static void ARIA_registryInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint32_t words[8];
+
+	LOAD_32(words, key, keyLen / 32);
+	ARIA_init((AriaContext*)context, words, keyLen);
+}
+
+static void ARIA_registryEncrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint32_t words[4];
+
+	LOAD_32(words, block, 4);
+	ARIA_encrypt((AriaContext*)context, words, words);
+	STORE_32(out, words, 4);
+}
+
+static void ARIA_registryDecrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint32_t words[4];
+
+	LOAD_32(words, block, 4);
+	ARIA_decrypt((AriaContext*)context, words, words);
+	STORE_32(out, words, 4);
+}
+
+static void ARIA_registryEncryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint32_t words[4 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 16 * n, out += 16 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_32(words, blocks, 4 * n);
+		ARIA_encrypt_blocks((AriaContext*)context, words, words, n);
+		STORE_32(out, words, 4 * n);
+	}
+}
+
+static void ARIA_registryDecryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint32_t words[4 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 16 * n, out += 16 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_32(words, blocks, 4 * n);
+		ARIA_decrypt_blocks((AriaContext*)context, words, words, n);
+		STORE_32(out, words, 4 * n);
+	}
+}
+
+/*
+	CAMELLIA
+*/
+static void CAMELLIA_registryInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint64_t words[4];
+
+	LOAD_64(words, key, keyLen / 64);
+	CAMELLIA_init((CamelliaContext*)context, words, keyLen);
+}
+
+static void CAMELLIA_registryEncrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t words[2];
+
+	LOAD_64(words, block, 2);
+	CAMELLIA_encrypt((const CamelliaContext*)context, words, words);
+	STORE_64(out, words, 2);
+}
+
+static void CAMELLIA_registryDecrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t words[2];
+
+	LOAD_64(words, block, 2);
+	CAMELLIA_decrypt((const CamelliaContext*)context, words, words);
+	STORE_64(out, words, 2);
+}
+
+static void CAMELLIA_registryEncryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint64_t words[2 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 16 * n, out += 16 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_64(words, blocks, 2 * n);
+		CAMELLIA_encrypt_blocks((const CamelliaContext*)context, words, words, n);
+		STORE_64(out, words, 2 * n);
+	}
+}
+
+static void CAMELLIA_registryDecryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint64_t words[2 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 16 * n, out += 16 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_64(words, blocks, 2 * n);
+		CAMELLIA_decrypt_blocks((const CamelliaContext*)context, words, words, n);
+		STORE_64(out, words, 2 * n);
+	}
+}
+
+/*
+	GOST
+*/
+static void GOST_registryInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint32_t words[8];
+
+	LOAD_32(words, key, 8);
+	GOST_init((GostContext*)context, words);
+}
+
+static void GOST_registryEncrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t word;
+
+	LOAD_64(&word, block, 1);
+	word = GOST_encrypt((GostContext*)context, word);
+	STORE_64(out, &word, 1);
+}
+
+static void GOST_registryDecrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t word;
+
+	LOAD_64(&word, block, 1);
+	word = GOST_decrypt((GostContext*)context, word);
+	STORE_64(out, &word, 1);
+}
+
+static void GOST_registryEncryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint64_t words[CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 8 * n, out += 8 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_64(words, blocks, n);
+		GOST_encrypt_blocks((GostContext*)context, words, words, n);
+		STORE_64(out, words, n);
+	}
+}
+
+static void GOST_registryDecryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint64_t words[CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 8 * n, out += 8 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_64(words, blocks, n);
+		GOST_decrypt_blocks((GostContext*)context, words, words, n);
+		STORE_64(out, words, n);
+	}
+}
+
+/*
+	HIGHT works on bytes, so no conversion is required
+*/
+static void HIGHT_registryInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint8_t bytes[16];
+
+	memcpy(bytes, key, sizeof(bytes));
+	HIGHT_init((HightContext*)context, bytes);
+}
+
+static void HIGHT_registryEncrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	HIGHT_encrypt((HightContext*)context, (uint8_t*)block, out);
+}
+
+static void HIGHT_registryDecrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	HIGHT_decrypt((HightContext*)context, (uint8_t*)block, out);
+}
+
+static void HIGHT_registryEncryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	HIGHT_encrypt_blocks((HightContext*)context, blocks, out, nrBlocks);
+}
+
+static void HIGHT_registryDecryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	HIGHT_decrypt_blocks((HightContext*)context, blocks, out, nrBlocks);
+}
+
+/*
+	IDEA
+*/
+static void IDEA_registryInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint16_t words[8];
+
+	LOAD_16(words, key, 8);
+	IDEA_init((IdeaContext*)context, words);
+}
+
+static void IDEA_registryEncrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint16_t words[4];
+
+	LOAD_16(words, block, 4);
+	IDEA_encrypt((IdeaContext*)context, words, words);
+	STORE_16(out, words, 4);
+}
+
+static void IDEA_registryDecrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint16_t words[4];
+
+	LOAD_16(words, block, 4);
+	IDEA_decrypt((IdeaContext*)context, words, words);
+	STORE_16(out, words, 4);
+}
+
+static void IDEA_registryEncryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint16_t words[4 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 8 * n, out += 8 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_16(words, blocks, 4 * n);
+		IDEA_encrypt_blocks((IdeaContext*)context, words, words, n);
+		STORE_16(out, words, 4 * n);
+	}
+}
+
+static void IDEA_registryDecryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint16_t words[4 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 8 * n, out += 8 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_16(words, blocks, 4 * n);
+		IDEA_decrypt_blocks((IdeaContext*)context, words, words, n);
+		STORE_16(out, words, 4 * n);
+	}
+}
+
+/*
+	NOEKEON
+*/
+static void NOEKEON_registryInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint32_t words[4];
+
+	LOAD_32(words, key, 4);
+	NOEKEON_init((NoekeonContext*)context, words);
+}
+
+static void NOEKEON_registryEncrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint32_t words[4];
+
+	LOAD_32(words, block, 4);
+	NOEKEON_encrypt((NoekeonContext*)context, words, words);
+	STORE_32(out, words, 4);
+}
+
+static void NOEKEON_registryDecrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint32_t words[4];
+
+	LOAD_32(words, block, 4);
+	NOEKEON_decrypt((NoekeonContext*)context, words, words);
+	STORE_32(out, words, 4);
+}
+
+static void NOEKEON_registryEncryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint32_t words[4 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 16 * n, out += 16 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_32(words, blocks, 4 * n);
+		NOEKEON_encrypt_blocks((NoekeonContext*)context, words, words, n);
+		STORE_32(out, words, 4 * n);
+	}
+}
+
+static void NOEKEON_registryDecryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint32_t words[4 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 16 * n, out += 16 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_32(words, blocks, 4 * n);
+		NOEKEON_decrypt_blocks((NoekeonContext*)context, words, words, n);
+		STORE_32(out, words, 4 * n);
+	}
+}
+
+/*
+	PRESENT
+*/
+static void PRESENT_registryInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint16_t words[8];
+
+	LOAD_16(words, key, keyLen / 16);
+	PRESENT_init((PresentContext*)context, words, keyLen);
+}
+
+static void PRESENT_registryEncrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint16_t words[4];
+
+	LOAD_16(words, block, 4);
+	PRESENT_encrypt((PresentContext*)context, words, words);
+	STORE_16(out, words, 4);
+}
+
+static void PRESENT_registryDecrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint16_t words[4];
+
+	LOAD_16(words, block, 4);
+	PRESENT_decrypt((PresentContext*)context, words, words);
+	STORE_16(out, words, 4);
+}
+
+static void PRESENT_registryEncryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint16_t words[4 * PRESENT_CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 8 * n, out += 8 * n)
+	{
+		n = nrBlocks < PRESENT_CHUNK_BLOCKS ? nrBlocks : PRESENT_CHUNK_BLOCKS;
+		LOAD_16(words, blocks, 4 * n);
+		PRESENT_encrypt_blocks((PresentContext*)context, words, words, n);
+		STORE_16(out, words, 4 * n);
+	}
+}
+
+static void PRESENT_registryDecryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint16_t words[4 * PRESENT_CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 8 * n, out += 8 * n)
+	{
+		n = nrBlocks < PRESENT_CHUNK_BLOCKS ? nrBlocks : PRESENT_CHUNK_BLOCKS;
+		LOAD_16(words, blocks, 4 * n);
+		PRESENT_decrypt_blocks((PresentContext*)context, words, words, n);
+		STORE_16(out, words, 4 * n);
+	}
+}
+
+/*
+	SEED
+*/
+static void SEED_registryInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint32_t words[4];
+
+	LOAD_32(words, key, 4);
+	SEED_init((SeedContext*)context, words);
+}
+
+static void SEED_registryEncrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint32_t words[4];
+
+	LOAD_32(words, block, 4);
+	SEED_encrypt((SeedContext*)context, words, words);
+	STORE_32(out, words, 4);
+}
+
+static void SEED_registryDecrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint32_t words[4];
+
+	LOAD_32(words, block, 4);
+	SEED_decrypt((SeedContext*)context, words, words);
+	STORE_32(out, words, 4);
+}
+
+static void SEED_registryEncryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint32_t words[4 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 16 * n, out += 16 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_32(words, blocks, 4 * n);
+		SEED_encrypt_blocks((SeedContext*)context, words, words, n);
+		STORE_32(out, words, 4 * n);
+	}
+}
+
+static void SEED_registryDecryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint32_t words[4 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 16 * n, out += 16 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_32(words, blocks, 4 * n);
+		SEED_decrypt_blocks((SeedContext*)context, words, words, n);
+		STORE_32(out, words, 4 * n);
+	}
+}
+
+/*
+	SIMON
+*/
+static void SIMON_registryInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint64_t words[4];
+
+	LOAD_64(words, key, keyLen / 64);
+	SIMON_init((SimonContext*)context, words, keyLen);
+}
+
+static void SIMON_registryEncrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t words[2];
+
+	LOAD_64(words, block, 2);
+	SIMON_encrypt((SimonContext*)context, words, words);
+	STORE_64(out, words, 2);
+}
+
+static void SIMON_registryDecrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t words[2];
+
+	LOAD_64(words, block, 2);
+	SIMON_decrypt((SimonContext*)context, words, words);
+	STORE_64(out, words, 2);
+}
+
+static void SIMON_registryEncryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint64_t words[2 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 16 * n, out += 16 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_64(words, blocks, 2 * n);
+		SIMON_encrypt_blocks((SimonContext*)context, words, words, n);
+		STORE_64(out, words, 2 * n);
+	}
+}
+
+static void SIMON_registryDecryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint64_t words[2 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 16 * n, out += 16 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_64(words, blocks, 2 * n);
+		SIMON_decrypt_blocks((SimonContext*)context, words, words, n);
+		STORE_64(out, words, 2 * n);
+	}
+}
+
+/*
+	SIMON-COMPACT, the round keys are generated during the rounds. The
+	bulk functions expand the key once per call, several blocks reuse
+	every subkey, so they run the kernels of SIMON on the expansion.
+*/
+static void SIMON_compact_registryInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint64_t words[4];
+
+	LOAD_64(words, key, keyLen / 64);
+	SIMON_compact_init((SimonCompactContext*)context, words, keyLen);
+}
+
+static void SIMON_compact_registryEncrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t words[2];
+
+	LOAD_64(words, block, 2);
+	SIMON_compact_encrypt((SimonCompactContext*)context, words, words);
+	STORE_64(out, words, 2);
+}
+
+static void SIMON_compact_registryDecrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t words[2];
+
+	LOAD_64(words, block, 2);
+	SIMON_compact_decrypt((SimonCompactContext*)context, words, words);
+	STORE_64(out, words, 2);
+}
+
+static void SIMON_compact_registryEncryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	SimonContext expanded;
+
+	if (nrBlocks == 1)
+	{
+		SIMON_compact_registryEncrypt(context, blocks, out);
+		return;
+	}
+
+	SIMON_compact_expand((SimonCompactContext*)context, &expanded);
+	SIMON_registryEncryptBlocks(&expanded, blocks, out, nrBlocks);
+}
+
+static void SIMON_compact_registryDecryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	SimonContext expanded;
+
+	if (nrBlocks == 1)
+	{
+		SIMON_compact_registryDecrypt(context, blocks, out);
+		return;
+	}
+
+	SIMON_compact_expand((SimonCompactContext*)context, &expanded);
+	SIMON_registryDecryptBlocks(&expanded, blocks, out, nrBlocks);
+}
+
+/*
+	SPECK
+*/
+static void SPECK_registryInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint64_t words[4];
+
+	LOAD_64(words, key, keyLen / 64);
+	SPECK_init((SpeckContext*)context, words, keyLen);
+}
+
+static void SPECK_registryEncrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t words[2];
+
+	LOAD_64(words, block, 2);
+	SPECK_encrypt((SpeckContext*)context, words, words);
+	STORE_64(out, words, 2);
+}
+
+static void SPECK_registryDecrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t words[2];
+
+	LOAD_64(words, block, 2);
+	SPECK_decrypt((SpeckContext*)context, words, words);
+	STORE_64(out, words, 2);
+}
+
+static void SPECK_registryEncryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint64_t words[2 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 16 * n, out += 16 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_64(words, blocks, 2 * n);
+		SPECK_encrypt_blocks((SpeckContext*)context, words, words, n);
+		STORE_64(out, words, 2 * n);
+	}
+}
+
+static void SPECK_registryDecryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint64_t words[2 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 16 * n, out += 16 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_64(words, blocks, 2 * n);
+		SPECK_decrypt_blocks((SpeckContext*)context, words, words, n);
+		STORE_64(out, words, 2 * n);
+	}
+}
+
+/*
+	SPECK-COMPACT, the round keys are generated during the rounds. The
+	bulk functions expand the key once per call, several blocks reuse
+	every subkey, so they run the kernels of SPECK on the expansion.
+*/
+static void SPECK_compact_registryInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint64_t words[4];
+
+	LOAD_64(words, key, keyLen / 64);
+	SPECK_compact_init((SpeckCompactContext*)context, words, keyLen);
+}
+
+static void SPECK_compact_registryEncrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t words[2];
+
+	LOAD_64(words, block, 2);
+	SPECK_compact_encrypt((SpeckCompactContext*)context, words, words);
+	STORE_64(out, words, 2);
+}
+
+static void SPECK_compact_registryDecrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t words[2];
+
+	LOAD_64(words, block, 2);
+	SPECK_compact_decrypt((SpeckCompactContext*)context, words, words);
+	STORE_64(out, words, 2);
+}
+
+static void SPECK_compact_registryEncryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	SpeckContext expanded;
+
+	if (nrBlocks == 1)
+	{
+		SPECK_compact_registryEncrypt(context, blocks, out);
+		return;
+	}
+
+	SPECK_compact_expand((SpeckCompactContext*)context, &expanded);
+	SPECK_registryEncryptBlocks(&expanded, blocks, out, nrBlocks);
+}
+
+static void SPECK_compact_registryDecryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	SpeckContext expanded;
+
+	if (nrBlocks == 1)
+	{
+		SPECK_compact_registryDecrypt(context, blocks, out);
+		return;
+	}
+
+	SPECK_compact_expand((SpeckCompactContext*)context, &expanded);
+	SPECK_registryDecryptBlocks(&expanded, blocks, out, nrBlocks);
+}
+
+/*
+	ARIA-ENC and IDEA-ENC, the contexts keep the encryption keys only.
+	Decryption derives the decryption keys at every call.
+*/
+static void ARIA_enc_registryInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint32_t words[8];
+
+	LOAD_32(words, key, keyLen / 32);
+	ARIA_enc_init((AriaEncContext*)context, words, keyLen);
+}
+
+static void ARIA_enc_registryEncrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint32_t words[4];
+
+	LOAD_32(words, block, 4);
+	ARIA_enc_encrypt((AriaEncContext*)context, words, words);
+	STORE_32(out, words, 4);
+}
+
+static void ARIA_enc_registryDecrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint32_t words[4];
+
+	LOAD_32(words, block, 4);
+	ARIA_enc_decrypt((AriaEncContext*)context, words, words);
+	STORE_32(out, words, 4);
+}
+
+static void ARIA_enc_registryEncryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint32_t words[4 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 16 * n, out += 16 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_32(words, blocks, 4 * n);
+		ARIA_enc_encrypt_blocks((AriaEncContext*)context, words, words, n);
+		STORE_32(out, words, 4 * n);
+	}
+}
+
+static void ARIA_enc_registryDecryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint32_t words[4 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 16 * n, out += 16 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_32(words, blocks, 4 * n);
+		ARIA_enc_decrypt_blocks((AriaEncContext*)context, words, words, n);
+		STORE_32(out, words, 4 * n);
+	}
+}
+
+static void IDEA_enc_registryInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint16_t words[8];
+
+	LOAD_16(words, key, 8);
+	IDEA_enc_init((IdeaEncContext*)context, words);
+}
+
+static void IDEA_enc_registryEncrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint16_t words[4];
+
+	LOAD_16(words, block, 4);
+	IDEA_enc_encrypt((IdeaEncContext*)context, words, words);
+	STORE_16(out, words, 4);
+}
+
+static void IDEA_enc_registryDecrypt(const void* context, const uint8_t* block, uint8_t* out)
+{
+	uint16_t words[4];
+
+	LOAD_16(words, block, 4);
+	IDEA_enc_decrypt((IdeaEncContext*)context, words, words);
+	STORE_16(out, words, 4);
+}
+
+static void IDEA_enc_registryEncryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint16_t words[4 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 8 * n, out += 8 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_16(words, blocks, 4 * n);
+		IDEA_enc_encrypt_blocks((IdeaEncContext*)context, words, words, n);
+		STORE_16(out, words, 4 * n);
+	}
+}
+
+static void IDEA_enc_registryDecryptBlocks(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks)
+{
+	size_t n;
+	uint16_t words[4 * CHUNK_BLOCKS];
+
+	for (; nrBlocks > 0; nrBlocks -= n, blocks += 8 * n, out += 8 * n)
+	{
+		n = nrBlocks < CHUNK_BLOCKS ? nrBlocks : CHUNK_BLOCKS;
+		LOAD_16(words, blocks, 4 * n);
+		IDEA_enc_decrypt_blocks((IdeaEncContext*)context, words, words, n);
+		STORE_16(out, words, 4 * n);
+	}
+}
+
+static const CipherDescriptor ciphers[] =
+{
+	{
+		"ARIA", 16, 3, { 128, 192, 256 },
+		sizeof(AriaContext), ALIGNMENT_OF(AriaContext),
+		ARIA_registryInit, ARIA_registryEncrypt, ARIA_registryDecrypt,
+		ARIA_registryEncryptBlocks, ARIA_registryDecryptBlocks
+	},
+	{
+		"CAMELLIA", 16, 3, { 128, 192, 256 },
+		sizeof(CamelliaContext), ALIGNMENT_OF(CamelliaContext),
+		CAMELLIA_registryInit, CAMELLIA_registryEncrypt, CAMELLIA_registryDecrypt,
+		CAMELLIA_registryEncryptBlocks, CAMELLIA_registryDecryptBlocks
+	},
+	{
+		"GOST", 8, 1, { 256 },
+		sizeof(GostContext), ALIGNMENT_OF(GostContext),
+		GOST_registryInit, GOST_registryEncrypt, GOST_registryDecrypt,
+		GOST_registryEncryptBlocks, GOST_registryDecryptBlocks
+	},
+	{
+		"HIGHT", 8, 1, { 128 },
+		sizeof(HightContext), ALIGNMENT_OF(HightContext),
+		HIGHT_registryInit, HIGHT_registryEncrypt, HIGHT_registryDecrypt,
+		HIGHT_registryEncryptBlocks, HIGHT_registryDecryptBlocks
+	},
+	{
+		"IDEA", 8, 1, { 128 },
+		sizeof(IdeaContext), ALIGNMENT_OF(IdeaContext),
+		IDEA_registryInit, IDEA_registryEncrypt, IDEA_registryDecrypt,
+		IDEA_registryEncryptBlocks, IDEA_registryDecryptBlocks
+	},
+	{
+		"NOEKEON", 16, 1, { 128 },
+		sizeof(NoekeonContext), ALIGNMENT_OF(NoekeonContext),
+		NOEKEON_registryInit, NOEKEON_registryEncrypt, NOEKEON_registryDecrypt,
+		NOEKEON_registryEncryptBlocks, NOEKEON_registryDecryptBlocks
+	},
+	{
+		"PRESENT", 8, 2, { 80, 128 },
+		sizeof(PresentContext), ALIGNMENT_OF(PresentContext),
+		PRESENT_registryInit, PRESENT_registryEncrypt, PRESENT_registryDecrypt,
+		PRESENT_registryEncryptBlocks, PRESENT_registryDecryptBlocks
+	},
+	{
+		"SEED", 16, 1, { 128 },
+		sizeof(SeedContext), ALIGNMENT_OF(SeedContext),
+		SEED_registryInit, SEED_registryEncrypt, SEED_registryDecrypt,
+		SEED_registryEncryptBlocks, SEED_registryDecryptBlocks
+	},
+	{
+		"SIMON", 16, 3, { 128, 192, 256 },
+		sizeof(SimonContext), ALIGNMENT_OF(SimonContext),
+		SIMON_registryInit, SIMON_registryEncrypt, SIMON_registryDecrypt,
+		SIMON_registryEncryptBlocks, SIMON_registryDecryptBlocks
+	},
+	{
+		"SPECK", 16, 3, { 128, 192, 256 },
+		sizeof(SpeckContext), ALIGNMENT_OF(SpeckContext),
+		SPECK_registryInit, SPECK_registryEncrypt, SPECK_registryDecrypt,
+		SPECK_registryEncryptBlocks, SPECK_registryDecryptBlocks
+	},
+	{
+		"SIMON-COMPACT", 16, 3, { 128, 192, 256 },
+		sizeof(SimonCompactContext), ALIGNMENT_OF(SimonCompactContext),
+		SIMON_compact_registryInit, SIMON_compact_registryEncrypt, SIMON_compact_registryDecrypt,
+		SIMON_compact_registryEncryptBlocks, SIMON_compact_registryDecryptBlocks
+	},
+	{
+		"SPECK-COMPACT", 16, 3, { 128, 192, 256 },
+		sizeof(SpeckCompactContext), ALIGNMENT_OF(SpeckCompactContext),
+		SPECK_compact_registryInit, SPECK_compact_registryEncrypt, SPECK_compact_registryDecrypt,
+		SPECK_compact_registryEncryptBlocks, SPECK_compact_registryDecryptBlocks
+	},
+	{
+		"ARIA-ENC", 16, 3, { 128, 192, 256 },
+		sizeof(AriaEncContext), ALIGNMENT_OF(AriaEncContext),
+		ARIA_enc_registryInit, ARIA_enc_registryEncrypt, ARIA_enc_registryDecrypt,
+		ARIA_enc_registryEncryptBlocks, ARIA_enc_registryDecryptBlocks
+	},
+	{
+		"IDEA-ENC", 8, 1, { 128 },
+		sizeof(IdeaEncContext), ALIGNMENT_OF(IdeaEncContext),
+		IDEA_enc_registryInit, IDEA_enc_registryEncrypt, IDEA_enc_registryDecrypt,
+		IDEA_enc_registryEncryptBlocks, IDEA_enc_registryDecryptBlocks
+	}
+};
+
+#define NR_CIPHERS (sizeof(ciphers) / sizeof(ciphers[0]))
+
+size_t REGISTRY_count(void)
+{
+	return NR_CIPHERS;
+}
+
+const CipherDescriptor* REGISTRY_get(size_t index)
+{
+	if (index >= NR_CIPHERS)
+	{
+		return NULL;
+	}
+
+	return &ciphers[index];
+}
+
+const CipherDescriptor* REGISTRY_find(const char* name)
+{
+	size_t i;
+
+	for (i = 0; i < NR_CIPHERS; i++)
+	{
+		if (strcmp(ciphers[i].name, name) == 0)
+		{
+			return &ciphers[i];
+		}
+	}
+
+	return NULL;
+}
+
+int REGISTRY_supportsKeyLength(const CipherDescriptor* cipher, uint16_t keyLen)
+{
+	uint8_t i;
+
+	for (i = 0; i < cipher->nrKeyLengths; i++)
+	{
+		if (cipher->keyLengths[i] == keyLen)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/*
+	Expand the key into the context. Returns 0 on success and -1
+	when the key length is not supported by the cipher, in which
+	case the context is left untouched.
+*/
+int REGISTRY_init(const CipherDescriptor* cipher, void* context, const uint8_t* key, uint16_t keyLen)
+{
+	if (!REGISTRY_supportsKeyLength(cipher, keyLen))
+	{
+		return -1;
+	}
+
+	cipher->init(context, key, keyLen);
+
+	return 0;
+}
+
+void REGISTRY_main(void)
+{
+	// large enough for any context, uint64_t keeps it aligned
+	uint64_t context[REGISTRY_MAX_CONTEXT_SIZE / sizeof(uint64_t)];
+	uint8_t key[32];
+	uint8_t text[32];
+	uint8_t cipherText[32];
+	uint8_t decryptedText[32];
+	size_t i;
+	int j;
+
+	for (j = 0; j < 32; j++)
+	{
+		key[j] = (uint8_t)j;
+		text[j] = (uint8_t)(j * 0x11);
+	}
+
+	printf("\nREGISTRY \n\n");
+
+	for (i = 0; i < REGISTRY_count(); i++)
+	{
+		const CipherDescriptor* cipher = REGISTRY_get(i);
+		uint16_t keyLen = cipher->keyLengths[0];
+
+		REGISTRY_init(cipher, context, key, keyLen);
+
+		// two blocks through the bulk interface
+		cipher->encryptBlocks(context, text, cipherText, 2);
+		cipher->decryptBlocks(context, cipherText, decryptedText, 2);
+
+		printf("%-13s block %2u bytes, key %3u bits, context %4u bytes: ",
+			cipher->name, cipher->blockSize, keyLen, (unsigned)cipher->contextSize);
+
+		for (j = 0; j < cipher->blockSize; j++)
+		{
+			printf("%02x", cipherText[j]);
+		}
+
+		printf(memcmp(text, decryptedText, 2 * cipher->blockSize) == 0 ? " ok\n" : " FAILED\n");
+	}
+}
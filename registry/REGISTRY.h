@@ -0,0 +1,59 @@
+/* REGISTRY.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Runtime registry of the block ciphers implemented in
+ * algorithms/. Every cipher is described by a CipherDescriptor
+ * with a uniform byte oriented interface, so callers can select
+ * an algorithm by name once and then drive it only through
+ * function pointers.
+ *
+ * Blocks and keys are byte strings. Ciphers whose native
+ * interface works on 16/32/64 bits words load them in big-endian
+ * order, which is the same order used to write the test vectors
+ * in each *_main function.
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define REGISTRY_MAX_KEY_LENGTHS 3
+
+// upper bound of contextSize, for callers that keep a context on the stack
+#define REGISTRY_MAX_CONTEXT_SIZE 8192
+
+typedef void (*CipherInitFunction)(void* context, const uint8_t* key, uint16_t keyLen);
+typedef void (*CipherBlockFunction)(const void* context, const uint8_t* block, uint8_t* out);
+typedef void (*CipherBlocksFunction)(const void* context, const uint8_t* blocks, uint8_t* out, size_t nrBlocks);
+
+typedef struct
+{
+	const char* name;
+	// block length in bytes
+	uint16_t blockSize;
+	// supported key lengths in bits
+	uint8_t nrKeyLengths;
+	uint16_t keyLengths[REGISTRY_MAX_KEY_LENGTHS];
+	// memory required by the expanded key
+	size_t contextSize;
+	size_t contextAlignment;
+	CipherInitFunction init;
+	CipherBlockFunction encrypt;
+	CipherBlockFunction decrypt;
+	CipherBlocksFunction encryptBlocks;
+	CipherBlocksFunction decryptBlocks;
+} CipherDescriptor;
+
+size_t REGISTRY_count(void);
+const CipherDescriptor* REGISTRY_get(size_t index);
+const CipherDescriptor* REGISTRY_find(const char* name);
+
+int REGISTRY_supportsKeyLength(const CipherDescriptor* cipher, uint16_t keyLen);
+int REGISTRY_init(const CipherDescriptor* cipher, void* context, const uint8_t* key, uint16_t keyLen);
+
+void REGISTRY_main(void);
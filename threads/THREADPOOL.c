@@ -0,0 +1,273 @@
+/* THREADPOOL.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Fork-join thread pool on top of POSIX threads, or of the
+ * native threads when built with Visual Studio.
+ *
+ */
+
+#include <stdlib.h>
+
+#include "THREADPOOL.h"
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+typedef CRITICAL_SECTION Mutex;
+typedef CONDITION_VARIABLE Condition;
+typedef HANDLE Thread;
+
+#define MUTEX_INIT(m) InitializeCriticalSection(m)
+#define MUTEX_DESTROY(m) DeleteCriticalSection(m)
+#define MUTEX_LOCK(m) EnterCriticalSection(m)
+#define MUTEX_UNLOCK(m) LeaveCriticalSection(m)
+#define CONDITION_INIT(c) InitializeConditionVariable(c)
+#define CONDITION_DESTROY(c)
+#define CONDITION_WAIT(c, m) SleepConditionVariableCS(c, m, INFINITE)
+#define CONDITION_SIGNAL(c) WakeConditionVariable(c)
+#define CONDITION_BROADCAST(c) WakeAllConditionVariable(c)
+
+#else
+
+#include <pthread.h>
+#include <unistd.h>
+
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t Condition;
+typedef pthread_t Thread;
+
+#define MUTEX_INIT(m) pthread_mutex_init(m, NULL)
+#define MUTEX_DESTROY(m) pthread_mutex_destroy(m)
+#define MUTEX_LOCK(m) pthread_mutex_lock(m)
+#define MUTEX_UNLOCK(m) pthread_mutex_unlock(m)
+#define CONDITION_INIT(c) pthread_cond_init(c, NULL)
+#define CONDITION_DESTROY(c) pthread_cond_destroy(c)
+#define CONDITION_WAIT(c, m) pthread_cond_wait(c, m)
+#define CONDITION_SIGNAL(c) pthread_cond_signal(c)
+#define CONDITION_BROADCAST(c) pthread_cond_broadcast(c)
+
+#endif
+
+struct ThreadPool
+{
+	// serializes concurrent callers of THREADPOOL_run
+	Mutex runLock;
+
+	Mutex lock;
+	Condition workAvailable;
+	Condition workDone;
+
+	unsigned nrWorkers;
+	Thread* workers;
+
+	// incremented for every job so sleeping workers know there is a new one
+	uint64_t generation;
+	int stop;
+
+	ThreadPoolTask task;
+	void* argument;
+	size_t nrTasks;
+	size_t nextTask;
+	size_t pendingTasks;
+};
+
+/*
+	Run tasks of the current job until none is left, must be called
+	with the pool lock held and returns with it held.
+*/
+static void runTasks(ThreadPool* pool)
+{
+	size_t index;
+
+	while (pool->nextTask < pool->nrTasks)
+	{
+		index = pool->nextTask++;
+
+		MUTEX_UNLOCK(&pool->lock);
+		pool->task(pool->argument, index);
+		MUTEX_LOCK(&pool->lock);
+
+		if (--pool->pendingTasks == 0)
+		{
+			CONDITION_SIGNAL(&pool->workDone);
+		}
+	}
+}
+
+#ifdef _WIN32
+static DWORD WINAPI worker(LPVOID parameter)
+#else
+static void* worker(void* parameter)
+#endif
+{
+	ThreadPool* pool = (ThreadPool*)parameter;
+	uint64_t generation = 0;
+
+	MUTEX_LOCK(&pool->lock);
+
+	for (;;)
+	{
+		while (pool->generation == generation && !pool->stop)
+		{
+			CONDITION_WAIT(&pool->workAvailable, &pool->lock);
+		}
+
+		if (pool->stop)
+		{
+			break;
+		}
+
+		generation = pool->generation;
+		runTasks(pool);
+	}
+
+	MUTEX_UNLOCK(&pool->lock);
+
+	return 0;
+}
+
+unsigned THREADPOOL_cpuCount(void)
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return count > 0 ? (unsigned)count : 1;
+#endif
+}
+
+/*
+	Create a pool where nrThreads threads, including the caller of
+	THREADPOOL_run, share each job. Zero uses one thread per CPU.
+	Returns NULL if the threads cannot be created.
+*/
+ThreadPool* THREADPOOL_create(unsigned nrThreads)
+{
+	ThreadPool* pool;
+	unsigned i;
+
+	if (nrThreads == 0)
+	{
+		nrThreads = THREADPOOL_cpuCount();
+	}
+
+	pool = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+	if (pool == NULL)
+	{
+		return NULL;
+	}
+
+	pool->workers = (Thread*)calloc(nrThreads, sizeof(Thread));
+	if (pool->workers == NULL)
+	{
+		free(pool);
+		return NULL;
+	}
+
+	MUTEX_INIT(&pool->runLock);
+	MUTEX_INIT(&pool->lock);
+	CONDITION_INIT(&pool->workAvailable);
+	CONDITION_INIT(&pool->workDone);
+
+	// the calling thread is the first thread of the pool
+	for (i = 0; i < nrThreads - 1; i++)
+	{
+#ifdef _WIN32
+		pool->workers[i] = CreateThread(NULL, 0, worker, pool, 0, NULL);
+		if (pool->workers[i] == NULL)
+#else
+		if (pthread_create(&pool->workers[i], NULL, worker, pool) != 0)
+#endif
+		{
+			break;
+		}
+
+		pool->nrWorkers++;
+	}
+
+	if (pool->nrWorkers != nrThreads - 1)
+	{
+		THREADPOOL_destroy(pool);
+		return NULL;
+	}
+
+	return pool;
+}
+
+void THREADPOOL_destroy(ThreadPool* pool)
+{
+	unsigned i;
+
+	if (pool == NULL)
+	{
+		return;
+	}
+
+	MUTEX_LOCK(&pool->lock);
+	pool->stop = 1;
+	CONDITION_BROADCAST(&pool->workAvailable);
+	MUTEX_UNLOCK(&pool->lock);
+
+	for (i = 0; i < pool->nrWorkers; i++)
+	{
+#ifdef _WIN32
+		WaitForSingleObject(pool->workers[i], INFINITE);
+		CloseHandle(pool->workers[i]);
+#else
+		pthread_join(pool->workers[i], NULL);
+#endif
+	}
+
+	CONDITION_DESTROY(&pool->workDone);
+	CONDITION_DESTROY(&pool->workAvailable);
+	MUTEX_DESTROY(&pool->lock);
+	MUTEX_DESTROY(&pool->runLock);
+
+	free(pool->workers);
+	free(pool);
+}
+
+unsigned THREADPOOL_size(const ThreadPool* pool)
+{
+	return pool->nrWorkers + 1;
+}
+
+void THREADPOOL_run(ThreadPool* pool, ThreadPoolTask task, void* argument, size_t nrTasks)
+{
+	if (nrTasks == 0)
+	{
+		return;
+	}
+
+	MUTEX_LOCK(&pool->runLock);
+	MUTEX_LOCK(&pool->lock);
+
+	pool->task = task;
+	pool->argument = argument;
+	pool->nrTasks = nrTasks;
+	pool->nextTask = 0;
+	pool->pendingTasks = nrTasks;
+	pool->generation++;
+
+	if (pool->nrWorkers > 0)
+	{
+		CONDITION_BROADCAST(&pool->workAvailable);
+	}
+
+	runTasks(pool);
+
+	while (pool->pendingTasks > 0)
+	{
+		CONDITION_WAIT(&pool->workDone, &pool->lock);
+	}
+
+	MUTEX_UNLOCK(&pool->lock);
+	MUTEX_UNLOCK(&pool->runLock);
+}
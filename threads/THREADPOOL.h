@@ -0,0 +1,32 @@
+/* THREADPOOL.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 16/10/2026
+ *
+ * Minimal fork-join thread pool used by the modes of operation
+ * to spread independent blocks over all cores.
+ *
+ * The workers are created once and sleep between jobs. A job is
+ * a function called once for every task index in [0, nrTasks),
+ * the calling thread takes part in the job and THREADPOOL_run
+ * only returns after every task has finished.
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef void (*ThreadPoolTask)(void* argument, size_t index);
+
+typedef struct ThreadPool ThreadPool;
+
+ThreadPool* THREADPOOL_create(unsigned nrThreads);
+void THREADPOOL_destroy(ThreadPool* pool);
+
+unsigned THREADPOOL_size(const ThreadPool* pool);
+void THREADPOOL_run(ThreadPool* pool, ThreadPoolTask task, void* argument, size_t nrTasks);
+
+unsigned THREADPOOL_cpuCount(void);